@@ -281,11 +281,14 @@ void CollectionSystemsManager::updateSystemsList()
     if (mApplicationStartup)
         return;
 
-    // Create views for collections, before reload.
-    for (auto sysIt = SystemData::sSystemVector.cbegin(); // Line break.
-         sysIt != SystemData::sSystemVector.cend(); ++sysIt) {
-        if ((*sysIt)->isCollection())
-            ViewController::getInstance()->getGamelistView((*sysIt));
+    // Create views for collections, before reload. If the GamelistViewCacheSize setting is
+    // non-zero then the views are instead created on demand.
+    if (Settings::getInstance()->getInt("GamelistViewCacheSize") == 0) {
+        for (auto sysIt = SystemData::sSystemVector.cbegin(); // Line break.
+             sysIt != SystemData::sSystemVector.cend(); ++sysIt) {
+            if ((*sysIt)->isCollection())
+                ViewController::getInstance()->getGamelistView((*sysIt));
+        }
     }
 
     // If we were editing a custom collection, and it's no longer enabled, exit edit mode.
@@ -300,6 +303,10 @@ void CollectionSystemsManager::refreshCollectionSystems(FileData* file,
     if (!file->getSystem()->isGameSystem() || file->getType() != GAME)
         return;
 
+    // This is called whenever the metadata or media files for a game have been changed, so
+    // it's also used for keeping the screensaver media inventory up to date.
+    mWindow->screensaverOnFileChanged(file->getSourceFileData());
+
     // If not a collection but rather a real system, then pretend to be a
     // collection in order to be properly processed by updateCollectionSystem().
     // It's seemingly a bit strange, but without rewriting a lot of code for how
@@ -365,23 +372,19 @@ void CollectionSystemsManager::updateCollectionSystem(FileData* file, Collection
             // Found it, and we are removing it.
             if (name == "favorites" && file->metadata.get("favorite") == "false") {
                 // Need to check if it is still marked as favorite, if not remove it.
-                ViewController::getInstance()->getGamelistView(curSys).get()->remove(
-                    collectionEntry, false);
+                removeCollectionEntry(curSys, collectionEntry);
             }
             else if (name == "recent" && file->metadata.get("lastplayed") == "0") {
                 // If lastplayed is set to 0 it means the entry has been cleared, and the
                 // game should therefore be removed.
-                ViewController::getInstance()->getGamelistView(curSys).get()->remove(
-                    collectionEntry, false);
+                removeCollectionEntry(curSys, collectionEntry);
                 ViewController::getInstance()->onFileChanged(rootFolder, true);
             }
             else if (curSys->isCollection() && !file->getCountAsGame()) {
                 // If the countasgame flag has been set to false, then remove the game.
                 if (curSys->isGroupedCustomCollection()) {
-                    ViewController::getInstance()
-                        ->getGamelistView(curSys->getRootFolder()->getParent()->getSystem())
-                        .get()
-                        ->remove(collectionEntry, false);
+                    removeCollectionEntry(curSys->getRootFolder()->getParent()->getSystem(),
+                                          collectionEntry);
                     FileData* parentRootFolder {
                         rootFolder->getParent()->getSystem()->getRootFolder()};
                     parentRootFolder->sort(parentRootFolder->getSortTypeFromString(
@@ -395,8 +398,7 @@ void CollectionSystemsManager::updateCollectionSystem(FileData* file, Collection
                         4000);
                 }
                 else {
-                    ViewController::getInstance()->getGamelistView(curSys).get()->remove(
-                        collectionEntry, false);
+                    removeCollectionEntry(curSys, collectionEntry);
                 }
                 rootFolder->sort(rootFolder->getSortTypeFromString(rootFolder->getSortTypeString()),
                                  favoritesSorting);
@@ -423,8 +425,8 @@ void CollectionSystemsManager::updateCollectionSystem(FileData* file, Collection
                 CollectionFileData* newGame {new CollectionFileData(file, curSys)};
                 rootFolder->addChild(newGame);
                 fileIndex->addToIndex(newGame);
-                ViewController::getInstance()->getGamelistView(curSys)->onFileChanged(newGame,
-                                                                                      true);
+                if (auto view = ViewController::getInstance()->getGamelistViewIfExists(curSys))
+                    view->onFileChanged(newGame, true);
             }
         }
 
@@ -470,10 +472,12 @@ void CollectionSystemsManager::updateCollectionSystem(FileData* file, Collection
             auto nTime = Utils::Time::now();
             if (nTime - Utils::Time::stringToTime(file->metadata.get("lastplayed")) < 2) {
                 // Select the first row of the gamelist (the game just played).
-                GamelistView* gameList {ViewController::getInstance()
-                                            ->getGamelistView(getSystemToView(sysData.system))
-                                            .get()};
-                gameList->setCursor(gameList->getFirstEntry());
+                GamelistView* gameList {
+                    ViewController::getInstance()
+                        ->getGamelistViewIfExists(getSystemToView(sysData.system))
+                        .get()};
+                if (gameList != nullptr)
+                    gameList->setCursor(gameList->getFirstEntry());
             }
         }
         else {
@@ -512,11 +516,8 @@ void CollectionSystemsManager::deleteCollectionFiles(FileData* file)
             bool found = children.find(key) != children.cend();
             if (found) {
                 FileData* collectionEntry {children.at(key)};
-                SystemData* systemViewToUpdate {getSystemToView(sysDataIt->second.system)};
-                ViewController::getInstance()
-                    ->getGamelistView(systemViewToUpdate)
-                    .get()
-                    ->remove(collectionEntry, false);
+                removeCollectionEntry(getSystemToView(sysDataIt->second.system),
+                                      collectionEntry);
                 if (sysDataIt->second.decl.isCustom)
                     saveCustomCollection(sysDataIt->second.system);
             }
@@ -678,8 +679,8 @@ void CollectionSystemsManager::exitEditMode(bool showPopup)
 
     // Remove all tick marks from the games that are part of the collection.
     for (auto it = SystemData::sSystemVector.begin(); it != SystemData::sSystemVector.end(); ++it) {
-        ViewController::getInstance()->getGamelistView((*it))->onFileChanged(
-            ViewController::getInstance()->getGamelistView((*it))->getCursor(), false);
+        if (auto view = ViewController::getInstance()->getGamelistViewIfExists((*it)))
+            view->onFileChanged(view->getCursor(), false);
     }
 
     mEditingCollectionSystemData->system->onMetaDataSavePoint();
@@ -724,10 +725,7 @@ const bool CollectionSystemsManager::toggleGameInCollection(FileData* file)
                 // If we found it, we need to remove it.
                 FileData* collectionEntry {children.at(key)};
                 fileIndex->removeFromIndex(collectionEntry);
-                ViewController::getInstance()
-                    ->getGamelistView(systemViewToUpdate)
-                    .get()
-                    ->remove(collectionEntry, false);
+                removeCollectionEntry(systemViewToUpdate, collectionEntry);
                 systemViewToUpdate->getRootFolder()->sort(
                     rootFolder->getSortTypeFromString(rootFolder->getSortTypeString()),
                     Settings::getInstance()->getBool("FavFirstCustom"));
@@ -1115,12 +1113,13 @@ void CollectionSystemsManager::repopulateCollection(SystemData* sysData)
             // and then point to this, and for collections with games in them we select the first
             // entry.
             auto autoView =
-                ViewController::getInstance()->getGamelistView(autoSystem->system).get();
-            if (autoSystem->system->getRootFolder()->getChildren().size() == 0) {
+                ViewController::getInstance()->getGamelistViewIfExists(autoSystem->system).get();
+            if (autoView != nullptr &&
+                autoSystem->system->getRootFolder()->getChildren().size() == 0) {
                 autoView->addPlaceholder(autoSystem->system->getRootFolder());
                 autoView->setCursor(autoView->getLastEntry());
             }
-            else {
+            else if (autoView != nullptr) {
                 autoView->setCursor(
                     autoSystem->system->getRootFolder()->getChildrenRecursive().front());
                 autoView->setCursor(autoView->getFirstEntry());
@@ -1152,10 +1151,12 @@ void CollectionSystemsManager::repopulateCollection(SystemData* sysData)
             populateCustomCollection(customSystem);
 
             auto autoView =
-                ViewController::getInstance()->getGamelistView(customSystem->system).get();
-            autoView->setCursor(
-                customSystem->system->getRootFolder()->getChildrenRecursive().front());
-            autoView->setCursor(autoView->getFirstEntry());
+                ViewController::getInstance()->getGamelistViewIfExists(customSystem->system).get();
+            if (autoView != nullptr) {
+                autoView->setCursor(
+                    customSystem->system->getRootFolder()->getChildrenRecursive().front());
+                autoView->setCursor(autoView->getFirstEntry());
+            }
         }
     }
 }
@@ -1273,15 +1274,14 @@ void CollectionSystemsManager::populateAutoCollection(CollectionSystemData* sysD
         // The following is needed to avoid a crash when repopulating the system as the previous
         // cursor pointer may point to a random memory address.
         auto recentGamelist =
-            ViewController::getInstance()->getGamelistView(rootFolder->getSystem()).get();
-        recentGamelist->setCursor(
-            rootFolder->getSystem()->getRootFolder()->getChildrenRecursive().front());
-        recentGamelist->setCursor(recentGamelist->getFirstEntry());
-        if (rootFolder->getChildren().size() > 0)
-            ViewController::getInstance()
-                ->getGamelistView(rootFolder->getSystem())
-                .get()
-                ->onFileChanged(rootFolder->getChildren().front(), false);
+            ViewController::getInstance()->getGamelistViewIfExists(rootFolder->getSystem()).get();
+        if (recentGamelist != nullptr) {
+            recentGamelist->setCursor(
+                rootFolder->getSystem()->getRootFolder()->getChildrenRecursive().front());
+            recentGamelist->setCursor(recentGamelist->getFirstEntry());
+            if (rootFolder->getChildren().size() > 0)
+                recentGamelist->onFileChanged(rootFolder->getChildren().front(), false);
+        }
     }
 
     sysData->isPopulated = true;
@@ -1440,9 +1440,9 @@ void CollectionSystemsManager::addEnabledCollectionsToDisplayedSystems(
                     // Jump to the first row of the game list, assuming it's not empty.
                     if (!mApplicationStartup) {
                         GamelistView* gameList {ViewController::getInstance()
-                                                    ->getGamelistView((it->second.system))
+                                                    ->getGamelistViewIfExists((it->second.system))
                                                     .get()};
-                        if (!gameList->getCursor()->isPlaceHolder()) {
+                        if (gameList != nullptr && !gameList->getCursor()->isPlaceHolder()) {
                             gameList->setCursor(gameList->getFirstEntry());
                         }
                     }
@@ -1626,7 +1626,7 @@ void CollectionSystemsManager::trimCollectionCount(FileData* rootFolder, int lim
     while (static_cast<int>(rootFolder->getChildrenListToDisplay().size()) > limit) {
         CollectionFileData* gameToRemove {
             reinterpret_cast<CollectionFileData*>(rootFolder->getChildrenListToDisplay().back())};
-        ViewController::getInstance()->getGamelistView(curSys).get()->remove(gameToRemove, false);
+        removeCollectionEntry(curSys, gameToRemove);
     }
     // Also update the lists of last played and most played games as these could otherwise
     // contain dangling pointers.
@@ -1634,6 +1634,18 @@ void CollectionSystemsManager::trimCollectionCount(FileData* rootFolder, int lim
     rootFolder->updateMostPlayedList();
 }
 
+void CollectionSystemsManager::removeCollectionEntry(SystemData* system,
+                                                     FileData* collectionEntry)
+{
+    if (auto view = ViewController::getInstance()->getGamelistViewIfExists(system)) {
+        view->remove(collectionEntry, false);
+    }
+    else {
+        FileFilterIndex::removeFromSystemIndexes(collectionEntry);
+        delete collectionEntry;
+    }
+}
+
 const bool CollectionSystemsManager::themeFolderExists(const std::string& folder)
 {
     std::vector<std::string> themeSys {getSystemsFromTheme()};
@@ -193,6 +193,9 @@ private:
     // Return whether a specific folder exists in the theme.
     const bool themeFolderExists(const std::string& folder);
     const bool includeFileInAutoCollections(FileData* file);
+    // Remove a collection entry via its gamelist view, or delete it directly if the view
+    // doesn't exist.
+    void removeCollectionEntry(SystemData* system, FileData* collectionEntry);
 
     std::string getCustomCollectionConfigPath(const std::string& collectionName);
     std::string getCollectionsFolder();
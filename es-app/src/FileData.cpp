@@ -16,6 +16,7 @@
 #include "FileSorts.h"
 #include "Log.h"
 #include "MameNames.h"
+#include "MediaDirectoryIndex.h"
 #include "Scripting.h"
 #include "SystemData.h"
 #include "UIModeController.h"
@@ -30,6 +31,7 @@
 #include "utils/PlatformUtilAndroid.h"
 #endif
 
+#include <algorithm>
 #include <assert.h>
 #include <regex>
 
@@ -50,6 +52,12 @@ FileData::FileData(FileType type,
     , mUpdateChildrenMostPlayed {false}
     , mDeletionFlag {false}
 {
+    mSortKeys.players = 0;
+    mSortKeys.revision = 0;
+
+    if (mType == GAME && !system->isCollection())
+        ++sGameGeneration;
+
     // Metadata needs at least a name field (since that's what getName() will return).
     if ((system->hasPlatformId(PlatformIds::ARCADE) ||
          system->hasPlatformId(PlatformIds::SNK_NEO_GEO)) &&
@@ -70,6 +78,9 @@ FileData::FileData(FileType type,
 
 FileData::~FileData()
 {
+    if (mType == GAME && mSourceFileData == nullptr)
+        ++sGameGeneration;
+
     while (mChildren.size() > 0)
         delete (mChildren.front());
 
@@ -80,59 +91,61 @@ FileData::~FileData()
 const std::string& FileData::getSortName()
 {
     if (mSystem->isCustomCollection() && mType == GAME) {
-        if (!metadata.get("collectionsortname").empty())
-            return metadata.get("collectionsortname");
-        else if (!metadata.get("sortname").empty())
-            return metadata.get("sortname");
+        if (!metadata.get(MD_KEY_COLLECTIONSORTNAME).empty())
+            return metadata.get(MD_KEY_COLLECTIONSORTNAME);
+        else if (!metadata.get(MD_KEY_SORTNAME).empty())
+            return metadata.get(MD_KEY_SORTNAME);
         else
-            return metadata.get("name");
+            return metadata.get(MD_KEY_NAME);
     }
 
-    if (metadata.get("sortname").empty())
-        return metadata.get("name");
+    if (metadata.get(MD_KEY_SORTNAME).empty())
+        return metadata.get(MD_KEY_NAME);
     else
-        return metadata.get("sortname");
+        return metadata.get(MD_KEY_SORTNAME);
 }
 
-const bool FileData::getFavorite()
+const FileData::SortKeys& FileData::getSortKeys() const
 {
-    if (metadata.get("favorite") == "true")
-        return true;
+    if (mSortKeys.revision == metadata.getRevision())
+        return mSortKeys;
+
+    // Custom collections use the collectionsortname value if it has been set.
+    if (mSystem->isCustomCollection() && !metadata.get(MD_KEY_COLLECTIONSORTNAME).empty())
+        mSortKeys.name = Utils::String::toUpper(metadata.get(MD_KEY_COLLECTIONSORTNAME));
+    else if (!metadata.get(MD_KEY_SORTNAME).empty())
+        mSortKeys.name = Utils::String::toUpper(metadata.get(MD_KEY_SORTNAME));
     else
-        return false;
+        mSortKeys.name = Utils::String::toUpper(metadata.get(MD_KEY_NAME));
+
+    mSortKeys.developer = Utils::String::toUpper(metadata.get(MD_KEY_DEVELOPER));
+    mSortKeys.publisher = Utils::String::toUpper(metadata.get(MD_KEY_PUBLISHER));
+    mSortKeys.genre = Utils::String::toUpper(metadata.get(MD_KEY_GENRE));
+    mSortKeys.system = Utils::String::toUpper(mSystemName);
+
+    // If there is a range of players such as '1-4' then use the number after the dash.
+    // Any non-numeric value will end up as zero.
+    std::string players {metadata.get(MD_KEY_PLAYERS)};
+    const size_t dashPos {players.find("-")};
+    if (dashPos != std::string::npos)
+        players = players.substr(dashPos + 1, players.size() - dashPos - 1);
+    mSortKeys.players = 0;
+    if (!players.empty() && std::all_of(players.begin(), players.end(), ::isdigit))
+        mSortKeys.players = static_cast<unsigned int>(std::stoul(players));
+
+    mSortKeys.revision = metadata.getRevision();
+    return mSortKeys;
 }
 
-const bool FileData::getKidgame()
-{
-    if (metadata.get("kidgame") == "true")
-        return true;
-    else
-        return false;
-}
+const bool FileData::getFavorite() { return metadata.getBool(MD_KEY_FAVORITE); }
 
-const bool FileData::getHidden()
-{
-    if (metadata.get("hidden") == "true")
-        return true;
-    else
-        return false;
-}
+const bool FileData::getKidgame() { return metadata.getBool(MD_KEY_KIDGAME); }
 
-const bool FileData::getCountAsGame()
-{
-    if (metadata.get("nogamecount") == "true")
-        return false;
-    else
-        return true;
-}
+const bool FileData::getHidden() { return metadata.getBool(MD_KEY_HIDDEN); }
 
-const bool FileData::getExcludeFromScraper()
-{
-    if (metadata.get("nomultiscrape") == "true")
-        return true;
-    else
-        return false;
-}
+const bool FileData::getCountAsGame() { return !metadata.getBool(MD_KEY_NOGAMECOUNT); }
+
+const bool FileData::getExcludeFromScraper() { return metadata.getBool(MD_KEY_NOMULTISCRAPE); }
 
 const std::vector<FileData*> FileData::getChildrenRecursive() const
 {
@@ -224,7 +237,7 @@ const std::string FileData::getMediafilePath(const std::string& subdirectory) co
     // Look for an image file in the media directory.
     for (auto& extension : sImageExtensions) {
         const std::string mediaPath {tempPath + extension};
-        if (Utils::FileSystem::exists(mediaPath))
+        if (MediaDirectoryIndex::getInstance().exists(mediaPath))
             return mediaPath;
     }
 
@@ -328,7 +341,7 @@ const std::string FileData::getVideoPath() const
     // Look for media in the media directory.
     for (auto& extension : sVideoExtensions) {
         const std::string mediaPath {tempPath + extension};
-        if (Utils::FileSystem::exists(mediaPath))
+        if (MediaDirectoryIndex::getInstance().exists(mediaPath))
             return mediaPath;
     }
 
@@ -351,7 +364,7 @@ const std::string FileData::getManualPath() const
     // Look for manuals in the media directory.
     for (size_t i {0}; i < extList.size(); ++i) {
         std::string mediaPath {tempPath + extList[i]};
-        if (Utils::FileSystem::exists(mediaPath))
+        if (MediaDirectoryIndex::getInstance().exists(mediaPath))
             return mediaPath;
     }
 
@@ -545,20 +558,8 @@ void FileData::sort(ComparisonFunction& comparator,
             }
         }
 
-        // If the requested sorting is not by name, then sort in ascending name order as a first
-        // step, in order to get a correct secondary sorting.
-        if (getSortTypeFromString("name, ascending").comparisonFunction != comparator &&
-            getSortTypeFromString("name, descending").comparisonFunction != comparator) {
-            std::stable_sort(mChildrenFolders.begin(), mChildrenFolders.end(),
-                             getSortTypeFromString("name, ascending").comparisonFunction);
-            std::stable_sort(mChildrenOthers.begin(), mChildrenOthers.end(),
-                             getSortTypeFromString("name, ascending").comparisonFunction);
-        }
-
-        if (foldersOnTop)
-            std::stable_sort(mChildrenFolders.begin(), mChildrenFolders.end(), comparator);
-
-        std::stable_sort(mChildrenOthers.begin(), mChildrenOthers.end(), comparator);
+        sortChildren(mChildrenFolders, comparator);
+        sortChildren(mChildrenOthers, comparator);
 
         mChildren.erase(mChildren.begin(), mChildren.end());
         mChildren.reserve(mChildrenFolders.size() + mChildrenOthers.size());
@@ -566,14 +567,7 @@ void FileData::sort(ComparisonFunction& comparator,
         mChildren.insert(mChildren.end(), mChildrenOthers.begin(), mChildrenOthers.end());
     }
     else {
-        // If the requested sorting is not by name, then sort in ascending name order as a first
-        // step, in order to get a correct secondary sorting.
-        if (getSortTypeFromString("name, ascending").comparisonFunction != comparator &&
-            getSortTypeFromString("name, descending").comparisonFunction != comparator)
-            std::stable_sort(mChildren.begin(), mChildren.end(),
-                             getSortTypeFromString("name, ascending").comparisonFunction);
-
-        std::stable_sort(mChildren.begin(), mChildren.end(), comparator);
+        sortChildren(mChildren, comparator);
     }
 
     for (auto it = mChildren.cbegin(); it != mChildren.cend(); ++it) {
@@ -683,32 +677,13 @@ void FileData::sortFavoritesOnTop(ComparisonFunction& comparator,
                                 mChildrenFavoritesFolders.end());
         mChildrenFavoritesFolders.erase(mChildrenFavoritesFolders.begin(),
                                         mChildrenFavoritesFolders.end());
-        std::stable_sort(mChildrenFolders.begin(), mChildrenFolders.end(),
-                         getSortTypeFromString("name, ascending").comparisonFunction);
-    }
-
-    // If the requested sorting is not by name, then sort in ascending name order as a first
-    // step, in order to get a correct secondary sorting.
-    if (getSortTypeFromString("name, ascending").comparisonFunction != comparator &&
-        getSortTypeFromString("name, descending").comparisonFunction != comparator) {
-        std::stable_sort(mChildrenFolders.begin(), mChildrenFolders.end(),
-                         getSortTypeFromString("name, ascending").comparisonFunction);
-        std::stable_sort(mChildrenFavoritesFolders.begin(), mChildrenFavoritesFolders.end(),
-                         getSortTypeFromString("name, ascending").comparisonFunction);
-        std::stable_sort(mChildrenFavorites.begin(), mChildrenFavorites.end(),
-                         getSortTypeFromString("name, ascending").comparisonFunction);
-        std::stable_sort(mChildrenOthers.begin(), mChildrenOthers.end(),
-                         getSortTypeFromString("name, ascending").comparisonFunction);
     }
 
     // Sort favorite games and the other games separately.
-    if (foldersOnTop) {
-        std::stable_sort(mChildrenFavoritesFolders.begin(), mChildrenFavoritesFolders.end(),
-                         comparator);
-        std::stable_sort(mChildrenFolders.begin(), mChildrenFolders.end(), comparator);
-    }
-    std::stable_sort(mChildrenFavorites.begin(), mChildrenFavorites.end(), comparator);
-    std::stable_sort(mChildrenOthers.begin(), mChildrenOthers.end(), comparator);
+    sortChildren(mChildrenFavoritesFolders, comparator);
+    sortChildren(mChildrenFolders, comparator);
+    sortChildren(mChildrenFavorites, comparator);
+    sortChildren(mChildrenOthers, comparator);
 
     // Iterate through any child favorite folders.
     for (auto it = mChildrenFavoritesFolders.cbegin(); // Line break.
@@ -744,6 +719,26 @@ void FileData::sortFavoritesOnTop(ComparisonFunction& comparator,
     mChildren.insert(mChildren.end(), mChildrenOthers.begin(), mChildrenOthers.end());
 }
 
+void FileData::sortChildren(std::vector<FileData*>& children, ComparisonFunction& comparator)
+{
+    if (&comparator == &FileSorts::compareName ||
+        &comparator == &FileSorts::compareNameDescending) {
+        std::stable_sort(children.begin(), children.end(), comparator);
+        return;
+    }
+
+    // Sorting by the requested key with the name as a tiebreaker is done in a single pass,
+    // which gives the same result as first sorting by name and then by the requested key.
+    std::stable_sort(children.begin(), children.end(),
+                     [&comparator](const FileData* a, const FileData* b) {
+                         if (comparator(a, b))
+                             return true;
+                         if (comparator(b, a))
+                             return false;
+                         return FileSorts::compareName(a, b);
+                     });
+}
+
 void FileData::sort(const SortType& type, bool mFavoritesOnTop)
 {
     mGameCount = std::make_pair(0, 0);
@@ -791,7 +786,7 @@ void FileData::updateLastPlayedList()
     std::stable_sort(mChildrenLastPlayed.begin(), mChildrenLastPlayed.end());
     std::sort(std::begin(mChildrenLastPlayed), std::end(mChildrenLastPlayed),
               [](FileData* a, FileData* b) {
-                  return a->metadata.get("lastplayed") > b->metadata.get("lastplayed");
+                  return a->metadata.get(MD_KEY_LASTPLAYED) > b->metadata.get(MD_KEY_LASTPLAYED);
               });
 }
 
@@ -809,7 +804,8 @@ void FileData::updateMostPlayedList()
     std::stable_sort(mChildrenMostPlayed.begin(), mChildrenMostPlayed.end());
     std::sort(std::begin(mChildrenMostPlayed), std::end(mChildrenMostPlayed),
               [](FileData* a, FileData* b) {
-                  return a->metadata.getInt("playcount") > b->metadata.getInt("playcount");
+                  return a->metadata.getInt(MD_KEY_PLAYCOUNT) >
+                         b->metadata.getInt(MD_KEY_PLAYCOUNT);
               });
 }
 
@@ -2089,10 +2085,12 @@ returnValue = Utils::Platform::launchGameUnix(command, startDirectory, runInBack
 
     // If the cursor is on a folder then a folder link must have been configured, so set the
     // lastplayed timestamp for this folder to the same as the launched game.
-    FileData* cursor {
-        ViewController::getInstance()->getGamelistView(gameToUpdate->getSystem())->getCursor()};
-    if (cursor->getType() == FOLDER)
-        cursor->metadata.set("lastplayed", gameToUpdate->metadata.get("lastplayed"));
+    if (auto view = ViewController::getInstance()->getGamelistViewIfExists(
+            gameToUpdate->getSystem())) {
+        FileData* cursor {view->getCursor()};
+        if (cursor->getType() == FOLDER)
+            cursor->metadata.set("lastplayed", gameToUpdate->metadata.get("lastplayed"));
+    }
 
     // If the parent is a folder and it's not the root of the system, then update its lastplayed
     // timestamp to the same time as the game that was just launched.
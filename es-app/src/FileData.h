@@ -17,6 +17,7 @@
 #include "utils/FileSystemUtil.h"
 #include "utils/StringUtil.h"
 
+#include <atomic>
 #include <functional>
 #include <unordered_map>
 
@@ -37,8 +38,21 @@ public:
 
     virtual ~FileData();
 
-    const std::string& getName() { return metadata.get("name"); }
+    // Normalized values used by the sorting functions in FileSorts.
+    struct SortKeys {
+        std::string name;
+        std::string developer;
+        std::string publisher;
+        std::string genre;
+        std::string system;
+        unsigned int players;
+        unsigned long long revision;
+    };
+
+    const std::string& getName() { return metadata.get(MD_KEY_NAME); }
     const std::string& getSortName();
+    // The sort keys are calculated when first requested after the metadata has changed.
+    const SortKeys& getSortKeys() const;
     // Returns our best guess at the "real" name for this file.
     std::string getDisplayName() const { return Utils::FileSystem::getStem(mPath); }
     std::string getCleanName() const
@@ -119,6 +133,10 @@ public:
     virtual FileData* getSourceFileData() { return this; }
     const std::string& getSystemName() const { return mSystemName; }
 
+    // Changes whenever a game entry is created or deleted, used by the screensaver to detect
+    // when its media inventory needs to be rebuilt. Collection entries are not included.
+    static unsigned int getGameGeneration() { return sGameGeneration; }
+
     enum class findEmulatorResult {
         FOUND_FILE,
         FOUND_ANDROID_PACKAGE,
@@ -161,6 +179,9 @@ protected:
     std::string mSortTypeString = "";
 
 private:
+    // Stable sort using the comparator, with the ascending name order as secondary sorting.
+    static void sortChildren(std::vector<FileData*>& children, ComparisonFunction& comparator);
+
     FileType mType;
     std::string mPath;
     SystemEnvironmentData* mEnvData;
@@ -171,7 +192,10 @@ private:
     std::vector<FileData*> mChildrenLastPlayed;
     std::vector<FileData*> mChildrenMostPlayed;
     std::function<void()> mUpdateListCallback;
+    mutable SortKeys mSortKeys;
     static inline std::vector<std::string> sImageExtensions {".png", ".jpg"};
+    // Atomic as the systems may be populated using multiple threads.
+    static inline std::atomic<unsigned int> sGameGeneration {0};
     static inline std::vector<std::string> sVideoExtensions {".mp4", ".mkv", ".avi",
                                                              ".mp4", ".wmv", ".mov"};
     // The pair includes all games, and favorite games.
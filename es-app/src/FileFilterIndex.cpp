@@ -11,6 +11,7 @@
 #include "FileData.h"
 #include "Log.h"
 #include "Settings.h"
+#include "SystemData.h"
 #include "UIModeController.h"
 #include "utils/StringUtil.h"
 #include "views/ViewController.h"
@@ -20,8 +21,47 @@
 #define UNKNOWN_LABEL "UNKNOWN"
 #define INCLUDE_UNKNOWN false;
 
+namespace
+{
+    void setBit(std::vector<uint64_t>& bitset, size_t ordinal)
+    {
+        if (bitset.size() <= ordinal / 64)
+            bitset.resize(ordinal / 64 + 1, 0);
+        bitset[ordinal / 64] |= (1ULL << (ordinal % 64));
+    }
+
+    void clearBit(std::vector<uint64_t>& bitset, size_t ordinal)
+    {
+        if (ordinal / 64 < bitset.size())
+            bitset[ordinal / 64] &= ~(1ULL << (ordinal % 64));
+    }
+
+    bool testBit(const std::vector<uint64_t>& bitset, size_t ordinal)
+    {
+        if (ordinal / 64 >= bitset.size())
+            return false;
+        return (bitset[ordinal / 64] & (1ULL << (ordinal % 64))) != 0;
+    }
+
+    void orBits(std::vector<uint64_t>& target, const std::vector<uint64_t>& source)
+    {
+        if (target.size() < source.size())
+            target.resize(source.size(), 0);
+        for (size_t i {0}; i < source.size(); ++i)
+            target[i] |= source[i];
+    }
+
+    void andBits(std::vector<uint64_t>& target, const std::vector<uint64_t>& source)
+    {
+        for (size_t i {0}; i < target.size(); ++i)
+            target[i] &= (i < source.size() ? source[i] : 0);
+    }
+} // namespace
+
 FileFilterIndex::FileFilterIndex()
     : mFilterByText {false}
+    , mFilterResultValid {false}
+    , mFilterResultKidMode {false}
     , mFilterByRatings {false}
     , mFilterByDeveloper {false}
     , mFilterByPublisher {false}
@@ -106,6 +146,9 @@ void FileFilterIndex::importIndex(FileFilterIndex* indexToImport)
             }
         }
     }
+
+    for (auto& game : indexToImport->mGameOrdinals)
+        addToBitsets(game.first);
 }
 
 void FileFilterIndex::resetIndex()
@@ -123,6 +166,13 @@ void FileFilterIndex::resetIndex()
     clearIndex(mBrokenIndexAllKeys);
     clearIndex(mControllerIndexAllKeys);
     clearIndex(mAltemulatorIndexAllKeys);
+
+    mGameOrdinals.clear();
+    mFreeOrdinals.clear();
+    mGameNames.clear();
+    mKeyBitsets.clear();
+    mFilterResult.clear();
+    mFilterResultValid = false;
 }
 
 std::string FileFilterIndex::getIndexableKey(FileData* game,
@@ -134,7 +184,7 @@ std::string FileFilterIndex::getIndexableKey(FileData* game,
         case RATINGS_FILTER: {
             int ratingNumber = 0;
             if (!getSecondary) {
-                std::string ratingString = game->metadata.get("rating");
+                std::string ratingString = game->metadata.get(MD_KEY_RATING);
                 if (!ratingString.empty()) {
                     try {
                         // Round up fractional values such as 0.75 to 0.8.
@@ -162,15 +212,15 @@ std::string FileFilterIndex::getIndexableKey(FileData* game,
             break;
         }
         case DEVELOPER_FILTER: {
-            key = Utils::String::toUpper(game->metadata.get("developer"));
+            key = Utils::String::toUpper(game->metadata.get(MD_KEY_DEVELOPER));
             break;
         }
         case PUBLISHER_FILTER: {
-            key = Utils::String::toUpper(game->metadata.get("publisher"));
+            key = Utils::String::toUpper(game->metadata.get(MD_KEY_PUBLISHER));
             break;
         }
         case GENRE_FILTER: {
-            key = Utils::String::toUpper(game->metadata.get("genre"));
+            key = Utils::String::toUpper(game->metadata.get(MD_KEY_GENRE));
             if (getSecondary && !key.empty()) {
                 std::istringstream f(key);
                 std::string newKey;
@@ -185,49 +235,49 @@ std::string FileFilterIndex::getIndexableKey(FileData* game,
         case PLAYER_FILTER: {
             if (getSecondary)
                 break;
-            key = Utils::String::toUpper(game->metadata.get("players"));
+            key = Utils::String::toUpper(game->metadata.get(MD_KEY_PLAYERS));
             break;
         }
         case FAVORITES_FILTER: {
             if (game->getType() != GAME)
                 return "FALSE";
-            key = Utils::String::toUpper(game->metadata.get("favorite"));
+            key = Utils::String::toUpper(game->metadata.get(MD_KEY_FAVORITE));
             break;
         }
         case COMPLETED_FILTER: {
             if (game->getType() != GAME)
                 return "FALSE";
-            key = Utils::String::toUpper(game->metadata.get("completed"));
+            key = Utils::String::toUpper(game->metadata.get(MD_KEY_COMPLETED));
             break;
         }
         case KIDGAME_FILTER: {
             if (game->getType() != GAME)
                 return "FALSE";
-            key = Utils::String::toUpper(game->metadata.get("kidgame"));
+            key = Utils::String::toUpper(game->metadata.get(MD_KEY_KIDGAME));
             break;
         }
         case HIDDEN_FILTER: {
             if (game->getType() != GAME)
                 return "FALSE";
-            key = Utils::String::toUpper(game->metadata.get("hidden"));
+            key = Utils::String::toUpper(game->metadata.get(MD_KEY_HIDDEN));
             break;
         }
         case BROKEN_FILTER: {
             if (game->getType() != GAME)
                 return "FALSE";
-            key = Utils::String::toUpper(game->metadata.get("broken"));
+            key = Utils::String::toUpper(game->metadata.get(MD_KEY_BROKEN));
             break;
         }
         case CONTROLLER_FILTER: {
             if (getSecondary)
                 break;
-            key = Utils::String::toUpper(game->metadata.get("controller"));
+            key = Utils::String::toUpper(game->metadata.get(MD_KEY_CONTROLLER));
             break;
         }
         case ALTEMULATOR_FILTER: {
             if (getSecondary)
                 break;
-            key = Utils::String::toUpper(game->metadata.get("altemulator"));
+            key = Utils::String::toUpper(game->metadata.get(MD_KEY_ALTEMULATOR));
             break;
         }
         default:
@@ -262,10 +312,16 @@ void FileFilterIndex::addToIndex(FileData* game)
     manageBrokenEntryInIndex(game);
     manageControllerEntryInIndex(game);
     manageAltemulatorEntryInIndex(game);
+    addToBitsets(game);
 }
 
 void FileFilterIndex::removeFromIndex(FileData* game)
 {
+    // All games in the index have an ordinal, so this also avoids decreasing the key counts
+    // for a game that has already been removed.
+    if (mGameOrdinals.find(game) == mGameOrdinals.cend())
+        return;
+
     manageRatingsEntryInIndex(game, true);
     manageDeveloperEntryInIndex(game, true);
     managePublisherEntryInIndex(game, true);
@@ -278,10 +334,29 @@ void FileFilterIndex::removeFromIndex(FileData* game)
     manageBrokenEntryInIndex(game, true);
     manageControllerEntryInIndex(game, true);
     manageAltemulatorEntryInIndex(game, true);
+    removeFromBitsets(game);
+}
+
+void FileFilterIndex::removeFromSystemIndexes(FileData* game)
+{
+    // Deleting a folder also deletes the games inside it.
+    if (game->getType() == FOLDER) {
+        for (FileData* child : game->getChildren())
+            removeFromSystemIndexes(child);
+        return;
+    }
+
+    SystemData* system {game->getSystem()};
+    system->getIndex()->removeFromIndex(game);
+
+    if (system->isGroupedCustomCollection())
+        system->getRootFolder()->getParent()->getSystem()->getIndex()->removeFromIndex(game);
 }
 
 void FileFilterIndex::setFilter(FilterIndexType type, std::vector<std::string>* values)
 {
+    mFilterResultValid = false;
+
     // Test if it exists before setting.
     if (type == NONE) {
         clearAllFilters();
@@ -309,6 +384,7 @@ void FileFilterIndex::setFilter(FilterIndexType type, std::vector<std::string>*
 void FileFilterIndex::setTextFilter(std::string textFilter)
 {
     mTextFilter = textFilter;
+    mFilterResultValid = false;
 
     if (textFilter == "")
         mFilterByText = false;
@@ -389,7 +465,7 @@ bool FileFilterIndex::showFile(FileData* game)
     // If folder, needs further inspection - i.e. see if folder contains at least one element
     // that should be shown.
     if (game->getType() == FOLDER) {
-        std::vector<FileData*> children = game->getChildren();
+        const std::vector<FileData*>& children {game->getChildren()};
         // Iterate through all of the children, until there's a match.
         for (std::vector<FileData*>::const_iterator it = children.cbegin(); it != children.cend();
              ++it) {
@@ -399,6 +475,19 @@ bool FileFilterIndex::showFile(FileData* game)
         return false;
     }
 
+    auto ordinalIt = mGameOrdinals.find(game);
+    if (ordinalIt == mGameOrdinals.cend())
+        return matchesFilters(game);
+
+    if (!mFilterResultValid ||
+        mFilterResultKidMode != UIModeController::getInstance()->isUIModeKid())
+        updateFilterResult();
+
+    return testBit(mFilterResult, ordinalIt->second);
+}
+
+bool FileFilterIndex::matchesFilters(FileData* game)
+{
     bool nameMatch = false;
     bool keepGoing = false;
 
@@ -447,6 +536,119 @@ bool FileFilterIndex::showFile(FileData* game)
         return keepGoing;
 }
 
+void FileFilterIndex::addToBitsets(FileData* game)
+{
+    if (mGameOrdinals.find(game) != mGameOrdinals.cend())
+        return;
+
+    size_t ordinal {0};
+    if (!mFreeOrdinals.empty()) {
+        ordinal = mFreeOrdinals.back();
+        mFreeOrdinals.pop_back();
+    }
+    else {
+        ordinal = mGameNames.size();
+        mGameNames.emplace_back();
+    }
+
+    mGameOrdinals[game] = ordinal;
+    mGameNames[ordinal] = Utils::String::toUpper(game->getName());
+
+    for (auto& filterData : filterDataDecl) {
+        KeyBitsets& bitsets {mKeyBitsets[filterData.type]};
+        setBit(bitsets.primary[getIndexableKey(game, filterData.type, false)], ordinal);
+        if (filterData.hasSecondaryKey) {
+            const std::string secondaryKey {getIndexableKey(game, filterData.type, true)};
+            if (secondaryKey != UNKNOWN_LABEL)
+                setBit(bitsets.secondary[secondaryKey], ordinal);
+        }
+    }
+
+    mFilterResultValid = false;
+}
+
+void FileFilterIndex::removeFromBitsets(FileData* game)
+{
+    auto ordinalIt = mGameOrdinals.find(game);
+    if (ordinalIt == mGameOrdinals.end())
+        return;
+
+    const size_t ordinal {ordinalIt->second};
+
+    // The metadata may have been modified since the game was added so the keys can't be
+    // derived from it, instead the ordinal is cleared for all keys.
+    for (auto& bitsets : mKeyBitsets) {
+        for (auto& key : bitsets.second.primary)
+            clearBit(key.second, ordinal);
+        for (auto& key : bitsets.second.secondary)
+            clearBit(key.second, ordinal);
+    }
+
+    mGameNames[ordinal].clear();
+    mFreeOrdinals.emplace_back(ordinal);
+    mGameOrdinals.erase(ordinalIt);
+    mFilterResultValid = false;
+}
+
+void FileFilterIndex::updateFilterResult()
+{
+    const bool kidMode {UIModeController::getInstance()->isUIModeKid()};
+    const size_t wordCount {(mGameNames.size() + 63) / 64};
+    bool filtered {false};
+
+    mFilterResult.assign(wordCount, ~0ULL);
+
+    // Name filters take precedence over all other filters.
+    if (mTextFilter != "") {
+        const std::string textFilter {Utils::String::toUpper(mTextFilter)};
+        GameBitset nameMatches(wordCount, 0);
+        for (auto& game : mGameOrdinals) {
+            if (mGameNames[game.second].find(textFilter) != std::string::npos)
+                setBit(nameMatches, game.second);
+        }
+        andBits(mFilterResult, nameMatches);
+        filtered = true;
+    }
+
+    for (auto& filterData : filterDataDecl) {
+        KeyBitsets& bitsets {mKeyBitsets[filterData.type]};
+        if (filterData.primaryKey == "kidgame" && kidMode) {
+            // In kid mode only games which are not explicitly flagged as kid games are
+            // filtered out, and any subsequent filters are ignored.
+            auto keyIt = bitsets.primary.find("FALSE");
+            if (keyIt != bitsets.primary.cend()) {
+                for (size_t i {0}; i < wordCount && i < keyIt->second.size(); ++i)
+                    mFilterResult[i] &= ~keyIt->second[i];
+            }
+            filtered = true;
+            break;
+        }
+        else if (*(filterData.filteredByRef)) {
+            // A game matches if any of the selected keys match, either its primary key
+            // or its secondary key (i.e. the first genre).
+            GameBitset keyMatches;
+            for (auto& key : *(filterData.currentFilteredKeys)) {
+                auto keyIt = bitsets.primary.find(key);
+                if (keyIt != bitsets.primary.cend())
+                    orBits(keyMatches, keyIt->second);
+                if (filterData.hasSecondaryKey) {
+                    keyIt = bitsets.secondary.find(key);
+                    if (keyIt != bitsets.secondary.cend())
+                        orBits(keyMatches, keyIt->second);
+                }
+            }
+            andBits(mFilterResult, keyMatches);
+            filtered = true;
+        }
+    }
+
+    if (!filtered)
+        mFilterResult.assign(wordCount, 0);
+
+    mFilterResultValid = true;
+    mFilterResultKidMode = kidMode;
+}
+
 bool FileFilterIndex::isFiltered()
 {
     if (UIModeController::getInstance()->isUIModeKid()) {
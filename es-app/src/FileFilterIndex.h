@@ -13,8 +13,10 @@
 #include <sstream>
 #endif
 
+#include <cstdint>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class FileData;
@@ -52,7 +54,12 @@ public:
     FileFilterIndex();
     ~FileFilterIndex();
     void addToIndex(FileData* game);
+    // Does nothing if the game is not part of the index.
     void removeFromIndex(FileData* game);
+    // Removes the game, or all games in a folder, from the index of its system and for grouped
+    // custom collections also from the index of the collections bundle. As the index refers to
+    // the games directly, this must be done before a game is deleted.
+    static void removeFromSystemIndexes(FileData* game);
     void setFilter(FilterIndexType type, std::vector<std::string>* values);
     void setTextFilter(std::string textFilter);
     std::string getTextFilter() { return mTextFilter; }
@@ -69,9 +76,25 @@ public:
     void setKidModeFilters();
 
 private:
+    // Bitset of game ordinals, one bit per game that has been added to the index.
+    using GameBitset = std::vector<uint64_t>;
+
+    struct KeyBitsets {
+        std::map<std::string, GameBitset> primary;
+        std::map<std::string, GameBitset> secondary;
+    };
+
     std::vector<FilterDataDecl> filterDataDecl;
     std::string getIndexableKey(FileData* game, FilterIndexType type, bool getSecondary);
 
+    // Games not present in the index (which should normally not happen) are evaluated
+    // directly using their metadata.
+    bool matchesFilters(FileData* game);
+
+    void addToBitsets(FileData* game);
+    void removeFromBitsets(FileData* game);
+    void updateFilterResult();
+
     void manageRatingsEntryInIndex(FileData* game, bool remove = false);
     void manageDeveloperEntryInIndex(FileData* game, bool remove = false);
     void managePublisherEntryInIndex(FileData* game, bool remove = false);
@@ -92,6 +115,14 @@ private:
     std::string mTextFilter;
     bool mFilterByText;
 
+    std::unordered_map<FileData*, size_t> mGameOrdinals;
+    std::vector<size_t> mFreeOrdinals;
+    std::vector<std::string> mGameNames;
+    std::map<FilterIndexType, KeyBitsets> mKeyBitsets;
+    GameBitset mFilterResult;
+    bool mFilterResultValid;
+    bool mFilterResultKidMode;
+
     bool mFilterByRatings;
     bool mFilterByDeveloper;
     bool mFilterByPublisher;
@@ -0,0 +1,84 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  MediaDirectoryIndex.cpp
+//
+//  Index of the files in the game media directories, used by FileData to look up media
+//  files without having to check for the existence of every possible file extension.
+//  Each directory is listed the first time it's accessed and is then kept updated when
+//  media files are written or removed by the application.
+//
+
+#include "MediaDirectoryIndex.h"
+
+#include "utils/FileSystemUtil.h"
+#include "utils/StringUtil.h"
+
+MediaDirectoryIndex& MediaDirectoryIndex::getInstance()
+{
+    static MediaDirectoryIndex instance;
+    return instance;
+}
+
+bool MediaDirectoryIndex::exists(const std::string& path)
+{
+    std::unique_lock<std::mutex> lock {mMutex};
+    const std::unordered_set<std::string>& directory {
+        getDirectory(Utils::FileSystem::getParent(path))};
+    return directory.find(getKey(Utils::FileSystem::getFileName(path))) != directory.cend();
+}
+
+void MediaDirectoryIndex::addFile(const std::string& path)
+{
+    std::unique_lock<std::mutex> lock {mMutex};
+    auto dirIt = mDirectories.find(Utils::FileSystem::getParent(path));
+
+    // If the directory has not been indexed yet it will be listed when first accessed.
+    if (dirIt != mDirectories.end())
+        dirIt->second.emplace(getKey(Utils::FileSystem::getFileName(path)));
+}
+
+void MediaDirectoryIndex::removeFile(const std::string& path)
+{
+    std::unique_lock<std::mutex> lock {mMutex};
+    auto dirIt = mDirectories.find(Utils::FileSystem::getParent(path));
+
+    if (dirIt != mDirectories.end())
+        dirIt->second.erase(getKey(Utils::FileSystem::getFileName(path)));
+}
+
+void MediaDirectoryIndex::clear()
+{
+    std::unique_lock<std::mutex> lock {mMutex};
+    mDirectories.clear();
+}
+
+std::unordered_set<std::string>& MediaDirectoryIndex::getDirectory(const std::string& path)
+{
+    auto dirIt = mDirectories.find(path);
+    if (dirIt != mDirectories.end())
+        return dirIt->second;
+
+    std::unordered_set<std::string>& directory {mDirectories[path]};
+
+    // Non-existent directories are indexed as well as most games will not have media
+    // files for all media types.
+    if (Utils::FileSystem::isDirectory(path)) {
+        for (auto& file : Utils::FileSystem::getDirContent(path)) {
+            if (Utils::FileSystem::isRegularFile(file) || Utils::FileSystem::isSymlink(file))
+                directory.emplace(getKey(Utils::FileSystem::getFileName(file)));
+        }
+    }
+
+    return directory;
+}
+
+std::string MediaDirectoryIndex::getKey(const std::string& fileName)
+{
+#if defined(_WIN64) || defined(__APPLE__)
+    // The filesystems on these operating systems are normally case insensitive.
+    return Utils::String::toLower(fileName);
+#else
+    return fileName;
+#endif
+}
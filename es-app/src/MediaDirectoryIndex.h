@@ -0,0 +1,45 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  MediaDirectoryIndex.h
+//
+//  Index of the files in the game media directories, used by FileData to look up media
+//  files without having to check for the existence of every possible file extension.
+//  Each directory is listed the first time it's accessed and is then kept updated when
+//  media files are written or removed by the application.
+//
+
+#ifndef ES_APP_MEDIA_DIRECTORY_INDEX_H
+#define ES_APP_MEDIA_DIRECTORY_INDEX_H
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+class MediaDirectoryIndex
+{
+public:
+    static MediaDirectoryIndex& getInstance();
+
+    // Returns whether the file exists, the parent directory is listed if not already indexed.
+    bool exists(const std::string& path);
+
+    // These should be called whenever a media file has been written or removed.
+    void addFile(const std::string& path);
+    void removeFile(const std::string& path);
+
+    // Clears the entire index, all directories will be listed again when next accessed.
+    void clear();
+
+private:
+    MediaDirectoryIndex() {}
+
+    std::unordered_set<std::string>& getDirectory(const std::string& path);
+    static std::string getKey(const std::string& fileName);
+
+    std::unordered_map<std::string, std::unordered_set<std::string>> mDirectories;
+    std::mutex mMutex;
+};
+
+#endif // ES_APP_MEDIA_DIRECTORY_INDEX_H
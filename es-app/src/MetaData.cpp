@@ -14,6 +14,12 @@
 
 #include <pugixml.hpp>
 
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 namespace
 {
     // clang-format off
@@ -74,6 +80,97 @@ namespace
     const std::vector<MetaDataDecl> folderMDD {
         folderDecls, folderDecls + sizeof(folderDecls) / sizeof(folderDecls[0])};
 
+    struct KeyName {
+        MetaDataKey key;
+        const char* name;
+    };
+
+    // clang-format off
+    // The entries must be in the same order as the MetaDataKey enum, which is verified below.
+    constexpr KeyName keyNames[] {
+        {MD_KEY_NAME,               "name"},
+        {MD_KEY_SORTNAME,           "sortname"},
+        {MD_KEY_COLLECTIONSORTNAME, "collectionsortname"},
+        {MD_KEY_DESC,               "desc"},
+        {MD_KEY_RATING,             "rating"},
+        {MD_KEY_RELEASEDATE,        "releasedate"},
+        {MD_KEY_DEVELOPER,          "developer"},
+        {MD_KEY_PUBLISHER,          "publisher"},
+        {MD_KEY_GENRE,              "genre"},
+        {MD_KEY_PLAYERS,            "players"},
+        {MD_KEY_FAVORITE,           "favorite"},
+        {MD_KEY_COMPLETED,          "completed"},
+        {MD_KEY_KIDGAME,            "kidgame"},
+        {MD_KEY_HIDDEN,             "hidden"},
+        {MD_KEY_BROKEN,             "broken"},
+        {MD_KEY_NOGAMECOUNT,        "nogamecount"},
+        {MD_KEY_NOMULTISCRAPE,      "nomultiscrape"},
+        {MD_KEY_HIDEMETADATA,       "hidemetadata"},
+        {MD_KEY_PLAYCOUNT,          "playcount"},
+        {MD_KEY_CONTROLLER,         "controller"},
+        {MD_KEY_ALTEMULATOR,        "altemulator"},
+        {MD_KEY_FOLDERLINK,         "folderlink"},
+        {MD_KEY_LASTPLAYED,         "lastplayed"}
+    };
+    // clang-format on
+
+    constexpr bool keyNamesMatchEnum()
+    {
+        if (sizeof(keyNames) / sizeof(keyNames[0]) != MD_KEY_COUNT)
+            return false;
+        for (int i {0}; i < MD_KEY_COUNT; ++i) {
+            if (keyNames[i].key != i)
+                return false;
+        }
+        return true;
+    }
+
+    static_assert(keyNamesMatchEnum(),
+                  "The key names must contain every MetaDataKey entry in the enum order");
+
+    const std::string noResult;
+
+    // Each thread interns the values into its own pool so that the threads loading the
+    // gamelists don't need to wait for each other. As the metadata lists keep pointing to the
+    // values, a pool is never deleted but is instead passed on to the next thread that needs
+    // one when its thread exits. A value may therefore be stored once in every pool.
+    using ValuePool = std::unordered_set<std::string>;
+    std::mutex valuePoolsMutex;
+    std::vector<ValuePool*> unusedValuePools;
+
+    struct ThreadValuePool {
+        ValuePool* pool {nullptr};
+
+        ~ThreadValuePool()
+        {
+            if (pool == nullptr)
+                return;
+            std::unique_lock<std::mutex> lock {valuePoolsMutex};
+            unusedValuePools.emplace_back(pool);
+        }
+    };
+
+    const std::string* internValue(const std::string& value)
+    {
+        thread_local ThreadValuePool threadValuePool;
+
+        if (threadValuePool.pool == nullptr) {
+            std::unique_lock<std::mutex> lock {valuePoolsMutex};
+            if (unusedValuePools.empty()) {
+                threadValuePool.pool = new ValuePool;
+            }
+            else {
+                threadValuePool.pool = unusedValuePools.back();
+                unusedValuePools.pop_back();
+            }
+        }
+
+        // Elements in an unordered_set are never moved so the pointers stay valid.
+        return &(*threadValuePool.pool->emplace(value).first);
+    }
+
+    std::atomic<unsigned long long> revisionCounter {0};
+
 } // namespace
 
 const std::vector<MetaDataDecl>& getMDDByType(MetaDataListType type)
@@ -91,8 +188,15 @@ const std::vector<MetaDataDecl>& getMDDByType(MetaDataListType type)
 
 MetaDataList::MetaDataList(MetaDataListType type)
     : mType(type)
+    , mBoolValues(0)
+    , mRating(0.0f)
+    , mPlayCount(0)
+    , mRevision(0)
     , mWasChanged(false)
 {
+    // Keys which are not defined for this metadata type are left empty.
+    mInternedValues.fill(internValue(""));
+
     const std::vector<MetaDataDecl>& mdd = getMDD();
     for (auto it = mdd.cbegin(); it != mdd.cend(); ++it)
         set(it->key, it->defaultValue);
@@ -129,36 +233,80 @@ void MetaDataList::appendToXML(pugi::xml_node& parent,
     const std::vector<MetaDataDecl>& mdd = getMDD();
 
     for (auto it = mdd.cbegin(); it != mdd.cend(); ++it) {
-        auto mapIter = mMap.find(it->key);
-        if (mapIter != mMap.cend()) {
-            // We have this value!
-            // If it's just the default (and we ignore defaults), don't write it.
-            if (ignoreDefaults && mapIter->second == it->defaultValue)
-                continue;
-
-            // Try and make paths relative if we can.
-            std::string value = mapIter->second;
-            if (it->type == MD_PATH)
-                value = Utils::FileSystem::createRelativePath(value, relativeTo, true);
+        const std::string& mdValue {get(it->key)};
 
-            parent.append_child(mapIter->first.c_str()).text().set(value.c_str());
-        }
+        // If it's just the default (and we ignore defaults), don't write it.
+        if (ignoreDefaults && mdValue == it->defaultValue)
+            continue;
+
+        // Try and make paths relative if we can.
+        std::string value {mdValue};
+        if (it->type == MD_PATH)
+            value = Utils::FileSystem::createRelativePath(value, relativeTo, true);
+
+        parent.append_child(it->key.c_str()).text().set(value.c_str());
     }
 }
 
 void MetaDataList::set(const std::string& key, const std::string& value)
 {
-    mMap[key] = value;
+    const MetaDataKey mdKey {getKey(key)};
+
+    if (mdKey == MD_KEY_COUNT) {
+        LOG(LogError) << "MetaDataList::set(): Invalid metadata key \"" << key << "\"";
+        return;
+    }
+
+    set(mdKey, value);
+}
+
+void MetaDataList::set(MetaDataKey key, const std::string& value)
+{
+    if (key < MD_KEY_FIRST_INTERNED)
+        mValues[key] = value;
+    else
+        mInternedValues[key - MD_KEY_FIRST_INTERNED] = internValue(value);
+
+    switch (key) {
+        case MD_KEY_FAVORITE:
+        case MD_KEY_COMPLETED:
+        case MD_KEY_KIDGAME:
+        case MD_KEY_HIDDEN:
+        case MD_KEY_BROKEN:
+        case MD_KEY_NOGAMECOUNT:
+        case MD_KEY_NOMULTISCRAPE:
+        case MD_KEY_HIDEMETADATA: {
+            if (value == "true")
+                mBoolValues |= (1u << key);
+            else
+                mBoolValues &= ~(1u << key);
+            break;
+        }
+        case MD_KEY_RATING: {
+            mRating = static_cast<float>(atof(value.c_str()));
+            break;
+        }
+        case MD_KEY_PLAYCOUNT: {
+            mPlayCount = atoi(value.c_str());
+            break;
+        }
+        default:
+            break;
+    }
+
+    mRevision = ++revisionCounter;
     mWasChanged = true;
 }
 
 const std::string& MetaDataList::get(const std::string& key) const
 {
     // Check that the key actually exists, otherwise return an empty string.
-    if (mMap.count(key) > 0)
-        return mMap.at(key);
+    const MetaDataKey mdKey {getKey(key)};
+
+    if (mdKey == MD_KEY_COUNT)
+        return noResult;
     else
-        return mNoResult;
+        return get(mdKey);
 }
 
 int MetaDataList::getInt(const std::string& key) const
@@ -167,12 +315,44 @@ int MetaDataList::getInt(const std::string& key) const
     return atoi(get(key).c_str());
 }
 
+int MetaDataList::getInt(MetaDataKey key) const
+{
+    if (key == MD_KEY_PLAYCOUNT)
+        return mPlayCount;
+    else
+        return atoi(get(key).c_str());
+}
+
 float MetaDataList::getFloat(const std::string& key) const
 {
     // Return float value.
     return static_cast<float>(atof(get(key).c_str()));
 }
 
+float MetaDataList::getFloat(MetaDataKey key) const
+{
+    if (key == MD_KEY_RATING)
+        return mRating;
+    else
+        return static_cast<float>(atof(get(key).c_str()));
+}
+
+MetaDataKey MetaDataList::getKey(const std::string& key)
+{
+    static const std::unordered_map<std::string, MetaDataKey> keyMap {[] {
+        std::unordered_map<std::string, MetaDataKey> map;
+        for (auto& keyName : keyNames)
+            map[keyName.name] = keyName.key;
+        return map;
+    }()};
+
+    auto keyIt = keyMap.find(key);
+    if (keyIt == keyMap.cend())
+        return MD_KEY_COUNT;
+    else
+        return keyIt->second;
+}
+
 bool MetaDataList::wasChanged() const
 {
     // Return whether the metadata was changed.
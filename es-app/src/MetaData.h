@@ -14,6 +14,7 @@
 #include <sstream>
 #endif
 
+#include <array>
 #include <map>
 #include <string>
 #include <vector>
@@ -41,6 +42,37 @@ enum MetaDataType {
     MD_TIME // Used for lastplayed.
 };
 
+// All metadata keys for both games and folders. The keys with mostly unique values are
+// placed first as these are stored directly in MetaDataList, all other values are interned.
+enum MetaDataKey {
+    MD_KEY_NAME,
+    MD_KEY_SORTNAME,
+    MD_KEY_COLLECTIONSORTNAME,
+    MD_KEY_DESC,
+    MD_KEY_RATING,
+    MD_KEY_RELEASEDATE,
+    MD_KEY_DEVELOPER,
+    MD_KEY_PUBLISHER,
+    MD_KEY_GENRE,
+    MD_KEY_PLAYERS,
+    MD_KEY_FAVORITE,
+    MD_KEY_COMPLETED,
+    MD_KEY_KIDGAME,
+    MD_KEY_HIDDEN,
+    MD_KEY_BROKEN,
+    MD_KEY_NOGAMECOUNT,
+    MD_KEY_NOMULTISCRAPE,
+    MD_KEY_HIDEMETADATA,
+    MD_KEY_PLAYCOUNT,
+    MD_KEY_CONTROLLER,
+    MD_KEY_ALTEMULATOR,
+    MD_KEY_FOLDERLINK,
+    MD_KEY_LASTPLAYED,
+    MD_KEY_COUNT
+};
+
+const MetaDataKey MD_KEY_FIRST_INTERNED {MD_KEY_RATING};
+
 struct MetaDataDecl {
     std::string key;
     MetaDataType type;
@@ -75,13 +107,29 @@ public:
     MetaDataList(MetaDataListType type);
 
     void set(const std::string& key, const std::string& value);
+    void set(MetaDataKey key, const std::string& value);
 
     const std::string& get(const std::string& key) const;
+    const std::string& get(MetaDataKey key) const
+    {
+        return (key < MD_KEY_FIRST_INTERNED ? mValues[key] :
+                                              *mInternedValues[key - MD_KEY_FIRST_INTERNED]);
+    }
     int getInt(const std::string& key) const;
+    int getInt(MetaDataKey key) const;
     float getFloat(const std::string& key) const;
+    float getFloat(MetaDataKey key) const;
+    // Only valid for MD_BOOL keys, returns true if the value is "true".
+    bool getBool(MetaDataKey key) const { return (mBoolValues & (1u << key)) != 0; }
+
+    // Returns the key for a key name, or MD_KEY_COUNT if there is no such key.
+    static MetaDataKey getKey(const std::string& key);
 
     bool wasChanged() const;
     void resetChangedFlag();
+    // Changes whenever a value is set, and is unique across all instances except for copies.
+    // This makes it possible to cache values derived from the metadata.
+    unsigned long long getRevision() const { return mRevision; }
 
     MetaDataListType getType() const { return mType; }
     const std::vector<MetaDataDecl>& getMDD() const { return getMDDByType(getType()); }
@@ -92,8 +140,15 @@ public:
 
 private:
     MetaDataListType mType;
-    std::map<std::string, std::string> mMap;
-    std::string mNoResult = "";
+    std::array<std::string, MD_KEY_FIRST_INTERNED> mValues;
+    // Points to strings in the interned value pools, which are never cleared.
+    std::array<const std::string*, MD_KEY_COUNT - MD_KEY_FIRST_INTERNED> mInternedValues;
+    // Values of the boolean keys and of the numerical keys used for sorting are also stored
+    // natively so they don't need to be converted.
+    unsigned int mBoolValues;
+    float mRating;
+    int mPlayCount;
+    unsigned long long mRevision;
     bool mWasChanged;
 };
 
@@ -10,6 +10,7 @@
 #include "MiximageGenerator.h"
 
 #include "Log.h"
+#include "MediaDirectoryIndex.h"
 #include "Settings.h"
 #include "SystemData.h"
 #include "utils/StringUtil.h"
@@ -767,6 +768,9 @@ bool MiximageGenerator::generateImage()
     if (!savedImage) {
         LOG(LogError) << "Couldn't save miximage, permission problems or disk full?";
     }
+    else {
+        MediaDirectoryIndex::getInstance().addFile(getSavePath());
+    }
 
     FreeImage_Unload(screenshotFile);
     FreeImage_Unload(marqueeFile);
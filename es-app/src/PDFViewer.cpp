@@ -4,13 +4,19 @@
 //  PDFViewer.cpp
 //
 //  Parses and renders pages using the Poppler library via the external es-pdf-convert binary.
+//  Pages are converted by a background thread which also prefetches the pages following the
+//  current page in the direction of travel, and converted pages are kept in an on-disk cache.
 //
 
 #include "PDFViewer.h"
 
+#include "ImageIO.h"
 #include "Log.h"
+#include "Settings.h"
 #include "Sound.h"
+#include "utils/CacheFileUtil.h"
 #include "utils/FileSystemUtil.h"
+#include "utils/MathUtil.h"
 #include "utils/StringUtil.h"
 #include "views/ViewController.h"
 
@@ -31,12 +37,124 @@
 #define KEY_REPEAT_SPEED 250
 #define KEY_REPEAT_SPEED_ZOOMED 150
 
+// Number of pages to convert ahead of the current page in the direction of travel.
+#define PREFETCH_PAGES 3
+
+namespace
+{
+    const std::string cacheFileMagic {"ESDEPDFC"};
+    const unsigned int cacheFileVersion {2};
+
+    std::string getPageCacheDirectory()
+    {
+        return Utils::FileSystem::getAppDataDirectory() + "/cache/pdf";
+    }
+
+    long long getMaxPageCacheSize()
+    {
+        const int cacheSize {
+            glm::clamp(Settings::getInstance()->getInt("PDFPageCacheSize"), 0, 16384)};
+        return static_cast<long long>(cacheSize) * 1024 * 1024;
+    }
+
+    std::string getPageCacheKey(const std::string& manualPath, int pageNum, int width, int height)
+    {
+        return manualPath + "\n" + std::to_string(pageNum) + "\n" + std::to_string(width) + "x" +
+               std::to_string(height);
+    }
+
+    // Returns false if the page is not cached or if the manual has been modified.
+    bool readCachedPage(const std::string& manualPath,
+                        int pageNum,
+                        int width,
+                        int height,
+                        std::vector<char>& imageData)
+    {
+        if (getMaxPageCacheSize() == 0)
+            return false;
+
+        const std::string key {getPageCacheKey(manualPath, pageNum, width, height)};
+        const std::string cachePath {
+            Utils::CacheFile::getHashedPath(getPageCacheDirectory(), key)};
+        Utils::CacheFile::Reader reader {cachePath, cacheFileMagic, cacheFileVersion};
+
+        const long long modTime {reader.read<long long>()};
+        const long long fileSize {reader.read<long long>()};
+
+        // Different keys could end up with the same file name if there is a hash collision.
+        if (!reader.isValid() || reader.readString() != key)
+            return false;
+
+        if (modTime != Utils::FileSystem::getModificationTime(manualPath) ||
+            fileSize != Utils::FileSystem::getFileSize(manualPath))
+            return false;
+
+        const std::string pngData {reader.readString()};
+        if (!reader.isValid())
+            return false;
+
+        size_t pageWidth {0};
+        size_t pageHeight {0};
+        const std::vector<unsigned char> pixels {
+            ImageIO::loadFromMemoryRGBA32(reinterpret_cast<const unsigned char*>(pngData.data()),
+                                          pngData.size(), pageWidth, pageHeight)};
+
+        if (pageWidth != static_cast<size_t>(width) || pageHeight != static_cast<size_t>(height))
+            return false;
+
+        imageData.assign(pixels.cbegin(), pixels.cend());
+        Utils::CacheFile::touchFile(cachePath);
+
+        return true;
+    }
+
+    void writeCachedPage(const std::string& manualPath,
+                         int pageNum,
+                         int width,
+                         int height,
+                         const std::vector<char>& imageData)
+    {
+        // The pages are stored as PNG files as the uncompressed pixel data would be several
+        // megabytes per page, while rendered pages usually compress very well.
+        static Utils::CacheFile::DirectoryLimiter directoryLimiter {getPageCacheDirectory()};
+
+        const long long maxCacheSize {getMaxPageCacheSize()};
+        if (maxCacheSize == 0 || imageData.size() < static_cast<size_t>(width) * height * 4)
+            return;
+
+        const long long modTime {Utils::FileSystem::getModificationTime(manualPath)};
+        if (modTime == -1)
+            return;
+
+        const std::vector<unsigned char> pngData {
+            ImageIO::saveToMemoryPNG(reinterpret_cast<const unsigned char*>(imageData.data()),
+                                     static_cast<size_t>(width), static_cast<size_t>(height))};
+        if (pngData.empty())
+            return;
+
+        const std::string key {getPageCacheKey(manualPath, pageNum, width, height)};
+        const std::string cachePath {
+            Utils::CacheFile::getHashedPath(getPageCacheDirectory(), key)};
+        Utils::CacheFile::Writer writer {cachePath, cacheFileMagic, cacheFileVersion};
+
+        writer.write<long long>(modTime);
+        writer.write<long long>(Utils::FileSystem::getFileSize(manualPath));
+        writer.writeString(key);
+        writer.writeString(std::string {pngData.cbegin(), pngData.cend()});
+
+        const long long cacheFileSize {writer.commit()};
+        if (cacheFileSize != -1)
+            directoryLimiter.addFile(cacheFileSize, maxCacheSize);
+    }
+} // namespace
+
 PDFViewer::PDFViewer()
     : mRenderer {Renderer::getInstance()}
     , mGame {nullptr}
     , mFrameHeight {0.0f}
     , mScaleFactor {1.0f}
     , mCurrentPage {0}
+    , mDisplayedPage {0}
     , mPageCount {0}
     , mZoom {1.0f}
     , mPanAmount {0.0f}
@@ -47,10 +165,26 @@ PDFViewer::PDFViewer()
     , mKeyRepeatZoom {0}
     , mKeyRepeatTimer {0}
     , mHelpInfoPosition {HelpInfoPosition::TOP}
+    , mConvertingPage {0}
+    , mStopConversion {false}
 {
     Window::getInstance()->setPDFViewer(this);
 }
 
+PDFViewer::~PDFViewer()
+{
+    if (mConversionThread) {
+        {
+            std::unique_lock<std::mutex> lock {mConversionMutex};
+            mStopConversion = true;
+            mConversionQueue.clear();
+        }
+        mConversionCondition.notify_one();
+        mConversionThread->join();
+        mConversionThread.reset();
+    }
+}
+
 bool PDFViewer::startPDFViewer(FileData* game)
 {
     ViewController::getInstance()->pauseViewVideos();
@@ -90,10 +224,20 @@ bool PDFViewer::startPDFViewer(FileData* game)
 
     LOG(LogDebug) << "PDFViewer::startPDFViewer(): Opening document \"" << mManualPath << "\"";
 
+    // The thread from the previous session may still be finishing its last page conversion.
+    if (mConversionThread) {
+        mConversionThread->join();
+        mConversionThread.reset();
+    }
+
     mPages.clear();
     mPageImage.reset();
+    mConversionQueue.clear();
+    mConvertingPage = 0;
+    mStopConversion = false;
     mPageCount = 0;
     mCurrentPage = 0;
+    mDisplayedPage = 0;
     mScaleFactor = 1.0f;
     mZoom = 1.0f;
     mPanAmount = 0.0f;
@@ -203,7 +347,9 @@ bool PDFViewer::startPDFViewer(FileData* game)
     mHelp->setStyle(style);
     mHelp->setPrompts(getHelpPrompts());
 
-    convertPage(mCurrentPage);
+    mConversionThread = std::make_unique<std::thread>(&PDFViewer::conversionThread, this,
+                                                      mESConvertPath, mManualPath);
+    queuePages(1);
     return true;
 }
 
@@ -212,7 +358,16 @@ void PDFViewer::stopPDFViewer()
     NavigationSounds::getInstance().playThemeNavigationSound(SCROLLSOUND);
     ViewController::getInstance()->startViewVideos();
 
-    mPages.clear();
+    // Don't wait for any ongoing page conversion to finish as that would delay closing the
+    // viewer, the thread is instead joined when the viewer is started the next time.
+    {
+        std::unique_lock<std::mutex> lock {mConversionMutex};
+        mStopConversion = true;
+        mConversionQueue.clear();
+        mPages.clear();
+    }
+    mConversionCondition.notify_one();
+
     mPageImage.reset();
 }
 
@@ -342,157 +497,255 @@ bool PDFViewer::getDocumentInfo()
         mPages[atoi(&rowValues[0][0])] = PageEntry {static_cast<float>(atof(&rowValues[2][0])),
                                                     static_cast<float>(atof(&rowValues[3][0])),
                                                     rowValues[1],
-                                                    {}};
+                                                    {},
+                                                    false};
     }
 
     return true;
 }
 
-void PDFViewer::convertPage(int pageNum)
+void PDFViewer::queuePages(int direction)
 {
-    assert(pageNum <= static_cast<int>(mPages.size()));
-    const auto conversionStartTime {std::chrono::system_clock::now()};
-    mConversionTime = 0;
+    // The current page is converted first, followed by the pages in the direction of travel
+    // and lastly the page in the opposite direction.
+    std::vector<int> pages {mCurrentPage};
+    for (int i {1}; i <= PREFETCH_PAGES; ++i)
+        pages.emplace_back(mCurrentPage + i * direction);
+    pages.emplace_back(mCurrentPage - direction);
+
+    {
+        std::unique_lock<std::mutex> lock {mConversionMutex};
+        mConversionQueue.clear();
+        for (int pageNum : pages) {
+            if (pageNum < 1 || pageNum > mPageCount || pageNum == mConvertingPage)
+                continue;
+            const PageEntry& page {mPages[pageNum]};
+            if (page.imageData.empty() && !page.conversionFailed)
+                mConversionQueue.emplace_back(pageNum);
+        }
+    }
+    mConversionCondition.notify_one();
+}
+
+void PDFViewer::conversionThread(const std::string esConvertPath, const std::string manualPath)
+{
+    while (true) {
+        int pageNum {0};
+        int width {0};
+        int height {0};
+        {
+            std::unique_lock<std::mutex> lock {mConversionMutex};
+            mConversionCondition.wait(
+                lock, [this] { return mStopConversion || !mConversionQueue.empty(); });
+            if (mStopConversion)
+                return;
+
+            pageNum = mConversionQueue.front();
+            mConversionQueue.pop_front();
+
+            const PageEntry& page {mPages[pageNum]};
+            if (!page.imageData.empty() || page.conversionFailed)
+                continue;
+
+            width = static_cast<int>(page.width);
+            height = static_cast<int>(page.height);
+            mConvertingPage = pageNum;
+        }
+
+#if (DEBUG_PDF_CONVERSION)
+        const auto conversionStartTime {std::chrono::system_clock::now()};
+#endif
+        std::vector<char> imageData;
+        bool converted {readCachedPage(manualPath, pageNum, width, height, imageData)};
+
+        if (!converted) {
+            converted = convertPage(esConvertPath, manualPath, pageNum, width, height, imageData);
+            if (converted)
+                writeCachedPage(manualPath, pageNum, width, height, imageData);
+        }
+
+#if (DEBUG_PDF_CONVERSION)
+        LOG(LogDebug) << "Page " << pageNum << " converted in "
+                      << std::chrono::duration_cast<std::chrono::milliseconds>(
+                             std::chrono::system_clock::now() - conversionStartTime)
+                             .count()
+                      << " ms";
+#endif
+
+        std::unique_lock<std::mutex> lock {mConversionMutex};
+        mConvertingPage = 0;
+        // The pages have been cleared if the viewer was stopped during the conversion.
+        if (mStopConversion)
+            return;
+        if (converted)
+            mPages[pageNum].imageData = std::move(imageData);
+        else
+            mPages[pageNum].conversionFailed = true;
+    }
+}
 
-    if (mPages[pageNum].imageData.empty()) {
+bool PDFViewer::convertPage(const std::string& esConvertPath,
+                            const std::string& manualPath,
+                            int pageNum,
+                            int width,
+                            int height,
+                            std::vector<char>& imageData)
+{
 #if defined(_WIN64)
-        std::wstring command {
-            Utils::String::stringToWideString(Utils::FileSystem::getEscapedPath(mESConvertPath))};
-        command.append(L" -convert ")
-            .append(
-                Utils::String::stringToWideString(Utils::FileSystem::getEscapedPath(mManualPath)))
-            .append(L" ")
-            .append(std::to_wstring(pageNum))
-            .append(L" ")
-            .append(std::to_wstring(static_cast<int>(mPages[pageNum].width)))
-            .append(L" ")
-            .append(std::to_wstring(static_cast<int>(mPages[pageNum].height)));
+    std::wstring command {
+        Utils::String::stringToWideString(Utils::FileSystem::getEscapedPath(esConvertPath))};
+    command.append(L" -convert ")
+        .append(Utils::String::stringToWideString(Utils::FileSystem::getEscapedPath(manualPath)))
+        .append(L" ")
+        .append(std::to_wstring(pageNum))
+        .append(L" ")
+        .append(std::to_wstring(width))
+        .append(L" ")
+        .append(std::to_wstring(height));
 #else
-        std::string command {Utils::FileSystem::getEscapedPath(mESConvertPath)};
-        command.append(" -convert ")
-            .append(Utils::FileSystem::getEscapedPath(mManualPath))
-            .append(" ")
-            .append(std::to_string(pageNum))
-            .append(" ")
-            .append(std::to_string(static_cast<int>(mPages[pageNum].width)))
-            .append(" ")
-            .append(std::to_string(static_cast<int>(mPages[pageNum].height)));
+    std::string command {Utils::FileSystem::getEscapedPath(esConvertPath)};
+    command.append(" -convert ")
+        .append(Utils::FileSystem::getEscapedPath(manualPath))
+        .append(" ")
+        .append(std::to_string(pageNum))
+        .append(" ")
+        .append(std::to_string(width))
+        .append(" ")
+        .append(std::to_string(height));
 #endif
 
 #if (DEBUG_PDF_CONVERSION)
-        LOG(LogDebug) << "Converting page: " << mCurrentPage;
+    LOG(LogDebug) << "Converting page: " << pageNum;
 #if defined(_WIN64)
-        LOG(LogDebug) << Utils::String::wideStringToString(command);
+    LOG(LogDebug) << Utils::String::wideStringToString(command);
 #else
-        LOG(LogDebug) << command;
+    LOG(LogDebug) << command;
 #endif
 #endif
-        std::string imageData;
+
 #if defined(_WIN64)
-        STARTUPINFOW si {};
-        PROCESS_INFORMATION pi;
-        HANDLE childStdoutRead {nullptr};
-        HANDLE childStdoutWrite {nullptr};
-        SECURITY_ATTRIBUTES saAttr {};
-        saAttr.nLength = sizeof(SECURITY_ATTRIBUTES);
-        saAttr.bInheritHandle = true;
-        saAttr.lpSecurityDescriptor = nullptr;
-
-        CreatePipe(&childStdoutRead, &childStdoutWrite, &saAttr, 0);
-        SetHandleInformation(childStdoutRead, HANDLE_FLAG_INHERIT, 0);
-
-        si.cb = sizeof(STARTUPINFOW);
-        si.hStdOutput = childStdoutWrite;
-        si.dwFlags |= STARTF_USESTDHANDLES;
-
-        bool processReturnValue {true};
-
-        // clang-format off
-        processReturnValue = CreateProcessW(
-            nullptr,                            // No application name (use command line).
-            const_cast<wchar_t*>(command.c_str()), // Command line.
-            nullptr,                            // Process attributes.
-            nullptr,                            // Thread attributes.
-            TRUE,                               // Handles inheritance.
-            0,                                  // Creation flags.
-            nullptr,                            // Use parent's environment block.
-            nullptr,                            // Starting directory, possibly the same as parent.
-            &si,                                // Pointer to the STARTUPINFOW structure.
-            &pi);                               // Pointer to the PROCESS_INFORMATION structure.
-        // clang-format on
-
-        if (!processReturnValue) {
-            CloseHandle(pi.hProcess);
-            CloseHandle(pi.hThread);
-            return;
-        }
+    STARTUPINFOW si {};
+    PROCESS_INFORMATION pi;
+    HANDLE childStdoutRead {nullptr};
+    HANDLE childStdoutWrite {nullptr};
+    SECURITY_ATTRIBUTES saAttr {};
+    saAttr.nLength = sizeof(SECURITY_ATTRIBUTES);
+    saAttr.bInheritHandle = true;
+    saAttr.lpSecurityDescriptor = nullptr;
 
-        // Close process and thread handles.
+    CreatePipe(&childStdoutRead, &childStdoutWrite, &saAttr, 0);
+    SetHandleInformation(childStdoutRead, HANDLE_FLAG_INHERIT, 0);
+
+    si.cb = sizeof(STARTUPINFOW);
+    si.hStdOutput = childStdoutWrite;
+    si.dwFlags |= STARTF_USESTDHANDLES;
+
+    bool processReturnValue {true};
+
+    // clang-format off
+    processReturnValue = CreateProcessW(
+        nullptr,                                // No application name (use command line).
+        const_cast<wchar_t*>(command.c_str()),  // Command line.
+        nullptr,                                // Process attributes.
+        nullptr,                                // Thread attributes.
+        TRUE,                                   // Handles inheritance.
+        0,                                      // Creation flags.
+        nullptr,                                // Use parent's environment block.
+        nullptr,                                // Starting directory, possibly the same as parent.
+        &si,                                    // Pointer to the STARTUPINFOW structure.
+        &pi);                                   // Pointer to the PROCESS_INFORMATION structure.
+    // clang-format on
+
+    if (!processReturnValue) {
         CloseHandle(pi.hProcess);
         CloseHandle(pi.hThread);
-        CloseHandle(childStdoutWrite);
-
-        std::array<char, 512> buffer {};
-        DWORD dwRead;
-        bool readValue {true};
-
-        while (readValue) {
-            readValue = ReadFile(childStdoutRead, &buffer[0], 512, &dwRead, nullptr);
-            if (readValue) {
-                mPages[pageNum].imageData.insert(mPages[pageNum].imageData.end(),
-                                                 std::make_move_iterator(buffer.begin()),
-                                                 std::make_move_iterator(buffer.end()));
-            }
+        LOG(LogError) << "Error reading PDF file";
+        return false;
+    }
+
+    // Close process and thread handles.
+    CloseHandle(pi.hProcess);
+    CloseHandle(pi.hThread);
+    CloseHandle(childStdoutWrite);
+
+    std::array<char, 512> buffer {};
+    DWORD dwRead;
+    bool readValue {true};
+
+    while (readValue) {
+        readValue = ReadFile(childStdoutRead, &buffer[0], 512, &dwRead, nullptr);
+        if (readValue) {
+            imageData.insert(imageData.end(), std::make_move_iterator(buffer.begin()),
+                             std::make_move_iterator(buffer.end()));
         }
+    }
 
-        CloseHandle(childStdoutRead);
-        WaitForSingleObject(pi.hThread, INFINITE);
-        WaitForSingleObject(pi.hProcess, INFINITE);
+    CloseHandle(childStdoutRead);
+    WaitForSingleObject(pi.hThread, INFINITE);
+    WaitForSingleObject(pi.hProcess, INFINITE);
 #elif (__ANDROID__)
-        ConvertPDF::processFile(mManualPath, "-convert", pageNum,
-                                static_cast<int>(mPages[pageNum].width),
-                                static_cast<int>(mPages[pageNum].height), imageData);
-        mPages[pageNum].imageData.insert(mPages[pageNum].imageData.end(),
-                                         std::make_move_iterator(imageData.begin()),
-                                         std::make_move_iterator(imageData.end()));
+    std::string commandOutput;
+    ConvertPDF::processFile(manualPath, "-convert", pageNum, width, height, commandOutput);
+    imageData.insert(imageData.end(), std::make_move_iterator(commandOutput.begin()),
+                     std::make_move_iterator(commandOutput.end()));
 #else
-        FILE* commandPipe;
-        std::array<char, 512> buffer {};
-        int returnValue;
+    FILE* commandPipe;
+    std::array<char, 512> buffer {};
+    int returnValue;
 
-        if (!(commandPipe = reinterpret_cast<FILE*>(popen(command.c_str(), "r")))) {
-            LOG(LogError) << "Couldn't open pipe to es-pdf-convert";
-            return;
-        }
+    if (!(commandPipe = reinterpret_cast<FILE*>(popen(command.c_str(), "r")))) {
+        LOG(LogError) << "Couldn't open pipe to es-pdf-convert";
+        return false;
+    }
 
-        while (fread(buffer.data(), 1, 512, commandPipe)) {
-            mPages[pageNum].imageData.insert(mPages[pageNum].imageData.end(),
-                                             std::make_move_iterator(buffer.begin()),
-                                             std::make_move_iterator(buffer.end()));
-        }
+    while (fread(buffer.data(), 1, 512, commandPipe)) {
+        imageData.insert(imageData.end(), std::make_move_iterator(buffer.begin()),
+                         std::make_move_iterator(buffer.end()));
+    }
 
-        returnValue = pclose(commandPipe);
+    returnValue = pclose(commandPipe);
 #endif
-        const size_t imageDataSize {mPages[pageNum].imageData.size()};
-#if defined(_WIN64)
-        if (!processReturnValue || (static_cast<int>(imageDataSize) <
-                                    mPages[pageNum].width * mPages[pageNum].height * 4)) {
-#elif defined(__ANDROID__)
-        if (static_cast<int>(imageDataSize) < mPages[pageNum].width * mPages[pageNum].height * 4) {
+    const size_t imageDataSize {imageData.size()};
+#if defined(_WIN64) || defined(__ANDROID__)
+    if (static_cast<int>(imageDataSize) < width * height * 4) {
 #else
-        if (returnValue != 0 || (static_cast<int>(imageDataSize) <
-                                 mPages[pageNum].width * mPages[pageNum].height * 4)) {
+    if (returnValue != 0 || (static_cast<int>(imageDataSize) < width * height * 4)) {
 #endif
-            LOG(LogError) << "Error reading PDF file";
-            mPages[pageNum].imageData.clear();
+        LOG(LogError) << "Error reading PDF file";
+        imageData.clear();
+        return false;
+    }
+
+#if (DEBUG_PDF_CONVERSION)
+    LOG(LogDebug) << "ABGR32 data stream size: " << imageDataSize;
+#endif
+    return true;
+}
+
+void PDFViewer::showPage(int pageNum)
+{
+    assert(pageNum <= static_cast<int>(mPages.size()));
+    const auto conversionStartTime {std::chrono::system_clock::now()};
+    mConversionTime = 0;
+
+    {
+        // Once the image data has been set it's not modified by the conversion thread, so
+        // it can be accessed without holding the lock.
+        std::unique_lock<std::mutex> lock {mConversionMutex};
+        if (mPages[pageNum].conversionFailed) {
+            mPageImage.reset();
+            mDisplayedPage = pageNum;
             return;
         }
+        if (mPages[pageNum].imageData.empty())
+            return;
     }
-    else {
+
 #if (DEBUG_PDF_CONVERSION)
-        LOG(LogDebug) << "Using cached texture for page: " << mCurrentPage;
+    LOG(LogDebug) << "Showing page: " << pageNum;
 #endif
-    }
+
+    mDisplayedPage = pageNum;
 
     mPageImage.reset();
     mPageImage = std::make_unique<ImageComponent>(false, false);
@@ -530,9 +783,6 @@ void PDFViewer::convertPage(int pageNum)
     mConversionTime = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
                                            std::chrono::system_clock::now() - conversionStartTime)
                                            .count());
-#if (DEBUG_PDF_CONVERSION)
-    LOG(LogDebug) << "ABGR32 data stream size: " << mPages[pageNum].imageData.size();
-#endif
 }
 
 void PDFViewer::input(InputConfig* config, Input input)
@@ -638,6 +888,9 @@ void PDFViewer::input(InputConfig* config, Input input)
 
 void PDFViewer::update(int deltaTime)
 {
+    if (mDisplayedPage != mCurrentPage)
+        showPage(mCurrentPage);
+
     if (mKeyRepeatLeftRight != 0) {
         // Limit the accumulated time if the computer can't keep up.
         mKeyRepeatTimer += (deltaTime < KEY_REPEAT_SPEED ? deltaTime : deltaTime - mConversionTime);
@@ -680,14 +933,15 @@ void PDFViewer::render(const glm::mat4& /*parentTrans*/)
     mRenderer->drawRect(0.0f, 0.0f, Renderer::getScreenWidth(), Renderer::getScreenHeight(),
                         0x000000FF, 0x000000FF);
 
-    if (mZoom != 1.0f)
-        mPageImage->setPosition(mPageImage->getPosition() + (mPanOffset * mZoom));
+    if (mPageImage != nullptr) {
+        if (mZoom != 1.0f)
+            mPageImage->setPosition(mPageImage->getPosition() + (mPanOffset * mZoom));
 
-    if (mPageImage != nullptr)
         mPageImage->render(trans);
 
-    if (mZoom != 1.0f)
-        mPageImage->setPosition(mPageImage->getPosition() - (mPanOffset * mZoom));
+        if (mZoom != 1.0f)
+            mPageImage->setPosition(mPageImage->getPosition() - (mPanOffset * mZoom));
+    }
 
     if (mHelpInfoPosition != HelpInfoPosition::DISABLED) {
         // Render a dark gray frame behind the help info.
@@ -729,7 +983,8 @@ void PDFViewer::showNextPage()
     NavigationSounds::getInstance().playThemeNavigationSound(SCROLLSOUND);
     ++mCurrentPage;
     mEntryNumText->setText("PAGE " + std::to_string(mCurrentPage) + " OF " + mEntryCount);
-    convertPage(mCurrentPage);
+    queuePages(1);
+    showPage(mCurrentPage);
 }
 
 void PDFViewer::showPreviousPage()
@@ -740,13 +995,14 @@ void PDFViewer::showPreviousPage()
     NavigationSounds::getInstance().playThemeNavigationSound(SCROLLSOUND);
     --mCurrentPage;
     mEntryNumText->setText("PAGE " + std::to_string(mCurrentPage) + " OF " + mEntryCount);
-    convertPage(mCurrentPage);
+    queuePages(-1);
+    showPage(mCurrentPage);
 }
 
 void PDFViewer::navigateUp()
 {
     if (mZoom != 1.0f) {
-        if (mPanOffset.y * mZoom <= mPageImage->getSize().y / 2.0f)
+        if (mPageImage != nullptr && mPanOffset.y * mZoom <= mPageImage->getSize().y / 2.0f)
             mPanOffset.y += mPanAmount;
     }
 }
@@ -754,7 +1010,7 @@ void PDFViewer::navigateUp()
 void PDFViewer::navigateDown()
 {
     if (mZoom != 1.0f) {
-        if (mPanOffset.y * mZoom >= -(mPageImage->getSize().y / 2.0f))
+        if (mPageImage != nullptr && mPanOffset.y * mZoom >= -(mPageImage->getSize().y / 2.0f))
             mPanOffset.y -= mPanAmount;
     }
     else {
@@ -765,7 +1021,7 @@ void PDFViewer::navigateDown()
 void PDFViewer::navigateLeft()
 {
     if (mZoom != 1.0f) {
-        if (mPanOffset.x * mZoom <= mPageImage->getSize().x / 2.0f)
+        if (mPageImage != nullptr && mPanOffset.x * mZoom <= mPageImage->getSize().x / 2.0f)
             mPanOffset.x += mPanAmount;
     }
     else {
@@ -777,7 +1033,7 @@ void PDFViewer::navigateLeft()
 void PDFViewer::navigateRight()
 {
     if (mZoom != 1.0f) {
-        if (mPanOffset.x * mZoom > -(mPageImage->getSize().x / 2.0f))
+        if (mPageImage != nullptr && mPanOffset.x * mZoom > -(mPageImage->getSize().x / 2.0f))
             mPanOffset.x -= mPanAmount;
     }
     else {
@@ -794,7 +1050,7 @@ void PDFViewer::navigateRightShoulder()
     if (mZoom == 1.5f)
         mHelp->setPrompts(getHelpPrompts());
 
-    convertPage(mCurrentPage);
+    showPage(mCurrentPage);
 }
 
 void PDFViewer::navigateLeftShoulder()
@@ -808,7 +1064,7 @@ void PDFViewer::navigateLeftShoulder()
     if (mZoom == 1.0f)
         mHelp->setPrompts(getHelpPrompts());
 
-    convertPage(mCurrentPage);
+    showPage(mCurrentPage);
 }
 
 void PDFViewer::navigateLeftTrigger()
@@ -817,7 +1073,7 @@ void PDFViewer::navigateLeftTrigger()
         mZoom = 1.0f;
         mPanOffset = {0.0f, 0.0f, 0.0f};
         mHelp->setPrompts(getHelpPrompts());
-        convertPage(mCurrentPage);
+        showPage(mCurrentPage);
         return;
     }
 
@@ -829,7 +1085,8 @@ void PDFViewer::navigateLeftTrigger()
     NavigationSounds::getInstance().playThemeNavigationSound(SCROLLSOUND);
     mCurrentPage = 1;
     mEntryNumText->setText("PAGE " + std::to_string(mCurrentPage) + " OF " + mEntryCount);
-    convertPage(mCurrentPage);
+    queuePages(1);
+    showPage(mCurrentPage);
 }
 
 void PDFViewer::navigateRightTrigger()
@@ -838,7 +1095,7 @@ void PDFViewer::navigateRightTrigger()
         mZoom = 1.0f;
         mPanOffset = {0.0f, 0.0f, 0.0f};
         mHelp->setPrompts(getHelpPrompts());
-        convertPage(mCurrentPage);
+        showPage(mCurrentPage);
         return;
     }
 
@@ -850,5 +1107,6 @@ void PDFViewer::navigateRightTrigger()
     NavigationSounds::getInstance().playThemeNavigationSound(SCROLLSOUND);
     mCurrentPage = mPageCount;
     mEntryNumText->setText("PAGE " + std::to_string(mCurrentPage) + " OF " + mEntryCount);
-    convertPage(mCurrentPage);
+    queuePages(-1);
+    showPage(mCurrentPage);
 }
@@ -4,6 +4,8 @@
 //  PDFViewer.h
 //
 //  Parses and renders pages using the Poppler library via the external es-pdf-convert binary.
+//  Pages are converted by a background thread which also prefetches the pages following the
+//  current page in the direction of travel, and converted pages are kept in an on-disk cache.
 //
 
 #ifndef ES_APP_PDF_VIEWER_H
@@ -15,17 +17,25 @@
 #include "components/ImageComponent.h"
 #include "components/TextComponent.h"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 class PDFViewer : public Window::PDFViewer
 {
 public:
     PDFViewer();
+    ~PDFViewer();
 
     bool startPDFViewer(FileData* game) override;
     void stopPDFViewer() override;
     void launchMediaViewer() override;
 
     bool getDocumentInfo();
-    void convertPage(int pageNum);
+    // Shows the page if it has been converted, otherwise this is done by update() once the
+    // conversion thread has finished converting it.
+    void showPage(int pageNum);
 
     void input(InputConfig* config, Input input) override;
     void update(int deltaTime) override;
@@ -39,6 +49,17 @@ public:
     };
 
 private:
+    // Replaces the conversion queue with the current page followed by its neighbouring pages,
+    // with direction being 1 when browsing forward and -1 when browsing backward.
+    void queuePages(int direction);
+    void conversionThread(const std::string esConvertPath, const std::string manualPath);
+    static bool convertPage(const std::string& esConvertPath,
+                            const std::string& manualPath,
+                            int pageNum,
+                            int width,
+                            int height,
+                            std::vector<char>& imageData);
+
     void showNextPage();
     void showPreviousPage();
 
@@ -57,6 +78,7 @@ private:
         float height;
         std::string orientation;
         std::vector<char> imageData;
+        bool conversionFailed;
     };
 
     Renderer* mRenderer;
@@ -65,6 +87,7 @@ private:
     float mFrameHeight;
     float mScaleFactor;
     int mCurrentPage;
+    int mDisplayedPage;
     int mPageCount;
     float mZoom;
     float mPanAmount;
@@ -82,6 +105,14 @@ private:
     std::unique_ptr<ImageComponent> mPageImage;
     std::map<int, PageEntry> mPages;
 
+    // Guards mPages, the conversion queue and the conversion thread state.
+    std::mutex mConversionMutex;
+    std::condition_variable mConversionCondition;
+    std::unique_ptr<std::thread> mConversionThread;
+    std::deque<int> mConversionQueue;
+    int mConvertingPage;
+    bool mStopConversion;
+
     std::unique_ptr<HelpComponent> mHelp;
     std::unique_ptr<TextComponent> mEntryNumText;
     std::string mEntryCount;
@@ -0,0 +1,162 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  ROMDirectoryIndex.cpp
+//
+//  Persistent index of the game system directories, used by SystemData to avoid
+//  scanning directories which have not been modified since the previous startup.
+//  The index is stored per system in a binary file in the application data directory.
+//
+
+#include "ROMDirectoryIndex.h"
+
+#include "Log.h"
+#include "utils/CacheFileUtil.h"
+#include "utils/FileSystemUtil.h"
+
+namespace
+{
+    const std::string indexFileMagic {"ESDEROMI"};
+    const unsigned int indexFileVersion {1};
+
+    enum EntryFlags : unsigned char {
+        DIRECTORY = 0x01,
+        SYMLINK = 0x02,
+        HIDDEN = 0x04
+    };
+} // namespace
+
+ROMDirectoryIndex::ROMDirectoryIndex(const std::string& systemName,
+                                     const std::string& startPath,
+                                     bool persistent)
+    : mStartPath {startPath}
+    , mPersistent {persistent}
+    , mCachedDirCount {0}
+    , mScannedDirCount {0}
+{
+    mIndexPath =
+        Utils::FileSystem::getAppDataDirectory() + "/cache/romindex/" + systemName + ".bin";
+
+    if (mPersistent)
+        loadIndex();
+}
+
+const std::vector<ROMDirectoryIndex::Entry>& ROMDirectoryIndex::getDirContent(
+    const std::string& path)
+{
+    const long long modTime {Utils::FileSystem::getModificationTime(path)};
+    auto dirIt = mDirectories.find(path);
+
+    if (modTime != -1 && dirIt != mDirectories.end() && dirIt->second.modTime == modTime) {
+        ++mCachedDirCount;
+        dirIt->second.accessed = true;
+        for (auto& entry : dirIt->second.entries) {
+            if (entry.isSymlink)
+                entry.isDirectory = Utils::FileSystem::isDirectory(entry.path);
+        }
+        return dirIt->second.entries;
+    }
+
+    ++mScannedDirCount;
+    Directory& directory {mDirectories[path]};
+    directory.modTime = modTime;
+    directory.accessed = true;
+    directory.entries.clear();
+
+    for (auto& entryPath : Utils::FileSystem::getDirContent(path)) {
+        directory.entries.emplace_back(Entry {entryPath, Utils::FileSystem::isDirectory(entryPath),
+                                              Utils::FileSystem::isSymlink(entryPath),
+                                              Utils::FileSystem::isHidden(entryPath)});
+    }
+
+    return directory.entries;
+}
+
+void ROMDirectoryIndex::loadIndex()
+{
+    if (!Utils::FileSystem::exists(mIndexPath))
+        return;
+
+    Utils::CacheFile::Reader reader {mIndexPath, indexFileMagic, indexFileVersion};
+    if (!reader.isValid() || reader.readString() != mStartPath)
+        return;
+
+    const unsigned int dirCount {reader.read<unsigned int>()};
+
+    for (unsigned int i {0}; i < dirCount && reader.isValid(); ++i) {
+        const std::string dirPath {mStartPath + reader.readString()};
+        Directory directory;
+        directory.modTime = reader.read<long long>();
+        directory.accessed = false;
+        const unsigned int entryCount {reader.read<unsigned int>()};
+        for (unsigned int j {0}; j < entryCount && reader.isValid(); ++j) {
+            const std::string name {reader.readString()};
+            const unsigned char flags {reader.read<unsigned char>()};
+            directory.entries.emplace_back(Entry {dirPath + "/" + name, (flags & DIRECTORY) != 0,
+                                                  (flags & SYMLINK) != 0, (flags & HIDDEN) != 0});
+        }
+        mDirectories[dirPath] = std::move(directory);
+    }
+
+    if (!reader.isValid()) {
+        LOG(LogWarning) << "ROMDirectoryIndex: Index file \"" << mIndexPath
+                        << "\" is corrupt, the system directory will be rescanned";
+        mDirectories.clear();
+    }
+}
+
+void ROMDirectoryIndex::saveIndex()
+{
+    if (!mPersistent)
+        return;
+
+    bool dropDirectories {false};
+    for (auto& directory : mDirectories) {
+        if (!directory.second.accessed) {
+            dropDirectories = true;
+            break;
+        }
+    }
+
+    if (mScannedDirCount == 0 && !dropDirectories)
+        return;
+
+    Utils::CacheFile::Writer writer {mIndexPath, indexFileMagic, indexFileVersion};
+
+    // Directories are stored relative to the system start path, which should always be the
+    // case but it's better to skip any directories that for whatever reason are not.
+    auto includeFunc = [this](const std::pair<const std::string, Directory>& directory) {
+        return directory.second.accessed && directory.first.find(mStartPath) == 0;
+    };
+
+    unsigned int dirCount {0};
+    for (auto& directory : mDirectories) {
+        if (includeFunc(directory))
+            ++dirCount;
+    }
+
+    writer.writeString(mStartPath);
+    writer.write<unsigned int>(dirCount);
+
+    for (auto& directory : mDirectories) {
+        if (!includeFunc(directory))
+            continue;
+        writer.writeString(directory.first.substr(mStartPath.size()));
+        writer.write<long long>(directory.second.modTime);
+        writer.write<unsigned int>(static_cast<unsigned int>(directory.second.entries.size()));
+        for (auto& entry : directory.second.entries) {
+            unsigned char flags {0};
+            if (entry.isDirectory)
+                flags |= DIRECTORY;
+            if (entry.isSymlink)
+                flags |= SYMLINK;
+            if (entry.isHidden)
+                flags |= HIDDEN;
+            writer.writeString(Utils::FileSystem::getFileName(entry.path));
+            writer.write<unsigned char>(flags);
+        }
+    }
+
+    if (writer.commit() == -1)
+        LOG(LogWarning) << "ROMDirectoryIndex: Couldn't write index file \"" << mIndexPath << "\"";
+}
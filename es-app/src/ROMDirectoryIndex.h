@@ -0,0 +1,64 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  ROMDirectoryIndex.h
+//
+//  Persistent index of the game system directories, used by SystemData to avoid
+//  scanning directories which have not been modified since the previous startup.
+//  The index is stored per system in a binary file in the application data directory.
+//
+
+#ifndef ES_APP_ROM_DIRECTORY_INDEX_H
+#define ES_APP_ROM_DIRECTORY_INDEX_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class ROMDirectoryIndex
+{
+public:
+    struct Entry {
+        std::string path;
+        bool isDirectory;
+        bool isSymlink;
+        bool isHidden;
+    };
+
+    // If persistent is set to false then no index file is read or written, meaning all
+    // directories will be scanned.
+    ROMDirectoryIndex(const std::string& systemName,
+                      const std::string& startPath,
+                      bool persistent);
+
+    // Returns the sorted content of a directory. If the directory modification time is
+    // identical to when the index was written then the cached content is returned, otherwise
+    // the directory is scanned. Symlinks are always checked as their targets may have changed.
+    const std::vector<Entry>& getDirContent(const std::string& path);
+
+    // Writes the index file if anything was rescanned. Directories that were not requested
+    // during this session are dropped from the index.
+    void saveIndex();
+
+    unsigned int getCachedDirCount() const { return mCachedDirCount; }
+    unsigned int getScannedDirCount() const { return mScannedDirCount; }
+
+private:
+    struct Directory {
+        long long modTime;
+        std::vector<Entry> entries;
+        bool accessed;
+    };
+
+    void loadIndex();
+
+    std::unordered_map<std::string, Directory> mDirectories;
+    std::string mIndexPath;
+    std::string mStartPath;
+    bool mPersistent;
+
+    unsigned int mCachedDirCount;
+    unsigned int mScannedDirCount;
+};
+
+#endif // ES_APP_ROM_DIRECTORY_INDEX_H
@@ -0,0 +1,327 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  ROMHashDatabase.cpp
+//
+//  Persistent database of game file hashes, used by the scraper for file hash searches.
+//  Entries are keyed by the file path and are only valid as long as the file size and
+//  modification time are unchanged. The MD5, CRC32 and SHA1 digests are calculated in a
+//  single pass over the file, either on demand or ahead of time by a low priority
+//  background thread when starting the multi-scraper.
+//
+
+#include "ROMHashDatabase.h"
+
+#include "Log.h"
+#include "Settings.h"
+#include "utils/CacheFileUtil.h"
+#include "utils/FileSystemUtil.h"
+#include "utils/MathUtil.h"
+#include "utils/StringUtil.h"
+
+#include <chrono>
+#include <cstdio>
+
+#if defined(_WIN64)
+#include <windows.h>
+#elif defined(__linux__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+    const std::string indexFileMagic {"ESDEHASH"};
+    const unsigned int indexFileVersion {1};
+
+    // Large sequential reads are much faster than the small chunks previously used for the
+    // MD5 calculation, especially for optical disc images on mechanical drives.
+    const size_t readChunkSize {4 * 1024 * 1024};
+
+    void lowerThreadPriority()
+    {
+#if defined(_WIN64)
+        // Background mode also lowers the I/O priority of the thread.
+        SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+#elif defined(__APPLE__)
+        setpriority(PRIO_DARWIN_THREAD, 0, PRIO_DARWIN_BG);
+#elif defined(__linux__)
+        // On Linux the nice value is a per-thread attribute.
+        setpriority(PRIO_PROCESS, 0, 19);
+#endif
+    }
+} // namespace
+
+ROMHashDatabase::ROMHashDatabase()
+    : mHashingThreadRunning {false}
+    , mStopHashing {false}
+    , mForegroundCount {0}
+    , mLoaded {false}
+    , mModified {false}
+{
+    mIndexPath = Utils::FileSystem::getAppDataDirectory() + "/cache/romhashes.bin";
+}
+
+ROMHashDatabase::~ROMHashDatabase() { stopHashing(); }
+
+ROMHashDatabase& ROMHashDatabase::getInstance()
+{
+    static ROMHashDatabase instance;
+    return instance;
+}
+
+ROMHashDatabase::Hashes ROMHashDatabase::getHashes(const std::string& path)
+{
+    Hashes hashes;
+
+    if (!Settings::getInstance()->getBool("ROMHashDatabase")) {
+        hashFile(path, hashes, false);
+        return hashes;
+    }
+
+    const long long fileSize {Utils::FileSystem::getFileSize(path)};
+    const long long modTime {Utils::FileSystem::getModificationTime(path)};
+
+    std::unique_lock<std::mutex> lock {mMutex};
+
+    if (!mLoaded)
+        loadIndex();
+
+    mInProgressCondition.wait(lock, [this, &path] { return mInProgressPath != path; });
+
+    auto entryIt = mEntries.find(path);
+    if (entryIt != mEntries.end() && entryIt->second.fileSize == fileSize &&
+        entryIt->second.modTime == modTime) {
+        LOG(LogDebug) << "ROMHashDatabase::getHashes(): Using stored hashes for \"" << path
+                      << "\"";
+        return entryIt->second.hashes;
+    }
+
+    lock.unlock();
+
+    ++mForegroundCount;
+    const bool success {hashFile(path, hashes, false)};
+    --mForegroundCount;
+
+    if (success) {
+        lock.lock();
+        mEntries[path] = Entry {fileSize, modTime, hashes};
+        mModified = true;
+    }
+
+    return hashes;
+}
+
+void ROMHashDatabase::queueFiles(const std::vector<std::string>& paths)
+{
+    if (paths.empty() || !Settings::getInstance()->getBool("ROMHashDatabase"))
+        return;
+
+    std::unique_lock<std::mutex> lock {mMutex};
+
+    if (!mLoaded)
+        loadIndex();
+
+    for (auto& path : paths)
+        mQueue.emplace_back(path);
+
+    // The thread clears this flag while holding the mutex, so any files added here will
+    // either be picked up by the running thread or by the new thread started below.
+    const bool startThread {!mHashingThreadRunning};
+    mHashingThreadRunning = true;
+    lock.unlock();
+
+    if (startThread) {
+        if (mHashingThread) {
+            mHashingThread->join();
+            mHashingThread.reset();
+        }
+        LOG(LogDebug) << "ROMHashDatabase::queueFiles(): Starting background hashing of "
+                      << paths.size() << " files";
+        mStopHashing = false;
+        mHashingThread = std::make_unique<std::thread>(&ROMHashDatabase::hashingThread, this);
+    }
+}
+
+void ROMHashDatabase::stopHashing()
+{
+    if (!mHashingThread)
+        return;
+
+    mStopHashing = true;
+
+    std::unique_lock<std::mutex> lock {mMutex};
+    mQueue.clear();
+    lock.unlock();
+
+    mHashingThread->join();
+    mHashingThread.reset();
+    mStopHashing = false;
+}
+
+void ROMHashDatabase::loadIndex()
+{
+    mLoaded = true;
+
+    if (!Utils::FileSystem::exists(mIndexPath))
+        return;
+
+    Utils::CacheFile::Reader reader {mIndexPath, indexFileMagic, indexFileVersion};
+    if (!reader.isValid())
+        return;
+
+    const unsigned int entryCount {reader.read<unsigned int>()};
+
+    for (unsigned int i {0}; i < entryCount && reader.isValid(); ++i) {
+        const std::string path {reader.readString()};
+        Entry entry;
+        entry.fileSize = reader.read<long long>();
+        entry.modTime = reader.read<long long>();
+        entry.hashes.md5 = reader.readString();
+        entry.hashes.crc32 = reader.readString();
+        entry.hashes.sha1 = reader.readString();
+        mEntries[path] = std::move(entry);
+    }
+
+    if (!reader.isValid()) {
+        LOG(LogWarning) << "ROMHashDatabase: Index file \"" << mIndexPath
+                        << "\" is corrupt, all files will be hashed again";
+        mEntries.clear();
+    }
+}
+
+void ROMHashDatabase::saveIndex()
+{
+    std::unique_lock<std::mutex> lock {mMutex};
+
+    if (!mModified)
+        return;
+
+    Utils::CacheFile::Writer writer {mIndexPath, indexFileMagic, indexFileVersion};
+    writer.write<unsigned int>(static_cast<unsigned int>(mEntries.size()));
+
+    for (auto& entry : mEntries) {
+        writer.writeString(entry.first);
+        writer.write<long long>(entry.second.fileSize);
+        writer.write<long long>(entry.second.modTime);
+        writer.writeString(entry.second.hashes.md5);
+        writer.writeString(entry.second.hashes.crc32);
+        writer.writeString(entry.second.hashes.sha1);
+    }
+
+    if (writer.commit() == -1)
+        LOG(LogWarning) << "ROMHashDatabase: Couldn't write index file \"" << mIndexPath << "\"";
+    else
+        mModified = false;
+}
+
+bool ROMHashDatabase::hashFile(const std::string& path, Hashes& hashes, bool background)
+{
+    if (Utils::FileSystem::isDirectory(path))
+        return false;
+
+#if defined(_WIN64)
+    FILE* file {_wfopen(Utils::String::stringToWideString(path).c_str(), L"rb")};
+#else
+    FILE* file {fopen(path.c_str(), "rb")};
+#endif
+    if (file == nullptr)
+        return false;
+
+#if defined(__linux__)
+    posix_fadvise(fileno(file), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    unsigned char md5Buffer[64] {};
+    unsigned int md5Count[2] {};
+    unsigned int md5State[4] {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476};
+
+    unsigned char sha1Buffer[64] {};
+    unsigned long long sha1Count;
+    unsigned int sha1State[5];
+    Utils::Math::sha1Init(sha1State, sha1Count);
+
+    unsigned int crc32 {0};
+
+    std::vector<unsigned char> chunk(readChunkSize);
+    size_t bytesRead {0};
+    size_t totalBytesRead {0};
+
+    while ((bytesRead = fread(&chunk[0], 1, readChunkSize, file)) > 0) {
+        if (background) {
+            // Give way to any on demand hashing as the scraper is waiting for these files.
+            while (mForegroundCount > 0 && !mStopHashing)
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            if (mStopHashing) {
+                fclose(file);
+                return false;
+            }
+        }
+        Utils::Math::md5Update(&chunk[0], static_cast<unsigned int>(bytesRead), md5State,
+                               md5Count, md5Buffer);
+        Utils::Math::sha1Update(&chunk[0], bytesRead, sha1State, sha1Count, sha1Buffer);
+        crc32 = Utils::Math::crc32Update(crc32, &chunk[0], bytesRead);
+        totalBytesRead += bytesRead;
+    }
+
+    const bool readError {ferror(file) != 0};
+    fclose(file);
+
+    // As for Utils::Math::md5Hash(), no hashes are returned for empty files.
+    if (readError || totalBytesRead == 0)
+        return false;
+
+    char crc32String[9];
+    snprintf(crc32String, 9, "%08x", crc32);
+
+    hashes.md5 = Utils::Math::md5Final(md5State, md5Count, md5Buffer);
+    hashes.crc32 = crc32String;
+    hashes.sha1 = Utils::Math::sha1Final(sha1State, sha1Count, sha1Buffer);
+
+    return true;
+}
+
+void ROMHashDatabase::hashingThread()
+{
+    lowerThreadPriority();
+
+    unsigned int hashedFiles {0};
+
+    while (true) {
+        std::unique_lock<std::mutex> lock {mMutex};
+        if (mQueue.empty() || mStopHashing) {
+            mHashingThreadRunning = false;
+            break;
+        }
+        const std::string path {mQueue.front()};
+        mQueue.pop_front();
+        lock.unlock();
+
+        const long long fileSize {Utils::FileSystem::getFileSize(path)};
+        const long long modTime {Utils::FileSystem::getModificationTime(path)};
+
+        lock.lock();
+        auto entryIt = mEntries.find(path);
+        if (entryIt != mEntries.end() && entryIt->second.fileSize == fileSize &&
+            entryIt->second.modTime == modTime)
+            continue;
+        mInProgressPath = path;
+        lock.unlock();
+
+        Hashes hashes;
+        const bool success {hashFile(path, hashes, true)};
+
+        lock.lock();
+        if (success) {
+            mEntries[path] = Entry {fileSize, modTime, hashes};
+            mModified = true;
+            ++hashedFiles;
+        }
+        mInProgressPath = "";
+        lock.unlock();
+        mInProgressCondition.notify_all();
+    }
+
+    LOG(LogDebug) << "ROMHashDatabase::hashingThread(): Hashed " << hashedFiles
+                  << " files in the background";
+}
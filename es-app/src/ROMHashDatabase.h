@@ -0,0 +1,82 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  ROMHashDatabase.h
+//
+//  Persistent database of game file hashes, used by the scraper for file hash searches.
+//  Entries are keyed by the file path and are only valid as long as the file size and
+//  modification time are unchanged. The MD5, CRC32 and SHA1 digests are calculated in a
+//  single pass over the file, either on demand or ahead of time by a low priority
+//  background thread when starting the multi-scraper.
+//
+
+#ifndef ES_APP_ROM_HASH_DATABASE_H
+#define ES_APP_ROM_HASH_DATABASE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class ROMHashDatabase
+{
+public:
+    struct Hashes {
+        std::string md5;
+        std::string crc32;
+        std::string sha1;
+    };
+
+    static ROMHashDatabase& getInstance();
+
+    // Returns the stored hashes if the file has not been modified, otherwise the file is
+    // hashed in the calling thread. If the background thread is currently hashing the file
+    // then we wait for it to finish instead. Returns empty hashes if the file can't be read.
+    Hashes getHashes(const std::string& path);
+
+    // Adds files to the background hashing queue, files with valid entries are skipped.
+    void queueFiles(const std::vector<std::string>& paths);
+    // Clears the queue and waits for the background thread to exit.
+    void stopHashing();
+
+    // Writes the index file if there have been any changes.
+    void saveIndex();
+
+private:
+    struct Entry {
+        long long fileSize;
+        long long modTime;
+        Hashes hashes;
+    };
+
+    ROMHashDatabase();
+    ~ROMHashDatabase();
+
+    void loadIndex();
+    // Returns false if the file could not be read or if background hashing was stopped.
+    bool hashFile(const std::string& path, Hashes& hashes, bool background);
+    void hashingThread();
+
+    std::unordered_map<std::string, Entry> mEntries;
+    std::deque<std::string> mQueue;
+    std::string mInProgressPath;
+    std::mutex mMutex;
+    std::condition_variable mInProgressCondition;
+
+    std::unique_ptr<std::thread> mHashingThread;
+    std::atomic<bool> mHashingThreadRunning;
+    std::atomic<bool> mStopHashing;
+    // Background hashing is paused while any files are hashed on demand.
+    std::atomic<int> mForegroundCount;
+
+    std::string mIndexPath;
+    bool mLoaded;
+    bool mModified;
+};
+
+#endif // ES_APP_ROM_HASH_DATABASE_H
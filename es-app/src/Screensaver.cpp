@@ -10,17 +10,19 @@
 #include "Screensaver.h"
 
 #include "FileData.h"
+#include "FileFilterIndex.h"
 #include "Log.h"
 #include "SystemData.h"
 #include "UIModeController.h"
 #include "components/VideoFFmpegComponent.h"
 #include "resources/Font.h"
+#include "resources/TextureResource.h"
 #include "utils/FileSystemUtil.h"
 #include "utils/StringUtil.h"
 #include "views/GamelistView.h"
 #include "views/ViewController.h"
 
-#include <random>
+#include <algorithm>
 #include <time.h>
 
 #if defined(_WIN64)
@@ -32,16 +34,24 @@
 Screensaver::Screensaver()
     : mRenderer {Renderer::getInstance()}
     , mWindow {Window::getInstance()}
+    , mInventoryGeneration {0}
+    , mInventoryFavoritesOnly {false}
+    , mInventoryKidMode {false}
+    , mInventoryFiltered {false}
+    , mCustomImageDirModTime {0}
+    , mCustomImageRecurse {false}
+    , mNextGame {nullptr}
+    , mRandomEngine {std::random_device {}()}
     , mImageScreensaver {nullptr}
     , mVideoScreensaver {nullptr}
     , mCurrentGame {nullptr}
-    , mPreviousGame {nullptr}
     , mTimer {0}
     , mMediaSwapTime {0}
     , mScreensaverActive {false}
     , mTriggerNextGame {false}
     , mHasMediaFiles {false}
     , mFallbackScreensaver {false}
+    , mSwitchingGame {false}
     , mOpacity {0.0f}
     , mDimValue {1.0}
     , mRectangleFadeIn {50}
@@ -51,6 +61,8 @@ Screensaver::Screensaver()
     mWindow->setScreensaver(this);
 }
 
+Screensaver::~Screensaver() { VideoFFmpegComponent::cancelPrefetch(); }
+
 void Screensaver::startScreensaver(bool generateMediaList)
 {
     ViewController::getInstance()->pauseViewVideos();
@@ -74,59 +86,39 @@ void Screensaver::startScreensaver(bool generateMediaList)
         mGameOverlayFont.push_back(Font::get(FONT_SIZE_LARGE));
     }
 
-    // Set mPreviousGame which will be used to avoid showing the same game again during
-    // the random selection.
-    if ((mScreensaverType == "slideshow" || mScreensaverType == "video") && mCurrentGame != nullptr)
-        mPreviousGame = mCurrentGame;
-
     if (mScreensaverType == "slideshow") {
-        if (generateMediaList) {
-            mImageFiles.clear();
-            mFilesInventory.clear();
-            mImageCustomFiles.clear();
-            mCustomFilesInventory.clear();
-        }
-
         mMediaSwapTime = Settings::getInstance()->getInt("ScreensaverSwapImageTimeout");
 
         // Load a random image.
         if (Settings::getInstance()->getBool("ScreensaverSlideshowCustomImages")) {
             if (generateMediaList)
-                generateCustomImageList();
-            pickRandomCustomImage(path);
-
-            // We've cycled through all games, so start from the beginning again.
-            if (mImageCustomFiles.size() == 0 && mCustomFilesInventory.size() > 0)
-                mImageCustomFiles.insert(mImageCustomFiles.begin(), mCustomFilesInventory.begin(),
-                                         mCustomFilesInventory.end());
-
-            if (mImageCustomFiles.size() > 0)
-                mHasMediaFiles = true;
+                updateCustomImageInventory();
+            path = pickRandomCustomImage();
+            mPreviousCustomImage = path;
+            mGameName = "";
+            mSystemName = "";
             // Custom images are not tied to the game list.
             mCurrentGame = nullptr;
         }
         else {
-            if (generateMediaList)
-                generateImageList();
-            pickRandomImage(path);
+            if (generateMediaList || mInventoryGeneration != FileData::getGameGeneration())
+                updateInventory();
+            mCurrentGame = pickRandomGame(path);
         }
 
-        // We've cycled through all games, so start from the beginning again.
-        if (mImageFiles.size() == 0 && mFilesInventory.size() > 0)
-            mImageFiles.insert(mImageFiles.begin(), mFilesInventory.begin(), mFilesInventory.end());
-
-        if (mImageFiles.size() > 0)
+        if (path != "")
             mHasMediaFiles = true;
 
         // Don't attempt to render the screensaver if there are no images available, but
         // do flag it as running. This way render() will fade to a black screen, i.e. it
         // will activate the 'Black' screensaver type.
-        if (mImageFiles.size() > 0 || mImageCustomFiles.size() > 0) {
+        if (mHasMediaFiles) {
             if (Settings::getInstance()->getBool("ScreensaverSlideshowGameInfo"))
                 generateOverlayInfo();
 
+            // The image needs to be dynamically loaded for the prefetching to work.
             if (!mImageScreensaver)
-                mImageScreensaver = std::make_unique<ImageComponent>(false, false);
+                mImageScreensaver = std::make_unique<ImageComponent>(false, true);
 
             mTimer = 0;
 
@@ -141,28 +133,22 @@ void Screensaver::startScreensaver(bool generateMediaList)
             else
                 mImageScreensaver->setMaxSize(Renderer::getScreenWidth(),
                                               Renderer::getScreenHeight());
+
+            prefetchNext();
         }
         mTimer = 0;
         return;
     }
     else if (!mVideoScreensaver && (mScreensaverType == "video")) {
-        if (generateMediaList) {
-            mVideoFiles.clear();
-            mFilesInventory.clear();
-        }
-
         mMediaSwapTime = Settings::getInstance()->getInt("ScreensaverSwapVideoTimeout");
 
-        // Load a random video.
-        if (generateMediaList)
-            generateVideoList();
-        pickRandomVideo(path);
+        if (generateMediaList || mInventoryGeneration != FileData::getGameGeneration())
+            updateInventory();
 
-        // We've cycled through all games, so start from the beginning again.
-        if (mVideoFiles.size() == 0 && mFilesInventory.size() > 0)
-            mVideoFiles.insert(mVideoFiles.begin(), mFilesInventory.begin(), mFilesInventory.end());
+        // Load a random video.
+        mCurrentGame = pickRandomGame(path);
 
-        if (mVideoFiles.size() > 0)
+        if (path != "")
             mHasMediaFiles = true;
 
         if (!path.empty() && Utils::FileSystem::exists(path)) {
@@ -184,6 +170,7 @@ void Screensaver::startScreensaver(bool generateMediaList)
             mVideoScreensaver->setVideo(path);
             mVideoScreensaver->setScreensaverMode(true);
             mVideoScreensaver->startVideoPlayer();
+            prefetchNext();
             mTimer = 0;
             return;
         }
@@ -197,6 +184,13 @@ void Screensaver::stopScreensaver()
     mImageScreensaver.reset();
     mVideoScreensaver.reset();
 
+    // The next entry is kept for when the screensaver starts again, but there is no point in
+    // keeping the video file open until then.
+    if (!mSwitchingGame) {
+        VideoFFmpegComponent::cancelPrefetch();
+        mNextVideoPath = "";
+    }
+
     mScreensaverActive = false;
     mDimValue = 1.0f;
     mRectangleFadeIn = 50;
@@ -211,8 +205,10 @@ void Screensaver::stopScreensaver()
 
 void Screensaver::nextGame()
 {
+    mSwitchingGame = true;
     stopScreensaver();
     startScreensaver(false);
+    mSwitchingGame = false;
 }
 
 void Screensaver::launchGame()
@@ -237,10 +233,13 @@ void Screensaver::launchGame()
         // Launching game
         ViewController::getInstance()->triggerGameLaunch(mCurrentGame);
         ViewController::getInstance()->goToGamelist(mCurrentGame->getSystem());
-        GamelistView* view {
-            ViewController::getInstance()->getGamelistView(mCurrentGame->getSystem()).get()};
-        view->setCursor(selectGame);
-        view->stopListScrolling();
+        GamelistView* view {ViewController::getInstance()
+                                ->getGamelistViewIfExists(mCurrentGame->getSystem())
+                                .get()};
+        if (view != nullptr) {
+            view->setCursor(selectGame);
+            view->stopListScrolling();
+        }
         ViewController::getInstance()->cancelViewTransitions();
         ViewController::getInstance()->pauseViewVideos();
     }
@@ -263,10 +262,13 @@ void Screensaver::goToGame()
 
         // Go to the game in the gamelist view, but don't launch it.
         ViewController::getInstance()->goToGamelist(mCurrentGame->getSystem());
-        GamelistView* view {
-            ViewController::getInstance()->getGamelistView(mCurrentGame->getSystem()).get()};
-        view->setCursor(mCurrentGame);
-        view->stopListScrolling();
+        GamelistView* view {ViewController::getInstance()
+                                ->getGamelistViewIfExists(mCurrentGame->getSystem())
+                                .get()};
+        if (view != nullptr) {
+            view->setCursor(mCurrentGame);
+            view->stopListScrolling();
+        }
         ViewController::getInstance()->cancelViewTransitions();
     }
 }
@@ -403,41 +405,73 @@ void Screensaver::update(int deltaTime)
             mOpacity = 1.0f;
     }
 
-    if (mVideoScreensaver)
+    if (mVideoScreensaver) {
         mVideoScreensaver->update(deltaTime);
+        // Only a single video can be prefetched, so we need to wait until the current video
+        // has been started as it may be using the previously prefetched file.
+        if (mNextVideoPath != "" && mVideoScreensaver->isPlaying()) {
+            VideoFFmpegComponent::prefetchVideo(mNextVideoPath);
+            mNextVideoPath = "";
+        }
+    }
 }
 
-void Screensaver::generateImageList()
+void Screensaver::onFileChanged(FileData* file)
 {
-    const bool favoritesOnly {
-        Settings::getInstance()->getBool("ScreensaverSlideshowOnlyFavorites")};
+    // Nothing to update if the inventory has not been generated yet.
+    if (mInventoryType == "" || file->getType() != GAME || file->getSystem()->isCollection())
+        return;
+
+    std::string path;
+    if (getMediaPath(file, path)) {
+        // The game may still have a shuffle bag entry from before it was removed from the
+        // inventory, in which case it must not be added twice.
+        if (mInventory.insert(file).second &&
+            std::find(mShuffleBag.cbegin(), mShuffleBag.cend(), file) == mShuffleBag.cend())
+            mShuffleBag.emplace_back(file);
+    }
+    else {
+        // Any shuffle bag entry for the game is skipped when it's picked.
+        mInventory.erase(file);
+    }
+}
 
+void Screensaver::updateInventory()
+{
+    const bool favoritesOnly {Settings::getInstance()->getBool(
+        mScreensaverType == "video" ? "ScreensaverVideoOnlyFavorites" :
+                                      "ScreensaverSlideshowOnlyFavorites")};
+    const bool kidMode {UIModeController::getInstance()->isUIModeKid()};
+
+    bool filtered {false};
     for (auto it = SystemData::sSystemVector.cbegin(); // Line break.
          it != SystemData::sSystemVector.cend(); ++it) {
-        // We only want nodes from game systems that are not collections.
-        if (!(*it)->isGameSystem() || (*it)->isCollection())
-            continue;
-
-        std::vector<FileData*> allFiles {(*it)->getRootFolder()->getFilesRecursive(GAME, true)};
-        for (auto it2 = allFiles.cbegin(); it2 != allFiles.cend(); ++it2) {
-            // Only include games suitable for children if we're in Kid UI mode.
-            if (UIModeController::getInstance()->isUIModeKid() &&
-                (*it2)->metadata.get("kidgame") != "true")
-                continue;
-            if (favoritesOnly && (*it2)->metadata.get("favorite") != "true")
-                continue;
-            std::string imagePath {(*it2)->getImagePath()};
-            if (imagePath != "")
-                mImageFiles.push_back((*it2));
+        if ((*it)->isGameSystem() && !(*it)->isCollection() && (*it)->getIndex()->isFiltered()) {
+            filtered = true;
+            break;
         }
     }
 
-    mFilesInventory.insert(mFilesInventory.begin(), mImageFiles.begin(), mImageFiles.end());
-}
+    // Changes to the gamelist filters are not tracked, so the inventory is always generated
+    // from scratch if any filters are applied, or were applied when it was last generated.
+    if (mInventoryType == mScreensaverType &&
+        mInventoryGeneration == FileData::getGameGeneration() &&
+        mInventoryFavoritesOnly == favoritesOnly && mInventoryKidMode == kidMode && !filtered &&
+        !mInventoryFiltered)
+        return;
 
-void Screensaver::generateVideoList()
-{
-    const bool favoritesOnly {Settings::getInstance()->getBool("ScreensaverVideoOnlyFavorites")};
+    mInventoryType = mScreensaverType;
+    mInventoryGeneration = FileData::getGameGeneration();
+    mInventoryFavoritesOnly = favoritesOnly;
+    mInventoryKidMode = kidMode;
+    mInventoryFiltered = filtered;
+
+    mInventory.clear();
+    mNextGame = nullptr;
+    mNextVideoPath = "";
+    VideoFFmpegComponent::cancelPrefetch();
+
+    std::string path;
 
     for (auto it = SystemData::sSystemVector.cbegin(); // Line break.
          it != SystemData::sSystemVector.cend(); ++it) {
@@ -447,22 +481,18 @@ void Screensaver::generateVideoList()
 
         std::vector<FileData*> allFiles {(*it)->getRootFolder()->getFilesRecursive(GAME, true)};
         for (auto it2 = allFiles.cbegin(); it2 != allFiles.cend(); ++it2) {
-            // Only include games suitable for children if we're in Kid UI mode.
-            if (UIModeController::getInstance()->isUIModeKid() &&
-                (*it2)->metadata.get("kidgame") != "true")
-                continue;
-            if (favoritesOnly && (*it2)->metadata.get("favorite") != "true")
-                continue;
-            std::string videoPath {(*it2)->getVideoPath()};
-            if (videoPath != "")
-                mVideoFiles.push_back((*it2));
+            if (getMediaPath(*it2, path))
+                mInventory.insert(*it2);
         }
     }
 
-    mFilesInventory.insert(mFilesInventory.begin(), mVideoFiles.begin(), mVideoFiles.end());
+    mShuffleBag.assign(mInventory.cbegin(), mInventory.cend());
+
+    LOG(LogDebug) << "Screensaver::updateInventory(): Found " << mInventory.size()
+                  << (mInventoryType == "video" ? " games with videos" : " games with images");
 }
 
-void Screensaver::generateCustomImageList()
+void Screensaver::updateCustomImageInventory()
 {
     std::string imageDir {Utils::FileSystem::expandHomePath(
         Settings::getInstance()->getString("ScreensaverSlideshowCustomDir"))};
@@ -475,18 +505,33 @@ void Screensaver::generateCustomImageList()
     imageDir = Utils::String::replace(imageDir, "%ESPATH%", Utils::FileSystem::getExePath());
     imageDir = Utils::String::replace(imageDir, "%ROMPATH%", FileData::getROMDirectory());
 
+    const bool recurse {Settings::getInstance()->getBool("ScreensaverSlideshowRecurse")};
+    const long long modTime {Utils::FileSystem::getModificationTime(imageDir)};
+
+    // Changes in subdirectories are not reflected in the modification time of the directory,
+    // so it's always listed again if the images are read recursively.
+    if (imageDir == mCustomImageDirectory && modTime == mCustomImageDirModTime && !recurse &&
+        !mCustomImageRecurse)
+        return;
+
+    mCustomImageDirectory = imageDir;
+    mCustomImageDirModTime = modTime;
+    mCustomImageRecurse = recurse;
+    mCustomImageInventory.clear();
+    mNextCustomImage = "";
+
     if (imageDir != "" && Utils::FileSystem::isDirectory(imageDir)) {
         const std::vector<std::string> extList {".jpg", ".JPG",  ".png",  ".PNG", ".gif",
                                                 ".GIF", ".webp", ".WEBP", ".svg", ".SVG"};
 
-        Utils::FileSystem::StringList dirContent {Utils::FileSystem::getDirContent(
-            imageDir, Settings::getInstance()->getBool("ScreensaverSlideshowRecurse"))};
+        Utils::FileSystem::StringList dirContent {
+            Utils::FileSystem::getDirContent(imageDir, recurse)};
 
         for (auto it = dirContent.begin(); it != dirContent.end(); ++it) {
             if (Utils::FileSystem::isRegularFile(*it)) {
                 if (std::find(extList.cbegin(), extList.cend(),
                               Utils::FileSystem::getExtension(*it)) != extList.cend())
-                    mImageCustomFiles.push_back(*it);
+                    mCustomImageInventory.push_back(*it);
             }
         }
     }
@@ -495,119 +540,127 @@ void Screensaver::generateCustomImageList()
                         << "\" does not exist";
     }
 
-    mCustomFilesInventory.insert(mCustomFilesInventory.begin(), mImageCustomFiles.begin(),
-                                 mImageCustomFiles.end());
+    mCustomImageShuffleBag = mCustomImageInventory;
 }
 
-void Screensaver::pickRandomImage(std::string& path)
+bool Screensaver::getMediaPath(FileData* game, std::string& path)
 {
-    mCurrentGame = nullptr;
+    // Only include games suitable for children if we're in Kid UI mode.
+    if (mInventoryKidMode && game->metadata.get("kidgame") != "true")
+        return false;
+    if (mInventoryFavoritesOnly && game->metadata.get("favorite") != "true")
+        return false;
+
+    FileFilterIndex* filterIndex {game->getSystem()->getIndex()};
+    if (filterIndex->isFiltered() && !filterIndex->showFile(game))
+        return false;
+
+    path = (mInventoryType == "video" ? game->getVideoPath() : game->getImagePath());
+    return path != "";
+}
 
-    if (mImageFiles.size() == 0)
-        return;
+FileData* Screensaver::pickRandomGame(std::string& path)
+{
+    path = "";
+
+    if (mNextGame != nullptr) {
+        FileData* game {mNextGame};
+        mNextGame = nullptr;
+        // The game may have been changed since it was picked.
+        if (mInventory.find(game) != mInventory.cend() && getMediaPath(game, path)) {
+            mGameName = game->getName();
+            mSystemName = game->getSystem()->getFullName();
+            return game;
+        }
+    }
 
-    if (mImageFiles.size() == 1) {
-        mPreviousGame = nullptr;
-        mCurrentGame = mImageFiles.front();
-        path = mImageFiles.front()->getImagePath();
-        mGameName = mImageFiles.front()->getName();
-        mSystemName = mImageFiles.front()->getSystem()->getFullName();
-        mCurrentGame = mImageFiles.front();
-        mImageFiles.clear();
-        return;
+    while (!mInventory.empty()) {
+        // We've cycled through all games, so start from the beginning again.
+        if (mShuffleBag.empty())
+            mShuffleBag.assign(mInventory.cbegin(), mInventory.cend());
+
+        std::uniform_int_distribution<size_t> uniformDist {0, mShuffleBag.size() - 1};
+        size_t index {uniformDist(mRandomEngine)};
+
+        // Avoid showing the same game twice in a row when starting a new cycle.
+        if (mShuffleBag.size() > 1 && mShuffleBag[index] == mCurrentGame)
+            index = (index + 1) % mShuffleBag.size();
+
+        FileData* game {mShuffleBag[index]};
+        mShuffleBag[index] = mShuffleBag.back();
+        mShuffleBag.pop_back();
+
+        // Games are not removed from the shuffle bag when removed from the inventory.
+        if (mInventory.find(game) == mInventory.cend())
+            continue;
+
+        // The media file may have been removed since the inventory was generated.
+        if (!getMediaPath(game, path)) {
+            mInventory.erase(game);
+            continue;
+        }
+
+        mGameName = game->getName();
+        mSystemName = game->getSystem()->getFullName();
+        return game;
     }
 
-    unsigned int index;
-    do {
-        // Get a random number in range.
-        std::random_device randDev;
-        //  Mersenne Twister pseudorandom number generator.
-        std::mt19937 engine {randDev()};
-        std::uniform_int_distribution<int> uniform_dist {0,
-                                                         static_cast<int>(mImageFiles.size()) - 1};
-        index = uniform_dist(engine);
-    } while (mPreviousGame && mImageFiles.at(index) == mPreviousGame);
-
-    path = mImageFiles.at(index)->getImagePath();
-    mGameName = mImageFiles.at(index)->getName();
-    mSystemName = mImageFiles.at(index)->getSystem()->getFullName();
-    mCurrentGame = mImageFiles.at(index);
-
-    // Don't display the same image again until we've cycled through all entries.
-    auto it = mImageFiles.begin() + index;
-    mImageFiles.erase(it);
+    return nullptr;
 }
 
-void Screensaver::pickRandomVideo(std::string& path)
+std::string Screensaver::pickRandomCustomImage()
 {
-    mCurrentGame = nullptr;
+    if (mNextCustomImage != "") {
+        const std::string path {mNextCustomImage};
+        mNextCustomImage = "";
+        return path;
+    }
 
-    if (mVideoFiles.size() == 0)
-        return;
+    if (mCustomImageInventory.empty())
+        return "";
 
-    if (mVideoFiles.size() == 1) {
-        mPreviousGame = nullptr;
-        mCurrentGame = mVideoFiles.front();
-        path = mVideoFiles.front()->getVideoPath();
-        mGameName = mVideoFiles.front()->getName();
-        mSystemName = mVideoFiles.front()->getSystem()->getFullName();
-        mCurrentGame = mVideoFiles.front();
-        mVideoFiles.clear();
-        return;
-    }
+    // We've cycled through all images, so start from the beginning again.
+    if (mCustomImageShuffleBag.empty())
+        mCustomImageShuffleBag = mCustomImageInventory;
+
+    std::uniform_int_distribution<size_t> uniformDist {0, mCustomImageShuffleBag.size() - 1};
+    size_t index {uniformDist(mRandomEngine)};
+
+    if (mCustomImageShuffleBag.size() > 1 && mCustomImageShuffleBag[index] == mPreviousCustomImage)
+        index = (index + 1) % mCustomImageShuffleBag.size();
 
-    unsigned int index;
-    do {
-        // Get a random number in range.
-        std::random_device randDev;
-        //  Mersenne Twister pseudorandom number generator.
-        std::mt19937 engine {randDev()};
-        std::uniform_int_distribution<int> uniform_dist {0,
-                                                         static_cast<int>(mVideoFiles.size()) - 1};
-        index = uniform_dist(engine);
-    } while (mPreviousGame && mVideoFiles.at(index) == mPreviousGame);
-
-    path = mVideoFiles.at(index)->getVideoPath();
-    mGameName = mVideoFiles.at(index)->getName();
-    mSystemName = mVideoFiles.at(index)->getSystem()->getFullName();
-    mCurrentGame = mVideoFiles.at(index);
-
-    // Don't play the same video again until we've cycled through all entries.
-    auto it = mVideoFiles.begin() + index;
-    mVideoFiles.erase(it);
+    const std::string path {mCustomImageShuffleBag[index]};
+    mCustomImageShuffleBag[index] = mCustomImageShuffleBag.back();
+    mCustomImageShuffleBag.pop_back();
+
+    return path;
 }
 
-void Screensaver::pickRandomCustomImage(std::string& path)
+void Screensaver::prefetchNext()
 {
-    if (mImageCustomFiles.size() == 0)
+    if (mScreensaverType == "slideshow" &&
+        Settings::getInstance()->getBool("ScreensaverSlideshowCustomImages")) {
+        mNextCustomImage = pickRandomCustomImage();
+        TextureResource::prefetch(mNextCustomImage);
         return;
+    }
 
-    if (mImageCustomFiles.size() == 1) {
-        mPreviousCustomImage = mImageCustomFiles.front();
-        path = mImageCustomFiles.front();
-        mImageCustomFiles.clear();
+    // These are overwritten by pickRandomGame() but are needed for the current game.
+    const std::string gameName {mGameName};
+    const std::string systemName {mSystemName};
+    std::string path;
+
+    mNextGame = pickRandomGame(path);
+    mGameName = gameName;
+    mSystemName = systemName;
+
+    if (mNextGame == nullptr)
         return;
-    }
 
-    unsigned int index;
-    do {
-        // Get a random number in range.
-        std::random_device randDev;
-        //  Mersenne Twister pseudorandom number generator.
-        std::mt19937 engine {randDev()};
-        std::uniform_int_distribution<int> uniform_dist {
-            0, static_cast<int>(mImageCustomFiles.size()) - 1};
-        index = uniform_dist(engine);
-    } while (mPreviousCustomImage != "" && mImageCustomFiles.at(index) == mPreviousCustomImage);
-
-    path = mImageCustomFiles.at(index);
-    mPreviousCustomImage = path;
-    mGameName = "";
-    mSystemName = "";
-
-    // Don't display the same image again until we've cycled through all entries.
-    auto it = mImageCustomFiles.begin() + index;
-    mImageCustomFiles.erase(it);
+    if (mScreensaverType == "slideshow")
+        TextureResource::prefetch(path);
+    else
+        mNextVideoPath = path;
 }
 
 void Screensaver::generateOverlayInfo()
@@ -15,10 +15,14 @@
 #include "components/VideoComponent.h"
 #include "resources/Font.h"
 
+#include <random>
+#include <unordered_set>
+
 class Screensaver : public Window::Screensaver
 {
 public:
     Screensaver();
+    ~Screensaver();
 
     virtual bool isScreensaverActive() { return mScreensaverActive; }
     virtual bool isFallbackScreensaver() { return mFallbackScreensaver; }
@@ -34,29 +38,54 @@ public:
 
     virtual FileData* getCurrentGame() { return mCurrentGame; }
     virtual void triggerNextGame() { mTriggerNextGame = true; }
+    virtual void onFileChanged(FileData* file);
 
 private:
-    void generateImageList();
-    void generateVideoList();
-    void generateCustomImageList();
-    void pickRandomImage(std::string& path);
-    void pickRandomVideo(std::string& path);
-    void pickRandomCustomImage(std::string& path);
+    // The media inventory is only rebuilt if the screensaver settings have changed or if games
+    // have been added or removed, otherwise it's kept up to date using onFileChanged().
+    void updateInventory();
+    void updateCustomImageInventory();
+    // Whether the game should be part of the inventory, also returns the media file path.
+    bool getMediaPath(FileData* game, std::string& path);
+
+    // The shuffle bags contain the entries that have not yet been shown during the current
+    // cycle, and are refilled from the inventory once empty. If the next entry has already
+    // been picked by prefetchNext() then that entry is returned.
+    FileData* pickRandomGame(std::string& path);
+    std::string pickRandomCustomImage();
+    // Picks the game or custom image to show after the current one, and starts loading its
+    // image in the background. Videos are prefetched from update().
+    void prefetchNext();
+
     void generateOverlayInfo();
 
     Renderer* mRenderer;
     Window* mWindow;
 
-    std::vector<FileData*> mImageFiles;
-    std::vector<FileData*> mVideoFiles;
-    std::vector<FileData*> mFilesInventory;
-    std::vector<std::string> mImageCustomFiles;
-    std::vector<std::string> mCustomFilesInventory;
+    std::unordered_set<FileData*> mInventory;
+    std::vector<FileData*> mShuffleBag;
+    std::string mInventoryType;
+    unsigned int mInventoryGeneration;
+    bool mInventoryFavoritesOnly;
+    bool mInventoryKidMode;
+    bool mInventoryFiltered;
+
+    std::vector<std::string> mCustomImageInventory;
+    std::vector<std::string> mCustomImageShuffleBag;
+    std::string mCustomImageDirectory;
+    long long mCustomImageDirModTime;
+    bool mCustomImageRecurse;
+
+    FileData* mNextGame;
+    std::string mNextCustomImage;
+    // Set until the next video has been prefetched, see update().
+    std::string mNextVideoPath;
+    std::mt19937 mRandomEngine;
+
     std::unique_ptr<ImageComponent> mImageScreensaver;
     std::unique_ptr<VideoComponent> mVideoScreensaver;
 
     FileData* mCurrentGame;
-    FileData* mPreviousGame;
     std::string mScreensaverType;
     std::string mPreviousCustomImage;
     std::string mGameName;
@@ -68,6 +97,7 @@ private:
     bool mTriggerNextGame;
     bool mHasMediaFiles;
     bool mFallbackScreensaver;
+    bool mSwitchingGame;
     float mOpacity;
     float mDimValue;
     unsigned char mRectangleFadeIn;
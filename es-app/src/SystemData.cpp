@@ -17,6 +17,7 @@
 #include "GamelistFileParser.h"
 #include "InputManager.h"
 #include "Log.h"
+#include "ROMDirectoryIndex.h"
 #include "Settings.h"
 #include "ThemeData.h"
 #include "UIModeController.h"
@@ -29,9 +30,11 @@
 #include <SDL2/SDL_events.h>
 #include <SDL2/SDL_timer.h>
 
+#include <atomic>
 #include <fstream>
 #include <pugixml.hpp>
 #include <random>
+#include <thread>
 
 FindRules::FindRules()
 {
@@ -230,31 +233,14 @@ SystemData::SystemData(const std::string& name,
 {
     mFilterIndex = new FileFilterIndex();
 
-    // If it's an actual system, initialize it, if not, just create the data structure.
+    // If it's an actual system, just create the root folder as populateSystem() will be called
+    // afterwards by loadConfig(), possibly from a worker thread. Virtual systems are instead
+    // updated by CollectionSystemsManager.
     if (!CollectionSystem) {
         mRootFolder = new FileData(FOLDER, mEnvData->mStartPath, mEnvData, this);
         mRootFolder->metadata.set("name", mFullName);
-
-        if (!Settings::getInstance()->getBool("ParseGamelistOnly")) {
-            // If there was an error populating the folder or if there were no games found,
-            // then don't continue with any additional process steps for this system.
-            if (!populateFolder(mRootFolder))
-                return;
-        }
-
-        if (!Settings::getInstance()->getBool("IgnoreGamelist"))
-            GamelistFileParser::parseGamelist(this);
-
-        setupSystemSortType(mRootFolder);
-
-        mRootFolder->sort(mRootFolder->getSortTypeFromString(mRootFolder->getSortTypeString()),
-                          Settings::getInstance()->getBool("FavoritesFirst"));
-
-        indexAllGameFilters(mRootFolder);
     }
     else {
-        // Virtual systems are updated afterwards by CollectionSystemsManager.
-        // We're just creating the data structure here.
         mRootFolder = new FileData(FOLDER, "" + name, mEnvData, this);
         setupSystemSortType(mRootFolder);
     }
@@ -263,7 +249,10 @@ SystemData::SystemData(const std::string& name,
     mPlaceholder = new FileData(PLACEHOLDER, "<No Entries Found>", getSystemEnvData(), this);
 
     setIsGameSystemStatus();
-    loadTheme(ThemeTriggers::TriggerType::NONE);
+
+    // The theme for actual systems is loaded by loadConfig() once the system has been populated.
+    if (CollectionSystem)
+        loadTheme(ThemeTriggers::TriggerType::NONE);
 }
 
 SystemData::~SystemData()
@@ -287,7 +276,154 @@ void SystemData::setIsGameSystemStatus()
     mIsGameSystem = true;
 }
 
-bool SystemData::populateFolder(FileData* folder)
+bool SystemData::populateSystem()
+{
+    // This function does not touch any shared state apart from reading the settings, so it's
+    // safe to call it concurrently for different systems.
+    if (!Settings::getInstance()->getBool("ParseGamelistOnly")) {
+        ROMDirectoryIndex dirIndex {mName, mEnvData->mStartPath,
+                                    Settings::getInstance()->getBool("ROMDirectoryIndex")};
+        const bool populated {populateFolder(mRootFolder, dirIndex)};
+        dirIndex.saveIndex();
+
+        LOG(LogDebug) << "SystemData::populateSystem(): System \"" << mName << "\": Scanned "
+                      << dirIndex.getScannedDirCount() << " and reused the index for "
+                      << dirIndex.getCachedDirCount() << " directories";
+
+        // If there was an error populating the folder or if there were no games found,
+        // then don't continue with any additional process steps for this system.
+        if (!populated)
+            return false;
+    }
+
+    if (!Settings::getInstance()->getBool("IgnoreGamelist"))
+        GamelistFileParser::parseGamelist(this);
+
+    setupSystemSortType(mRootFolder);
+
+    mRootFolder->sort(mRootFolder->getSortTypeFromString(mRootFolder->getSortTypeString()),
+                      Settings::getInstance()->getBool("FavoritesFirst"));
+
+    indexAllGameFilters(mRootFolder);
+
+    if (mRootFolder->getChildrenByFilename().size() == 0)
+        return false;
+
+    // If the option to show hidden games has been disabled, then check whether all
+    // games for the system are hidden. That will flag the system as empty.
+    if (!Settings::getInstance()->getBool("ShowHiddenGames")) {
+        const std::vector<FileData*>& recursiveGames {mRootFolder->getChildrenRecursive()};
+        for (auto it = recursiveGames.cbegin(); it != recursiveGames.cend(); ++it) {
+            if ((*it)->getType() != FOLDER && !(*it)->getHidden())
+                return true;
+        }
+        return false;
+    }
+
+    return true;
+}
+
+bool SystemData::populateSystems(const std::vector<SystemData*>& systems,
+                                 std::vector<char>& populated,
+                                 float progressStart,
+                                 float progressEnd)
+{
+    populated.assign(systems.size(), 0);
+
+    if (systems.empty())
+        return true;
+
+    const bool splashScreen {Settings::getInstance()->getBool("SplashScreen")};
+    const int threadSetting {glm::clamp(Settings::getInstance()->getInt("SystemLoadingThreads"),
+                                        0, 32)};
+    unsigned int threadCount {threadSetting == 0 ? std::thread::hardware_concurrency() :
+                                                   static_cast<unsigned int>(threadSetting)};
+    threadCount = glm::clamp(threadCount, 1u, static_cast<unsigned int>(systems.size()));
+
+    const float systemCount {static_cast<float>(systems.size())};
+    unsigned int lastTime {0};
+    unsigned int accumulator {0};
+    SDL_Event event {};
+
+    // Poll events so that the OS doesn't think the application is hanging on startup,
+    // this is required as the main application loop hasn't started yet. This also updates
+    // the progress bar if the splash screen is enabled.
+    auto pollEventsFunc = [&](size_t processedSystems) {
+        while (SDL_PollEvent(&event)) {
+            InputManager::getInstance().parseEvent(event);
+            if (event.type == SDL_QUIT) {
+                sStartupExitSignal = true;
+                return false;
+            }
+        };
+
+        if (splashScreen) {
+            const unsigned int curTime {SDL_GetTicks()};
+            accumulator += curTime - lastTime;
+            lastTime = curTime;
+            // This prevents Renderer::swapBuffers() from being called excessively which
+            // could lead to significantly longer application startup times.
+            if (accumulator > 40) {
+                accumulator = 0;
+                const float progress {glm::mix(progressStart, progressEnd,
+                                               static_cast<float>(processedSystems) / systemCount)};
+                Window::getInstance()->renderSplashScreen(Window::SplashScreenState::SCANNING,
+                                                          progress);
+                lastTime += SDL_GetTicks() - curTime;
+            }
+        }
+        return true;
+    };
+
+    if (threadCount == 1) {
+        for (size_t i {0}; i < systems.size(); ++i) {
+            if (!pollEventsFunc(i))
+                return false;
+            populated[i] = systems[i]->populateSystem();
+        }
+        return true;
+    }
+
+    LOG(LogDebug) << "SystemData::populateSystems(): Populating " << systems.size()
+                  << " systems using " << threadCount << " threads";
+
+    std::atomic<size_t> nextSystem {0};
+    std::atomic<size_t> processedSystems {0};
+    std::atomic<bool> abortLoading {false};
+    std::vector<std::thread> workers;
+
+    for (unsigned int i {0}; i < threadCount; ++i) {
+        workers.emplace_back([&] {
+            while (!abortLoading) {
+                const size_t index {nextSystem++};
+                if (index >= systems.size())
+                    break;
+                populated[index] = systems[index]->populateSystem();
+                ++processedSystems;
+            }
+        });
+    }
+
+    bool exitSignal {false};
+
+    while (processedSystems < systems.size()) {
+        if (!pollEventsFunc(processedSystems)) {
+            // The remaining systems will not be processed, but the systems currently being
+            // populated need to finish before we can return.
+            exitSignal = true;
+            abortLoading = true;
+            break;
+        }
+        SDL_Delay(5);
+    }
+
+    for (auto& worker : workers)
+        worker.join();
+
+    return !exitSignal;
+}
+
+bool SystemData::populateFolder(FileData* folder, ROMDirectoryIndex& dirIndex)
 {
     if (mSymlinkMaxDepthReached)
         return false;
@@ -296,33 +432,38 @@ bool SystemData::populateFolder(FileData* folder)
     std::string extension;
     const std::string& folderPath {folder->getPath()};
     const bool showHiddenFiles {Settings::getInstance()->getBool("ShowHiddenFiles")};
-    const Utils::FileSystem::StringList& dirContent {Utils::FileSystem::getDirContent(folderPath)};
+    const std::vector<ROMDirectoryIndex::Entry>& dirContent {dirIndex.getDirContent(folderPath)};
     bool isGame {false};
 
     // If system directory exists but contains no games, return as error.
     if (dirContent.size() == 0)
         return false;
 
-    if (std::find(dirContent.cbegin(), dirContent.cend(), mEnvData->mStartPath + "/noload.txt") !=
-        dirContent.cend()) {
+    auto fileFindFunc = [&dirContent](const std::string& path) {
+        return std::find_if(dirContent.cbegin(), dirContent.cend(),
+                            [&path](const ROMDirectoryIndex::Entry& entry) {
+                                return entry.path == path;
+                            }) != dirContent.cend();
+    };
+
+    if (fileFindFunc(mEnvData->mStartPath + "/noload.txt")) {
         LOG(LogInfo) << "Not populating system \"" << mName << "\" as a noload.txt file is present";
         return false;
     }
 
-    if (std::find(dirContent.cbegin(), dirContent.cend(), mEnvData->mStartPath + "/flatten.txt") !=
-        dirContent.cend()) {
+    if (fileFindFunc(mEnvData->mStartPath + "/flatten.txt")) {
         LOG(LogInfo) << "A flatten.txt file is present for the \"" << mName
                      << "\" system, folder flattening will be applied";
         mFlattenFolders = true;
     }
 
-    for (Utils::FileSystem::StringList::const_iterator it {dirContent.cbegin()};
+    for (std::vector<ROMDirectoryIndex::Entry>::const_iterator it {dirContent.cbegin()};
          it != dirContent.cend(); ++it) {
-        filePath = *it;
-        const bool isDirectory {Utils::FileSystem::isDirectory(filePath)};
+        filePath = (*it).path;
+        const bool isDirectory {(*it).isDirectory};
 
         // Skip any recursive symlinks as those would hang the application at various places.
-        if (Utils::FileSystem::isSymlink(filePath)) {
+        if ((*it).isSymlink) {
             if (Utils::FileSystem::resolveSymlink(filePath) ==
                 Utils::FileSystem::getFileName(filePath)) {
                 LOG(LogWarning) << "Skipped \"" << filePath << "\" as it's a recursive symlink";
@@ -331,7 +472,7 @@ bool SystemData::populateFolder(FileData* folder)
         }
 
         // Skip hidden files and folders.
-        if (!showHiddenFiles && Utils::FileSystem::isHidden(filePath)) {
+        if (!showHiddenFiles && (*it).isHidden) {
             LOG(LogDebug) << "SystemData::populateFolder(): Skipping hidden "
                           << (isDirectory ? "directory \"" : "file \"") << filePath << "\"";
             continue;
@@ -374,7 +515,7 @@ bool SystemData::populateFolder(FileData* folder)
         if (!isGame && isDirectory) {
             // Make sure that it's not a recursive symlink as the application would run into a
             // loop trying to resolve the link.
-            if (Utils::FileSystem::isSymlink(filePath)) {
+            if ((*it).isSymlink) {
                 bool recursiveSymlink {false};
                 const std::string& canonicalPath {Utils::FileSystem::getCanonicalPath(filePath)};
                 const std::string& canonicalStartPath {
@@ -413,7 +554,7 @@ bool SystemData::populateFolder(FileData* folder)
             }
 
             FileData* newFolder {new FileData(FOLDER, filePath, mEnvData, this)};
-            populateFolder(newFolder);
+            populateFolder(newFolder, dirIndex);
 
             if (mFlattenFolders) {
                 for (auto& entry : newFolder->getChildrenByFilename())
@@ -484,31 +625,22 @@ bool SystemData::loadConfig()
     bool onlyProcessCustomFile {false};
 
     const bool splashScreen {Settings::getInstance()->getBool("SplashScreen")};
-    float systemCount {0.0f};
-    float parsedSystems {0.0f};
+    unsigned int systemCount {0};
     unsigned int gameCount {0};
 
-    // This is only done to get the total system count, for calculating the progress bar position.
-    for (auto& configPath : configPaths) {
-        pugi::xml_document doc;
-#if defined(_WIN64)
-        const pugi::xml_parse_result& res {
-            doc.load_file(Utils::String::stringToWideString(configPath).c_str())};
-#else
-        const pugi::xml_parse_result& res {doc.load_file(configPath.c_str())};
-#endif
-        if (!res)
-            break;
-        const pugi::xml_node& systemList {doc.child("systemList")};
-        if (!systemList)
-            continue;
-        for (pugi::xml_node system {systemList.child("system")}; system;
-             system = system.next_sibling("system")) {
-            ++systemCount;
-        }
-        if (doc.child("loadExclusive"))
-            break;
-    }
+    // Systems are first created from the configuration files and are then populated in a
+    // separate step, which may be performed by multiple threads. If a system name is repeated
+    // (e.g. if a custom es_systems.xml file overrides a bundled system), then the latter entry
+    // is only used if the earlier one turns out to be empty.
+    std::vector<SystemData*> pendingSystems;
+    std::vector<SystemData*> fallbackSystems;
+
+    auto deletePendingFunc = [&] {
+        for (auto system : pendingSystems)
+            delete system;
+        for (auto system : fallbackSystems)
+            delete system;
+    };
 
     for (auto& configPath : configPaths) {
         // If the loadExclusive tag is present in the custom es_systems.xml file, then skip
@@ -557,8 +689,6 @@ bool SystemData::loadConfig()
             return true;
         }
 
-        unsigned int lastTime {0};
-        unsigned int accumulator {0};
         SDL_Event event {};
 
         for (pugi::xml_node system {systemList.child("system")}; system;
@@ -569,10 +699,13 @@ bool SystemData::loadConfig()
                 InputManager::getInstance().parseEvent(event);
                 if (event.type == SDL_QUIT) {
                     sStartupExitSignal = true;
+                    deletePendingFunc();
                     return true;
                 }
             };
 
+            ++systemCount;
+
             std::string name;
             std::string fullname;
             std::string sortName;
@@ -584,37 +717,6 @@ bool SystemData::loadConfig()
             sortName = system.child("systemsortname").text().get();
             path = system.child("path").text().get();
 
-            if (splashScreen) {
-                const unsigned int curTime {SDL_GetTicks()};
-                accumulator += curTime - lastTime;
-                lastTime = curTime;
-                ++parsedSystems;
-                // This prevents Renderer::swapBuffers() from being called excessively which
-                // could lead to significantly longer application startup times.
-                if (accumulator > 40) {
-                    accumulator = 0;
-                    const float progress {glm::mix(0.0f, 0.5f, parsedSystems / systemCount)};
-                    Window::getInstance()->renderSplashScreen(Window::SplashScreenState::SCANNING,
-                                                              progress);
-                    lastTime += SDL_GetTicks() - curTime;
-                }
-            }
-
-            auto nameFindFunc = [&] {
-                for (auto system : sSystemVector) {
-                    if (system->mName == name) {
-                        LOG(LogDebug) << "A system with the name \"" << name
-                                      << "\" has already been loaded, skipping duplicate entry";
-                        return true;
-                    }
-                }
-                return false;
-            };
-
-            // If the name is matching a system that has already been loaded, then skip the entry.
-            if (nameFindFunc())
-                continue;
-
             // If there is a %ROMPATH% variable set for the system, expand it. By doing this
             // it's possible to use either absolute ROM paths in es_systems.xml or to utilize
             // the ROM path configured as ROMDirectory in es_settings.xml. If it's set to ""
@@ -781,32 +883,59 @@ bool SystemData::loadConfig()
             envData->mPlatformIds = platformIds;
 
             SystemData* newSys {new SystemData(name, fullname, sortName, envData, themeFolder)};
-            bool onlyHidden {false};
-
-            // If the option to show hidden games has been disabled, then check whether all
-            // games for the system are hidden. That will flag the system as empty.
-            if (!Settings::getInstance()->getBool("ShowHiddenGames")) {
-                std::vector<FileData*> recursiveGames {
-                    newSys->getRootFolder()->getChildrenRecursive()};
-                onlyHidden = true;
-                for (auto it = recursiveGames.cbegin(); it != recursiveGames.cend(); ++it) {
-                    if ((*it)->getType() != FOLDER) {
-                        onlyHidden = (*it)->getHidden();
-                        if (!onlyHidden)
-                            break;
-                    }
-                }
-            }
 
-            if (newSys->getRootFolder()->getChildrenByFilename().size() == 0 || onlyHidden) {
-                LOG(LogDebug) << "SystemData::loadConfig(): Skipping system \"" << name
-                              << "\" as no files matched any of the defined file extensions";
-                delete newSys;
+            if (std::find_if(pendingSystems.cbegin(), pendingSystems.cend(),
+                             [&name](SystemData* pendingSystem) {
+                                 return pendingSystem->mName == name;
+                             }) != pendingSystems.cend())
+                fallbackSystems.emplace_back(newSys);
+            else
+                pendingSystems.emplace_back(newSys);
+        }
+    }
+
+    std::vector<char> populated;
+
+    if (!populateSystems(pendingSystems, populated, 0.0f, 0.5f)) {
+        deletePendingFunc();
+        return true;
+    }
+
+    // Merge the results in configuration file order, so the outcome is identical regardless
+    // of how many threads were used for populating the systems.
+    auto addSystemFunc = [&](SystemData* newSys, bool hasGames) {
+        if (hasGames) {
+            newSys->loadTheme(ThemeTriggers::TriggerType::NONE);
+            sSystemVector.emplace_back(newSys);
+            gameCount += newSys->getRootFolder()->getGameCount().first;
+        }
+        else {
+            LOG(LogDebug) << "SystemData::loadConfig(): Skipping system \"" << newSys->mName
+                          << "\" as no files matched any of the defined file extensions";
+            delete newSys;
+        }
+    };
+
+    for (size_t i {0}; i < pendingSystems.size(); ++i) {
+        SystemData* newSys {pendingSystems[i]};
+        const std::string name {newSys->mName};
+        const bool hasGames {populated[i] != 0};
+        addSystemFunc(newSys, hasGames);
+
+        for (auto it = fallbackSystems.begin(); it != fallbackSystems.end();) {
+            if ((*it)->mName != name) {
+                ++it;
+                continue;
+            }
+            if (hasGames || getSystemByName(name) != nullptr) {
+                LOG(LogDebug) << "A system with the name \"" << name
+                              << "\" has already been loaded, skipping duplicate entry";
+                delete *it;
             }
             else {
-                sSystemVector.emplace_back(newSys);
-                gameCount += newSys->getRootFolder()->getGameCount().first;
+                addSystemFunc(*it, (*it)->populateSystem());
             }
+            it = fallbackSystems.erase(it);
         }
     }
 
@@ -1454,13 +1583,12 @@ FileData* SystemData::getRandomGame(const FileData* currentGame, bool gameSelect
                 }
             }
         }
+        else if (auto view = ViewController::getInstance()->getGamelistViewIfExists(
+                     mRootFolder->getSystem())) {
+            gameList = view->getCursor()->getParent()->getChildrenListToDisplay();
+        }
         else {
-            gameList = ViewController::getInstance()
-                           ->getGamelistView(mRootFolder->getSystem())
-                           .get()
-                           ->getCursor()
-                           ->getParent()
-                           ->getChildrenListToDisplay();
+            gameList = mRootFolder->getChildrenListToDisplay();
         }
     }
 
@@ -1542,8 +1670,9 @@ void SystemData::sortSystem(bool reloadGamelist, bool jumpToFirstRow)
         ViewController::getInstance()->reloadGamelistView(this, false);
 
     if (jumpToFirstRow) {
-        GamelistView* gameList {ViewController::getInstance()->getGamelistView(this).get()};
-        gameList->setCursor(gameList->getFirstEntry());
+        GamelistView* gameList {ViewController::getInstance()->getGamelistViewIfExists(this).get()};
+        if (gameList != nullptr)
+            gameList->setCursor(gameList->getFirstEntry());
     }
 }
 
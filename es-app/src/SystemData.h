@@ -23,6 +23,7 @@
 
 class FileData;
 class FileFilterIndex;
+class ROMDirectoryIndex;
 class ThemeData;
 
 struct SystemEnvironmentData {
@@ -166,7 +167,16 @@ private:
     bool mScrapeFlag; // Only used by scraper GUI to remember which systems to scrape.
     bool mFlattenFolders;
 
-    bool populateFolder(FileData* folder);
+    // Scans the system directory, parses the gamelist.xml file, sorts the gamelist and indexes
+    // the game filters. Returns false if there are no games to display for the system.
+    bool populateSystem();
+    // Runs populateSystem() for all passed systems, using multiple threads unless disabled via
+    // the SystemLoadingThreads setting. Returns false if an exit signal was received.
+    static bool populateSystems(const std::vector<SystemData*>& systems,
+                                std::vector<char>& populated,
+                                float progressStart,
+                                float progressEnd);
+    bool populateFolder(FileData* folder, ROMDirectoryIndex& dirIndex);
     void indexAllGameFilters(const FileData* folder);
     void setIsGameSystemStatus();
 
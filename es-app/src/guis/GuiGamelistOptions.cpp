@@ -381,8 +381,8 @@ void GuiGamelistOptions::startEditMode()
     // currently being edited. This is done cheaply using onFileChanged() which will trigger
     // populateList().
     for (auto it = SystemData::sSystemVector.begin(); it != SystemData::sSystemVector.end(); ++it) {
-        ViewController::getInstance()->getGamelistView((*it))->onFileChanged(
-            ViewController::getInstance()->getGamelistView((*it))->getCursor(), false);
+        if (auto view = ViewController::getInstance()->getGamelistViewIfExists((*it)))
+            view->onFileChanged(view->getCursor(), false);
     }
 
     if (mSystem->getRootFolder()->getChildren().size() == 0)
@@ -442,6 +442,11 @@ void GuiGamelistOptions::openMetaDataEd()
         }
         ViewController::getInstance()->getGamelistView(file->getSystem()).get()->removeMedia(file);
 
+        // The filter index has the keys for the current metadata values, so the game needs to
+        // be removed before the reset and then added back.
+        if (file->getType() == GAME)
+            file->getSystem()->getIndex()->removeFromIndex(file);
+
         // Manually reset all the metadata values, set the name to the actual file/folder name.
         const std::vector<MetaDataDecl>& mdd {file->metadata.getMDD()};
         for (auto it = mdd.cbegin(); it != mdd.cend(); ++it) {
@@ -464,6 +469,9 @@ void GuiGamelistOptions::openMetaDataEd()
         if (file->getType() == GAME && Utils::FileSystem::isDirectory(file->getFullPath()))
             file->metadata.set("name", Utils::FileSystem::getStem(file->metadata.get("name")));
 
+        if (file->getType() == GAME)
+            file->getSystem()->getIndex()->addToIndex(file);
+
         // Update all collections where the game is present.
         if (file->getType() == GAME)
             CollectionSystemsManager::getInstance()->refreshCollectionSystems(file, true);
@@ -9,6 +9,7 @@
 #include "guis/GuiOrphanedDataCleanup.h"
 
 #include "CollectionSystemsManager.h"
+#include "MediaDirectoryIndex.h"
 #include "utils/FileSystemUtil.h"
 #include "utils/PlatformUtil.h"
 #include "views/ViewController.h"
@@ -437,6 +438,7 @@ void GuiOrphanedDataCleanup::cleanupMediaFiles()
                     mIsProcessing = false;
                     return;
                 }
+                MediaDirectoryIndex::getInstance().removeFile(file);
                 ++mProcessedCount;
                 ++systemProcessedCount;
             }
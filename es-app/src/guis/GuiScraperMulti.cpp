@@ -14,6 +14,8 @@
 #include "CollectionSystemsManager.h"
 #include "FileFilterIndex.h"
 #include "GamelistFileParser.h"
+#include "HttpCache.h"
+#include "Log.h"
 #include "MameNames.h"
 #include "SystemData.h"
 #include "Window.h"
@@ -23,6 +25,8 @@
 #include "guis/GuiMsgBox.h"
 #include "guis/GuiScraperSearch.h"
 
+#include <iomanip>
+
 GuiScraperMulti::GuiScraperMulti(
     const std::pair<std::queue<ScraperSearchParams>, std::map<SystemData*, int>>& searches,
     bool approveResults)
@@ -31,6 +35,7 @@ GuiScraperMulti::GuiScraperMulti(
     , mGrid {glm::ivec2 {2, 6}}
     , mSearchQueue {searches.first}
     , mApproveResults {approveResults}
+    , mSavedNewMedia {false}
 {
     assert(mSearchQueue.size());
 
@@ -172,12 +177,29 @@ GuiScraperMulti::GuiScraperMulti(
     setPosition((mRenderer->getScreenWidth() - mSize.x) / 2.0f,
                 (mRenderer->getScreenHeight() - mSize.y) / 2.0f);
 
-    doNextSearch();
+    if (!mApproveResults) {
+        mPipeline = std::make_unique<ScraperPipeline>(mSearchQueue);
+        mPipeline->setAcceptCallback(std::bind(&GuiScraperMulti::onPipelineAccept, this,
+                                               std::placeholders::_1, std::placeholders::_2));
+        mPipeline->setSkipCallback(
+            std::bind(&GuiScraperMulti::onPipelineSkip, this, std::placeholders::_1));
+        mPipeline->setErrorCallback(
+            std::bind(&GuiScraperMulti::onPipelineError, this, std::placeholders::_1));
+        mPipeline->update(0);
+        mSearchComp->setBusy(true);
+        updatePipelineProgress();
+    }
+    else {
+        doNextSearch();
+    }
 }
 
 GuiScraperMulti::~GuiScraperMulti()
 {
-    if (mTotalSuccessful > 0 || mSearchComp->getSavedNewMedia()) {
+    // The pipeline needs to be stopped before GuiScraperSearch cleans up the curl multi handle.
+    mPipeline.reset();
+
+    if (mTotalSuccessful > 0 || mSavedNewMedia || mSearchComp->getSavedNewMedia()) {
         // Sort all systems to possibly update their view style from Basic to Detailed or Video.
         for (auto it = SystemData::sSystemVector.cbegin(); // Line break.
              it != SystemData::sSystemVector.cend(); ++it) {
@@ -210,6 +232,17 @@ void GuiScraperMulti::onSizeChanged()
     mBackground.fitTo(mSize);
 }
 
+void GuiScraperMulti::update(int deltaTime)
+{
+    GuiComponent::update(deltaTime);
+
+    if (mPipeline) {
+        mPipeline->update(deltaTime);
+        if (mPipeline->isFinished())
+            finish();
+    }
+}
+
 void GuiScraperMulti::doNextSearch()
 {
     if (mSearchQueue.empty()) {
@@ -219,17 +252,7 @@ void GuiScraperMulti::doNextSearch()
 
     // Update title.
     std::stringstream ss;
-
-    if (mQueueCountPerSystem.size() > 1) {
-        // const int gameCount {++mQueueCountPerSystem[mSearchQueue.front().system].first};
-        const int totalGameCount {mQueueCountPerSystem[mSearchQueue.front().system].second};
-        mSystem->setText(Utils::String::toUpper(mSearchQueue.front().system->getFullName()) + " [" +
-                         std::to_string(totalGameCount) + " GAME" +
-                         (totalGameCount == 1 ? "]" : "S]"));
-    }
-    else {
-        mSystem->setText(Utils::String::toUpper(mSearchQueue.front().system->getFullName()));
-    }
+    updateSystemName(mSearchQueue.front().system);
     std::string scrapeName;
 
     if (Settings::getInstance()->getBool("ScraperSearchMetadataName")) {
@@ -278,8 +301,13 @@ void GuiScraperMulti::doNextSearch()
 
 void GuiScraperMulti::acceptResult(const ScraperSearchResult& result)
 {
-    ScraperSearchParams& search {mSearchQueue.front()};
+    saveResult(mSearchQueue.front(), result);
+    mSearchQueue.pop();
+    doNextSearch();
+}
 
+void GuiScraperMulti::saveResult(ScraperSearchParams& search, const ScraperSearchResult& result)
+{
     search.system->getIndex()->removeFromIndex(search.game);
 
     GuiScraperSearch::saveMetadata(result, search.game->metadata, search.game);
@@ -290,8 +318,6 @@ void GuiScraperMulti::acceptResult(const ScraperSearchResult& result)
     ++mCurrentGame;
     ++mTotalSuccessful;
     CollectionSystemsManager::getInstance()->refreshCollectionSystems(search.game);
-    mSearchQueue.pop();
-    doNextSearch();
 }
 
 void GuiScraperMulti::skip()
@@ -306,6 +332,8 @@ void GuiScraperMulti::skip()
 
 void GuiScraperMulti::finish()
 {
+    HttpCache::getInstance().saveIndex();
+
     std::stringstream ss;
     if (mTotalSuccessful == 0) {
         ss << "NO GAMES WERE SCRAPED";
@@ -317,6 +345,11 @@ void GuiScraperMulti::finish()
         if (mTotalSkipped > 0)
             ss << "\n"
                << mTotalSkipped << " GAME" << ((mTotalSkipped > 1) ? "S" : "") << " SKIPPED";
+
+        if (mPipeline)
+            ss << "\n"
+               << std::fixed << std::setprecision(1) << mPipeline->getGamesPerMinute()
+               << " GAMES PER MINUTE";
     }
 
     // Pressing either OK or using the back button should delete us.
@@ -333,6 +366,59 @@ void GuiScraperMulti::finish()
         }));
 }
 
+void GuiScraperMulti::updateSystemName(SystemData* system)
+{
+    if (mQueueCountPerSystem.size() > 1) {
+        const int totalGameCount {mQueueCountPerSystem[system].second};
+        mSystem->setText(Utils::String::toUpper(system->getFullName()) + " [" +
+                         std::to_string(totalGameCount) + " GAME" +
+                         (totalGameCount == 1 ? "]" : "S]"));
+    }
+    else {
+        mSystem->setText(Utils::String::toUpper(system->getFullName()));
+    }
+}
+
+void GuiScraperMulti::onPipelineAccept(ScraperSearchParams& search,
+                                       const ScraperSearchResult& result)
+{
+    saveResult(search, result);
+    if (result.savedNewMedia)
+        mSavedNewMedia = true;
+
+    mSearchComp->displayResult(result, search.game);
+    updatePipelineProgress();
+}
+
+void GuiScraperMulti::onPipelineSkip(ScraperSearchParams& search)
+{
+    LOG(LogDebug) << "GuiScraperMulti::onPipelineSkip(): Skipping game \""
+                  << search.game->getPath() << "\"";
+    ++mCurrentGame;
+    ++mTotalSkipped;
+    updatePipelineProgress();
+}
+
+void GuiScraperMulti::onPipelineError(const std::string& error)
+{
+    mWindow->pushGui(new GuiMsgBox(
+        getHelpStyle(), Utils::String::toUpper(error), "RETRY",
+        [this] { mPipeline->retryFailed(); }, "SKIP", [this] { mPipeline->skipFailed(); },
+        "CANCEL", std::bind(&GuiScraperMulti::finish, this), nullptr, true));
+}
+
+void GuiScraperMulti::updatePipelineProgress()
+{
+    updateSystemName(mPipeline->getLastStarted().system);
+
+    std::stringstream ss;
+    ss << "GAME " << std::min(mCurrentGame + 1, mTotalGames) << " OF " << mTotalGames;
+    if (mCurrentGame > 0)
+        ss << " - " << std::fixed << std::setprecision(1) << mPipeline->getGamesPerMinute()
+           << " GAMES PER MINUTE";
+    mSubtitle->setText(ss.str());
+}
+
 std::vector<HelpPrompt> GuiScraperMulti::getHelpPrompts()
 {
     std::vector<HelpPrompt> prompts {mGrid.getHelpPrompts()};
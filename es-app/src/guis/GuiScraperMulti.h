@@ -18,6 +18,7 @@
 #include "components/NinePatchComponent.h"
 #include "components/ScrollIndicatorComponent.h"
 #include "scrapers/Scraper.h"
+#include "scrapers/ScraperPipeline.h"
 #include "views/ViewController.h"
 
 class GuiScraperSearch;
@@ -33,15 +34,24 @@ public:
     virtual ~GuiScraperMulti();
 
     void onSizeChanged() override;
+    void update(int deltaTime) override;
 
     std::vector<HelpPrompt> getHelpPrompts() override;
     HelpStyle getHelpStyle() override { return ViewController::getInstance()->getViewHelpStyle(); }
 
 private:
     void acceptResult(const ScraperSearchResult& result);
+    void saveResult(ScraperSearchParams& search, const ScraperSearchResult& result);
     void skip();
     void doNextSearch();
     void finish();
+    void updateSystemName(SystemData* system);
+
+    // Automatic mode, where multiple games are scraped concurrently.
+    void onPipelineAccept(ScraperSearchParams& search, const ScraperSearchResult& result);
+    void onPipelineSkip(ScraperSearchParams& search);
+    void onPipelineError(const std::string& error);
+    void updatePipelineProgress();
 
     Renderer* mRenderer;
     NinePatchComponent mBackground;
@@ -56,6 +66,7 @@ private:
     std::shared_ptr<GuiScraperSearch> mSearchComp;
     std::shared_ptr<ComponentGrid> mButtonGrid;
     std::shared_ptr<ComponentList> mResultList;
+    std::unique_ptr<ScraperPipeline> mPipeline;
 
     std::queue<ScraperSearchParams> mSearchQueue;
     std::map<SystemData*, std::pair<int, int>> mQueueCountPerSystem;
@@ -65,6 +76,7 @@ private:
     unsigned int mTotalSuccessful;
     unsigned int mTotalSkipped;
     bool mApproveResults;
+    bool mSavedNewMedia;
 };
 
 #endif // ES_APP_GUIS_GUI_SCRAPER_MULTI_H
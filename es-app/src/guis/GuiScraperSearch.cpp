@@ -178,6 +178,8 @@ GuiScraperSearch::~GuiScraperSearch()
     if (mCalculateMD5HashThread.joinable())
         mCalculateMD5HashThread.join();
 
+    ROMHashDatabase::getInstance().saveIndex();
+
     mWindow->setAllowTextScrolling(false);
 }
 
@@ -367,7 +369,11 @@ void GuiScraperSearch::search(ScraperSearchParams& params)
         params.automaticMode = false;
 
     mMD5Hash = "";
+    mCRC32Hash = "";
+    mSHA1Hash = "";
     params.md5Hash = "";
+    params.crc32Hash = "";
+    params.sha1Hash = "";
     if (!Utils::FileSystem::isDirectory(params.game->getPath()))
         params.fileSize = Utils::FileSystem::getFileSize(params.game->getPath());
 
@@ -633,16 +639,7 @@ void GuiScraperSearch::updateInfoPane()
             }
         }
 
-        // Metadata.
-        if (mScrapeRatings) {
-            mMD_Rating->setValue(Utils::String::toUpper(res.mdl.get("rating")));
-            mMD_Rating->setOpacity(1.0f);
-        }
-        mMD_ReleaseDate->setValue(Utils::String::toUpper(res.mdl.get("releasedate")));
-        mMD_Developer->setText(Utils::String::toUpper(res.mdl.get("developer")));
-        mMD_Publisher->setText(Utils::String::toUpper(res.mdl.get("publisher")));
-        mMD_Genre->setText(Utils::String::toUpper(res.mdl.get("genre")));
-        mMD_Players->setText(Utils::String::toUpper(res.mdl.get("players")));
+        updateMetadata(res);
         mGrid.onSizeChanged();
     }
     else {
@@ -665,6 +662,41 @@ void GuiScraperSearch::updateInfoPane()
     }
 }
 
+void GuiScraperSearch::updateMetadata(const ScraperSearchResult& result)
+{
+    if (mScrapeRatings) {
+        mMD_Rating->setValue(Utils::String::toUpper(result.mdl.get("rating")));
+        mMD_Rating->setOpacity(1.0f);
+    }
+    mMD_ReleaseDate->setValue(Utils::String::toUpper(result.mdl.get("releasedate")));
+    mMD_Developer->setText(Utils::String::toUpper(result.mdl.get("developer")));
+    mMD_Publisher->setText(Utils::String::toUpper(result.mdl.get("publisher")));
+    mMD_Genre->setText(Utils::String::toUpper(result.mdl.get("genre")));
+    mMD_Players->setText(Utils::String::toUpper(result.mdl.get("players")));
+}
+
+void GuiScraperSearch::displayResult(const ScraperSearchResult& result, FileData* game)
+{
+    mResultList->clear();
+    ComponentListRow row;
+    row.addElement(std::make_shared<TextComponent>(Utils::String::toUpper(result.mdl.get("name")),
+                                                   Font::get(FONT_SIZE_MEDIUM), mMenuColorPrimary),
+                   true);
+    mResultList->addRow(row);
+
+    mResultName->setText(Utils::String::toUpper(result.mdl.get("name")));
+    mResultDesc->setText(Utils::String::toUpper(result.mdl.get("desc")));
+    mDescContainer->resetComponent();
+
+    // The media files have already been saved to disk at this point so there is no need
+    // to download the thumbnail.
+    const std::string screenshotPath {game->getScreenshotPath()};
+    mResultThumbnail->setImage(screenshotPath != "" ? screenshotPath : game->getCoverPath());
+
+    updateMetadata(result);
+    mGrid.onSizeChanged();
+}
+
 bool GuiScraperSearch::input(InputConfig* config, Input input)
 {
     if (config->isMappedTo("a", input) && input.value != 0) {
@@ -757,6 +789,8 @@ void GuiScraperSearch::update(int deltaTime)
                 if (mCalculateMD5HashThread.joinable())
                     mCalculateMD5HashThread.join();
                 mLastSearch.md5Hash = mMD5Hash;
+                mLastSearch.crc32Hash = mCRC32Hash;
+                mLastSearch.sha1Hash = mSHA1Hash;
                 mSearchHandle = startScraperSearch(mLastSearch);
                 mNextSearch = false;
             }
@@ -834,23 +868,7 @@ void GuiScraperSearch::update(int deltaTime)
             mScraperResults.clear();
 
             // Combine the intial scrape results with the media URL results.
-            for (auto it = results_media.cbegin(); it != results_media.cend(); ++it) {
-                for (unsigned int i = 0; i < results_scrape.size(); ++i) {
-                    if (results_scrape[i].gameID == it->gameID) {
-                        results_scrape[i].box3DUrl = it->box3DUrl;
-                        results_scrape[i].backcoverUrl = it->backcoverUrl;
-                        results_scrape[i].coverUrl = it->coverUrl;
-                        results_scrape[i].fanartUrl = it->fanartUrl;
-                        results_scrape[i].marqueeUrl = it->marqueeUrl;
-                        results_scrape[i].screenshotUrl = it->screenshotUrl;
-                        results_scrape[i].titlescreenUrl = it->titlescreenUrl;
-                        results_scrape[i].physicalmediaUrl = it->physicalmediaUrl;
-                        results_scrape[i].videoUrl = it->videoUrl;
-                        results_scrape[i].scraperRequestAllowance = it->scraperRequestAllowance;
-                        results_scrape[i].mediaURLFetch = COMPLETED;
-                    }
-                }
-            }
+            combineMediaURLs(results_scrape, results_media);
             onSearchDone(results_scrape);
         }
         else if (mMDRetrieveURLsHandle->status() == ASYNC_ERROR) {
@@ -18,6 +18,7 @@
 
 #include "GuiComponent.h"
 #include "MiximageGenerator.h"
+#include "ROMHashDatabase.h"
 #include "components/BusyComponent.h"
 #include "components/ComponentGrid.h"
 #include "scrapers/Scraper.h"
@@ -101,10 +102,15 @@ public:
 
     std::shared_ptr<ComponentList> getResultList() { return mResultList; }
 
+    // Used by the concurrent multi-scraper to show the most recently scraped game.
+    void displayResult(const ScraperSearchResult& result, FileData* game);
+    void setBusy(bool busy) { mBlockAccept = busy; }
+
 private:
     void updateView();
     void updateThumbnail();
     void updateInfoPane();
+    void updateMetadata(const ScraperSearchResult& result);
     void resizeMetadata();
 
     void onSearchError(const std::string& error,
@@ -116,7 +122,12 @@ private:
 
     void calculateMD5Hash(std::string path)
     {
-        mMD5Hash = Utils::Math::md5Hash(path, true);
+        // The CRC32 and SHA1 hashes are calculated in the same pass and are also stored in the
+        // database, so this returns immediately if the file was previously hashed.
+        const ROMHashDatabase::Hashes hashes {ROMHashDatabase::getInstance().getHashes(path)};
+        mMD5Hash = hashes.md5;
+        mCRC32Hash = hashes.crc32;
+        mSHA1Hash = hashes.sha1;
         mMD5HashPromise.set_value(true);
     }
 
@@ -193,6 +204,8 @@ private:
     std::map<std::string, std::unique_ptr<HttpReq>> mThumbnailReqMap;
 
     std::string mMD5Hash;
+    std::string mCRC32Hash;
+    std::string mSHA1Hash;
     std::thread mCalculateMD5HashThread;
     std::promise<bool> mMD5HashPromise;
     std::future<bool> mMD5HashFuture;
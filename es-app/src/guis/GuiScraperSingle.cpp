@@ -11,6 +11,7 @@
 #include "guis/GuiScraperSingle.h"
 
 #include "FileData.h"
+#include "HttpCache.h"
 #include "MameNames.h"
 #include "SystemData.h"
 #include "components/ButtonComponent.h"
@@ -110,6 +111,7 @@ GuiScraperSingle::GuiScraperSingle(ScraperSearchParams& params,
 
     mSearch->setAcceptCallback([this, doneFunc](const ScraperSearchResult& result) {
         doneFunc(result);
+        HttpCache::getInstance().saveIndex();
         close();
     });
     mSearch->setCancelCallback([&] { delete this; });
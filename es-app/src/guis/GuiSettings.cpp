@@ -92,8 +92,10 @@ void GuiSettings::save()
                 (*it)->sortSystem(true);
 
             // Jump to the first row of the gamelist.
-            GamelistView* gameList {ViewController::getInstance()->getGamelistView((*it)).get()};
-            gameList->setCursor(gameList->getFirstEntry());
+            GamelistView* gameList {
+                ViewController::getInstance()->getGamelistViewIfExists((*it)).get()};
+            if (gameList != nullptr)
+                gameList->setCursor(gameList->getFirstEntry());
         }
     }
 
@@ -499,8 +499,19 @@ void applicationLoop()
 #if !defined(__EMSCRIPTEN__)
     while (true) {
 #endif
-        if (SDL_PollEvent(&event)) {
+#if defined(__EMSCRIPTEN__)
+        const int idleWaitTime {0};
+#else
+        // If nothing on screen is changing then block until there is any input, or until
+        // it's time to update the window again.
+        const int idleWaitTime {window->getIdleWaitTime()};
+#endif
+        if (idleWaitTime > 0 ? SDL_WaitEventTimeout(&event, idleWaitTime) :
+                               SDL_PollEvent(&event)) {
             do {
+                // Any event could change what's on screen, and window events such as
+                // exposure may require the contents to be redrawn.
+                window->requestRedraw();
 #if defined(__ANDROID__)
                 // Prevent that button presses get registered immediately when entering the
                 // foreground (which most commonly mean we're returning from a game).
@@ -543,9 +554,12 @@ void applicationLoop()
         }
 #endif
         window->update(deltaTime);
-        window->render();
 
-        renderer->swapBuffers();
+        if (!window->isIdle()) {
+            window->render();
+            renderer->swapBuffers();
+        }
+
         Log::flush();
 #if !defined(__EMSCRIPTEN__)
     }
@@ -1246,6 +1260,7 @@ int main(int argc, char* argv[])
     window->deinit();
 
     TextureResource::setExit();
+    ViewController::getInstance()->deinit();
     CollectionSystemsManager::getInstance()->deinit(true);
     SystemData::deleteSystems();
     NavigationSounds::getInstance().deinit();
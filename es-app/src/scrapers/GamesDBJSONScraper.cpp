@@ -159,7 +159,7 @@ void thegamesdb_generate_json_scraper_requests(
     std::vector<ScraperSearchResult>& results)
 {
     resources.prepare();
-    std::string path {"https://api.thegamesdb.net/v1"};
+    std::string path {resources.getApiUrlBase()};
     bool usingGameID {false};
     const std::string apiKey {std::string("apikey=") + resources.getApiKey()};
     std::string cleanName {params.nameOverride};
@@ -255,7 +255,7 @@ void thegamesdb_generate_json_scraper_requests(
     std::vector<ScraperSearchResult>& results)
 {
     resources.prepare();
-    std::string path {"https://api.thegamesdb.net/v1"};
+    std::string path {resources.getApiUrlBase()};
     const std::string apiKey {std::string("apikey=") + resources.getApiKey()};
 
     path.append("/Games/Images/GamesImages?").append(apiKey).append("&games_id=").append(gameIDs);
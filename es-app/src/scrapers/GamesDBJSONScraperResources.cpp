@@ -19,6 +19,7 @@
 #include "scrapers/GamesDBJSONScraperResources.h"
 
 #include "Log.h"
+#include "Settings.h"
 #include "utils/FileSystemUtil.h"
 
 #include "rapidjson/document.h"
@@ -33,6 +34,7 @@ using namespace rapidjson;
 
 namespace
 {
+    constexpr char GamesDBAPIURLBase[] {"https://api.thegamesdb.net/v1"};
     constexpr char GamesDBAPIKey[] {
         "e42de8fb0cdcea89fec60f70cd565122f34f5c6228be3e9ae247ba409779d9d5"};
 
@@ -69,6 +71,18 @@ std::string getScrapersResouceDir()
 
 std::string TheGamesDBJSONRequestResources::getApiKey() const { return GamesDBAPIKey; }
 
+std::string TheGamesDBJSONRequestResources::getApiUrlBase() const
+{
+    std::string server {Settings::getInstance()->getString("ScraperServerTheGamesDB")};
+    if (server == "")
+        return GamesDBAPIURLBase;
+
+    while (server.size() > 1 && server.back() == '/')
+        server.pop_back();
+
+    return server;
+}
+
 void TheGamesDBJSONRequestResources::prepare()
 {
     if (checkLoaded())
@@ -154,7 +168,7 @@ bool TheGamesDBJSONRequestResources::saveResource(HttpReq* req,
 
 std::unique_ptr<HttpReq> TheGamesDBJSONRequestResources::fetchResource(const std::string& endpoint)
 {
-    std::string path {"https://api.thegamesdb.net/v1"};
+    std::string path {getApiUrlBase()};
     path.append(endpoint).append("?apikey=").append(getApiKey());
 
     return std::unique_ptr<HttpReq>(new HttpReq(path, true));
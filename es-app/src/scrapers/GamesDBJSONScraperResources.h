@@ -28,6 +28,9 @@ struct TheGamesDBJSONRequestResources {
     void prepare();
     void ensureResources();
     std::string getApiKey() const;
+    // Returns the address of the API, which can be changed using the ScraperServerTheGamesDB
+    // setting, for instance to test against a local server.
+    std::string getApiUrlBase() const;
 
     std::unordered_map<int, std::string> gamesdb_new_developers_map;
     std::unordered_map<int, std::string> gamesdb_new_publishers_map;
@@ -4,7 +4,7 @@
 //  Scraper.cpp
 //
 //  Main scraper logic.
-//  Called from GuiScraperSearch.
+//  Called from GuiScraperSearch and ScraperPipeline.
 //  Calls either GamesDBJSONScraper or ScreenScraper.
 //
 
@@ -13,6 +13,7 @@
 #include "FileData.h"
 #include "GamesDBJSONScraper.h"
 #include "Log.h"
+#include "MediaDirectoryIndex.h"
 #include "ScreenScraper.h"
 #include "Settings.h"
 #include "SystemData.h"
@@ -23,6 +24,7 @@
 #endif
 
 #include <FreeImage.h>
+#include <chrono>
 #include <cmath>
 #include <fstream>
 
@@ -88,6 +90,28 @@ std::unique_ptr<ScraperSearchHandle> startMediaURLsFetch(const std::string& game
     return handle;
 }
 
+void combineMediaURLs(std::vector<ScraperSearchResult>& results,
+                      const std::vector<ScraperSearchResult>& mediaResults)
+{
+    for (auto it = mediaResults.cbegin(); it != mediaResults.cend(); ++it) {
+        for (unsigned int i = 0; i < results.size(); ++i) {
+            if (results[i].gameID == it->gameID) {
+                results[i].box3DUrl = it->box3DUrl;
+                results[i].backcoverUrl = it->backcoverUrl;
+                results[i].coverUrl = it->coverUrl;
+                results[i].fanartUrl = it->fanartUrl;
+                results[i].marqueeUrl = it->marqueeUrl;
+                results[i].screenshotUrl = it->screenshotUrl;
+                results[i].titlescreenUrl = it->titlescreenUrl;
+                results[i].physicalmediaUrl = it->physicalmediaUrl;
+                results[i].videoUrl = it->videoUrl;
+                results[i].scraperRequestAllowance = it->scraperRequestAllowance;
+                results[i].mediaURLFetch = COMPLETED;
+            }
+        }
+    }
+}
+
 std::vector<std::string> getScraperList()
 {
     std::vector<std::string> list;
@@ -319,8 +343,10 @@ MDResolveHandle::MDResolveHandle(const ScraperSearchResult& result,
             // This avoids the problem where there's already a file for this media type
             // with a different format/extension (e.g. game.jpg and we're going to write
             // game.png) which would lead to two media files for this game.
-            if (it->existingMediaFile != "")
+            if (it->existingMediaFile != "") {
                 Utils::FileSystem::removeFile(it->existingMediaFile);
+                MediaDirectoryIndex::getInstance().removeFile(it->existingMediaFile);
+            }
 
             // If the media directory does not exist, something is wrong, possibly permission
             // problems or the MediaDirectory setting points to a file instead of a directory.
@@ -352,6 +378,8 @@ MDResolveHandle::MDResolveHandle(const ScraperSearchResult& result,
                 return;
             }
 
+            MediaDirectoryIndex::getInstance().addFile(filePath);
+
             // Resize it.
             if (it->resizeFile) {
                 if (!resizeImage(filePath, it->subDirectory)) {
@@ -422,8 +450,41 @@ MediaDownloadHandle::MediaDownloadHandle(const std::string& url,
     mSavedNewMediaPtr = &savedNewMedia;
 }
 
+MediaDownloadHandle::~MediaDownloadHandle()
+{
+    // We always let the save thread complete, otherwise partially written files could be
+    // left behind.
+    if (mSaveThread.joinable())
+        mSaveThread.join();
+}
+
 void MediaDownloadHandle::update()
 {
+    // This seems to take care of a strange race condition where the media saving and
+    // resizing would sometimes take place twice.
+    if (mStatus == ASYNC_DONE || mStatus == ASYNC_ERROR)
+        return;
+
+    if (mSaveFuture.valid()) {
+        // Only wait one millisecond as this update() function runs very frequently.
+        if (mSaveFuture.wait_for(std::chrono::milliseconds(1)) != std::future_status::ready)
+            return;
+
+        mSaveThread.join();
+
+        if (!mSaveFuture.get()) {
+            setError(mSaveError, false);
+            return;
+        }
+
+        MediaDirectoryIndex::getInstance().addFile(mSavePath);
+
+        // If this media file was successfully saved, update savedNewMedia in ScraperSearchResult.
+        *mSavedNewMediaPtr = true;
+        setStatus(ASYNC_DONE);
+        return;
+    }
+
     if (mReq->status() == HttpReq::REQ_IN_PROGRESS)
         return;
 
@@ -434,11 +495,6 @@ void MediaDownloadHandle::update()
         return;
     }
 
-    // This seems to take care of a strange race condition where the media saving and
-    // resizing would sometimes take place twice.
-    if (mStatus == ASYNC_DONE)
-        return;
-
     // Download is done, save it to disk.
 
     // There are multiple issues with box back covers at ScreenScraper. Some only contain a single
@@ -518,8 +574,10 @@ void MediaDownloadHandle::update()
     // This avoids the problem where there's already a file for this media type
     // with a different format/extension (e.g. game.jpg and we're going to write
     // game.png) which would lead to two media files for this game.
-    if (mExistingMediaFile != "")
+    if (mExistingMediaFile != "") {
         Utils::FileSystem::removeFile(mExistingMediaFile);
+        MediaDirectoryIndex::getInstance().removeFile(mExistingMediaFile);
+    }
 
     // If the media directory does not exist, something is wrong, possibly permission
     // problems or the MediaDirectory setting points to a file instead of a directory.
@@ -531,25 +589,6 @@ void MediaDownloadHandle::update()
         return;
     }
 
-#if defined(_WIN64)
-    std::ofstream stream(Utils::String::stringToWideString(mSavePath).c_str(),
-                         std::ios_base::out | std::ios_base::binary);
-#else
-    std::ofstream stream(mSavePath, std::ios_base::out | std::ios_base::binary);
-#endif
-    if (!stream || stream.bad()) {
-        setError("Failed to open path for writing media file\nPermission error?", false);
-        return;
-    }
-
-    const std::string& content {mReq->getContent()};
-    stream.write(content.data(), content.length());
-    stream.close();
-    if (stream.bad()) {
-        setError("Failed to save media file\nDisk full?", false);
-        return;
-    }
-
     if (mMediaType == "manuals") {
 #if defined(_WIN64)
         LOG(LogDebug) << "Scraper::update(): Saving game manual \""
@@ -567,18 +606,44 @@ void MediaDownloadHandle::update()
 #endif
     }
 
+    // Writing and resizing large images can take a noticeable amount of time, so this is
+    // done in a separate thread to not block the user interface or any parallel downloads.
+    mSaveFuture = mSavePromise.get_future();
+    mSaveThread = std::thread(&MediaDownloadHandle::saveMediaFile, this, mReq->getContent());
+}
+
+void MediaDownloadHandle::saveMediaFile(std::string content)
+{
+#if defined(_WIN64)
+    std::ofstream stream(Utils::String::stringToWideString(mSavePath).c_str(),
+                         std::ios_base::out | std::ios_base::binary);
+#else
+    std::ofstream stream(mSavePath, std::ios_base::out | std::ios_base::binary);
+#endif
+    if (!stream || stream.bad()) {
+        mSaveError = "Failed to open path for writing media file\nPermission error?";
+        mSavePromise.set_value(false);
+        return;
+    }
+
+    stream.write(content.data(), content.length());
+    stream.close();
+    if (stream.bad()) {
+        mSaveError = "Failed to save media file\nDisk full?";
+        mSavePromise.set_value(false);
+        return;
+    }
+
     // Resize it.
     if (mResizeFile) {
         if (!resizeImage(mSavePath, mMediaType)) {
-            setError("Error saving resized image\nOut of memory? Disk full?", false);
+            mSaveError = "Error saving resized image\nOut of memory? Disk full?";
+            mSavePromise.set_value(false);
             return;
         }
     }
 
-    // If this media file was successfully saved, update savedNewMedia in ScraperSearchResult.
-    *mSavedNewMediaPtr = true;
-
-    setStatus(ASYNC_DONE);
+    mSavePromise.set_value(true);
 }
 
 bool resizeImage(const std::string& path, const std::string& mediaType)
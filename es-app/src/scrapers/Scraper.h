@@ -4,7 +4,7 @@
 //  Scraper.h
 //
 //  Main scraper logic.
-//  Called from GuiScraperSearch.
+//  Called from GuiScraperSearch and ScraperPipeline.
 //  Calls either GamesDBJSONScraper or ScreenScraper.
 //
 
@@ -18,8 +18,10 @@
 
 #include <assert.h>
 #include <functional>
+#include <future>
 #include <memory>
 #include <queue>
+#include <thread>
 #include <utility>
 
 #define MAX_SCRAPER_RESULTS 7
@@ -37,6 +39,8 @@ struct ScraperSearchParams {
     SystemData* system;
     FileData* game;
     std::string md5Hash;
+    std::string crc32Hash;
+    std::string sha1Hash;
     long fileSize;
 
     std::string nameOverride;
@@ -53,6 +57,7 @@ struct ScraperSearchResult {
     ScraperSearchResult()
         : mdl(GAME_METADATA)
         , scraperRequestAllowance {0}
+        , scraperMaxThreads {0}
         , mediaURLFetch {NOT_STARTED}
         , thumbnailDownloadStatus {NOT_STARTED}
         , mediaFilesDownloadStatus {NOT_STARTED}
@@ -69,6 +74,10 @@ struct ScraperSearchResult {
     // within a given time period.
     unsigned int scraperRequestAllowance;
 
+    // How many parallel requests the scraper service allows for the account in use,
+    // or zero if this is unknown.
+    unsigned int scraperMaxThreads;
+
     enum downloadStatus mediaURLFetch;
     enum downloadStatus thumbnailDownloadStatus;
     enum downloadStatus mediaFilesDownloadStatus;
@@ -157,6 +166,10 @@ std::unique_ptr<ScraperSearchHandle> startScraperSearch(const ScraperSearchParam
 
 std::unique_ptr<ScraperSearchHandle> startMediaURLsFetch(const std::string& gameIDs);
 
+// Combines the initial scrape results with the media URLs returned by startMediaURLsFetch().
+void combineMediaURLs(std::vector<ScraperSearchResult>& results,
+                      const std::vector<ScraperSearchResult>& mediaResults);
+
 // Returns a list of valid scraper names.
 std::vector<std::string> getScraperList();
 
@@ -200,11 +213,19 @@ public:
                         const std::string& mediaType,
                         const bool resizeFile,
                         bool& savedNewMedia);
+    ~MediaDownloadHandle();
 
     void update() override;
 
 private:
+    // Writes the downloaded file to disk and resizes it, runs in a separate thread.
+    void saveMediaFile(std::string content);
+
     std::unique_ptr<HttpReq> mReq;
+    std::thread mSaveThread;
+    std::promise<bool> mSavePromise;
+    std::future<bool> mSaveFuture;
+    std::string mSaveError;
     std::string mSavePath;
     std::string mExistingMediaFile;
     std::string mMediaType;
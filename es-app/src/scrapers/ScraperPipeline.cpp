@@ -0,0 +1,385 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  ScraperPipeline.cpp
+//
+//  Scrapes multiple games concurrently when running the multi-scraper in automatic mode.
+//  Each game passes through the file hashing, search, media URL retrieval, media download
+//  and miximage generation stages independently of the other games in flight.
+//  Called from GuiScraperMulti.
+//
+
+#include "scrapers/ScraperPipeline.h"
+
+#include "FileData.h"
+#include "Log.h"
+#include "ROMHashDatabase.h"
+#include "Settings.h"
+#include "resources/TextureResource.h"
+#include "utils/FileSystemUtil.h"
+#include "utils/MathUtil.h"
+#include "utils/StringUtil.h"
+#include "views/ViewController.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+    // Upper limit regardless of what the scraper service would allow.
+    const unsigned int maxConcurrentGames {16};
+} // namespace
+
+ScraperPipeline::ScraperPipeline(std::queue<ScraperSearchParams>& searchQueue)
+    : mSearchQueue {searchQueue}
+    , mFailedJob {nullptr}
+    , mMaxThreads {0}
+    , mCompletedGames {0}
+    , mRetryTimer {glm::clamp(Settings::getInstance()->getInt("ScraperRetryOnErrorTimer") * 1000,
+                              1000, 30000)}
+    , mElapsedTime {0}
+{
+    if (!mSearchQueue.empty())
+        mLastStarted = mSearchQueue.front();
+
+    // Hash the files ahead of time in the background so that most games can be searched
+    // using the stored hashes. The first game is skipped as it's started right away.
+    if (!Settings::getInstance()->getBool("ScraperSearchFileHash") ||
+        Settings::getInstance()->getString("Scraper") != "screenscraper")
+        return;
+
+    std::vector<std::string> hashPaths;
+    std::queue<ScraperSearchParams> hashQueue {mSearchQueue};
+
+    if (!hashQueue.empty())
+        hashQueue.pop();
+
+    while (!hashQueue.empty()) {
+        const std::string& path {hashQueue.front().game->getPath()};
+        if (!Utils::FileSystem::isDirectory(path) &&
+            useFileHashSearch(Utils::FileSystem::getFileSize(path)))
+            hashPaths.emplace_back(path);
+        hashQueue.pop();
+    }
+
+    ROMHashDatabase::getInstance().queueFiles(hashPaths);
+}
+
+ScraperPipeline::~ScraperPipeline()
+{
+    for (auto& job : mJobs) {
+        // Resetting the handles before the threads are joined cancels any ongoing downloads.
+        job->searchHandle.reset();
+        job->resolveHandle.reset();
+
+        // This is required to properly refresh the gamelist view if the scraping was aborted
+        // while the miximage was getting generated.
+        if (job->stage == GENERATING_MIXIMAGE && job->thread.joinable()) {
+            job->thread.join();
+            TextureResource::manualUnload(job->params.game->getMiximagePath(), false);
+            ViewController::getInstance()->onFileChanged(job->params.game, true);
+        }
+    }
+
+    mJobs.clear();
+
+    ROMHashDatabase::getInstance().stopHashing();
+    ROMHashDatabase::getInstance().saveIndex();
+}
+
+void ScraperPipeline::update(int deltaTime)
+{
+    // Everything is on hold until the user has decided what to do with the failed game.
+    if (mFailedJob != nullptr)
+        return;
+
+    mElapsedTime += deltaTime;
+
+    for (auto it = mJobs.begin(); it != mJobs.end();) {
+        if (updateJob(it->get(), deltaTime)) {
+            it = mJobs.erase(it);
+            continue;
+        }
+        if (mFailedJob != nullptr)
+            return;
+        ++it;
+    }
+
+    while (!mSearchQueue.empty() && mJobs.size() < getConcurrencyLimit()) {
+        mJobs.emplace_back(std::make_unique<Job>(mSearchQueue.front()));
+        mLastStarted = mSearchQueue.front();
+        mSearchQueue.pop();
+        startJob(mJobs.back().get());
+    }
+}
+
+void ScraperPipeline::retryFailed()
+{
+    if (mFailedJob == nullptr)
+        return;
+
+    mFailedJob->retryCount = 0;
+    startJob(mFailedJob);
+    mFailedJob = nullptr;
+}
+
+void ScraperPipeline::skipFailed()
+{
+    if (mFailedJob == nullptr)
+        return;
+
+    ScraperSearchParams params {mFailedJob->params};
+
+    for (auto it = mJobs.begin(); it != mJobs.end(); ++it) {
+        if (it->get() == mFailedJob) {
+            mJobs.erase(it);
+            break;
+        }
+    }
+
+    mFailedJob = nullptr;
+    ++mCompletedGames;
+    mSkipCallback(params);
+}
+
+float ScraperPipeline::getGamesPerMinute() const
+{
+    if (mElapsedTime == 0)
+        return 0.0f;
+
+    return static_cast<float>(mCompletedGames) / (static_cast<float>(mElapsedTime) / 60000.0f);
+}
+
+unsigned int ScraperPipeline::getConcurrencyLimit() const
+{
+    if (Settings::getInstance()->getString("Scraper") == "screenscraper") {
+        // Until the first response has been received we don't know how many threads the
+        // account is allowed to use, and the server does not always include this information.
+        const unsigned int maxThreads {
+            mMaxThreads == 0 ? 1 : std::min(mMaxThreads, maxConcurrentGames)};
+        const int concurrency {Settings::getInstance()->getInt("ScraperConcurrencyScreenScraper")};
+        if (concurrency <= 0)
+            return maxThreads;
+        return std::min(static_cast<unsigned int>(concurrency), maxThreads);
+    }
+
+    return static_cast<unsigned int>(
+        glm::clamp(Settings::getInstance()->getInt("ScraperConcurrencyTheGamesDB"), 1,
+                   static_cast<int>(maxConcurrentGames)));
+}
+
+void ScraperPipeline::startJob(Job* job)
+{
+    ScraperSearchParams& params {job->params};
+
+    job->searchHandle.reset();
+    job->resolveHandle.reset();
+    job->results.clear();
+    job->result = {};
+    job->retryAccumulator = 0;
+
+    // For ScreenScraper we always want to use the jeuInfos (single-game) API call when in
+    // automatic mode, see GuiScraperSearch::search() for the details.
+    params.automaticMode = true;
+    params.md5Hash = "";
+    params.crc32Hash = "";
+    params.sha1Hash = "";
+    if (!Utils::FileSystem::isDirectory(params.game->getPath()))
+        params.fileSize = Utils::FileSystem::getFileSize(params.game->getPath());
+
+    if (useFileHashSearch(params.fileSize)) {
+        std::promise<bool>().swap(job->promise);
+        job->future = job->promise.get_future();
+        job->stage = HASHING;
+        job->thread = std::thread(&ScraperPipeline::calculateMD5Hash, job);
+        return;
+    }
+
+    job->stage = SEARCHING;
+    job->searchHandle = startScraperSearch(params);
+}
+
+bool ScraperPipeline::updateJob(Job* job, int deltaTime)
+{
+    switch (job->stage) {
+        case HASHING: {
+            // Only wait one millisecond as this update() function runs very frequently.
+            if (job->future.wait_for(std::chrono::milliseconds(1)) != std::future_status::ready)
+                return false;
+            job->thread.join();
+            job->stage = SEARCHING;
+            job->searchHandle = startScraperSearch(job->params);
+            return false;
+        }
+        case SEARCHING:
+        case FETCHING_MEDIA_URLS: {
+            const AsyncHandleStatus status {job->searchHandle->status()};
+            if (status == ASYNC_IN_PROGRESS)
+                return false;
+            if (status == ASYNC_ERROR) {
+                const std::string error {job->searchHandle->getStatusString()};
+                const bool retry {job->searchHandle->getRetry()};
+                job->searchHandle.reset();
+                onJobError(job, error, retry);
+                return false;
+            }
+
+            if (job->stage == SEARCHING) {
+                job->results = job->searchHandle->getResults();
+            }
+            else {
+                // Combine the intial scrape results with the media URL results.
+                combineMediaURLs(job->results, job->searchHandle->getResults());
+            }
+            job->searchHandle.reset();
+
+            if (!job->results.empty() && job->results.front().scraperMaxThreads > 0)
+                mMaxThreads = job->results.front().scraperMaxThreads;
+
+            if (job->results.empty()) {
+                LOG(LogDebug)
+                    << "ScraperPipeline::updateJob(): Scraper service did not return any results";
+                ++mCompletedGames;
+                mSkipCallback(job->params);
+                return true;
+            }
+
+            if (job->stage == SEARCHING && job->results.front().mediaURLFetch != COMPLETED) {
+                std::string gameIDs;
+                for (auto it = job->results.cbegin(); it != job->results.cend(); ++it)
+                    gameIDs += it->gameID + ',';
+
+                // Remove the last comma
+                gameIDs.pop_back();
+                job->stage = FETCHING_MEDIA_URLS;
+                job->searchHandle = startMediaURLsFetch(gameIDs);
+                return false;
+            }
+
+            onSearchDone(job);
+            return false;
+        }
+        case DOWNLOADING_MEDIA: {
+            const AsyncHandleStatus status {job->resolveHandle->status()};
+            if (status == ASYNC_IN_PROGRESS)
+                return false;
+            if (status == ASYNC_ERROR) {
+                const std::string error {job->resolveHandle->getStatusString()};
+                const bool retry {job->resolveHandle->getRetry()};
+                job->resolveHandle.reset();
+                onJobError(job, error, retry);
+                return false;
+            }
+
+            job->result = job->resolveHandle->getResult();
+            job->result.mediaFilesDownloadStatus = COMPLETED;
+            job->resolveHandle.reset();
+            onMediaDownloaded(job);
+            if (job->stage == GENERATING_MIXIMAGE)
+                return false;
+            break;
+        }
+        case GENERATING_MIXIMAGE: {
+            if (job->future.wait_for(std::chrono::milliseconds(1)) != std::future_status::ready)
+                return false;
+            job->thread.join();
+            if (!job->future.get())
+                job->result.savedNewMedia = true;
+            job->miximageGenerator.reset();
+            break;
+        }
+        case WAITING_FOR_RETRY: {
+            job->retryAccumulator += deltaTime;
+            if (job->retryAccumulator >= mRetryTimer)
+                startJob(job);
+            return false;
+        }
+        case FAILED: {
+            return false;
+        }
+    }
+
+    ++mCompletedGames;
+    mAcceptCallback(job->params, job->result);
+    return true;
+}
+
+void ScraperPipeline::onSearchDone(Job* job)
+{
+    size_t gameEntry {0};
+
+    if (job->params.md5Hash != "") {
+        for (size_t i {0}; i < job->results.size(); ++i) {
+            if (job->results[i].md5Hash == job->params.md5Hash) {
+                LOG(LogDebug) << "ScraperPipeline::onSearchDone(): Perfect match, MD5 digest in "
+                                 "server response identical to file hash";
+                gameEntry = i;
+                break;
+            }
+        }
+    }
+
+    job->result = job->results[gameEntry];
+    job->result.mediaFilesDownloadStatus = IN_PROGRESS;
+    LOG(LogDebug) << "ScraperPipeline::onSearchDone(): Resolving metadata for \""
+                  << job->result.mdl.get("name") << "\", game ID \"" << job->result.gameID << "\"";
+    job->stage = DOWNLOADING_MEDIA;
+    job->resolveHandle = resolveMetaDataAssets(job->result, job->params);
+}
+
+void ScraperPipeline::onMediaDownloaded(Job* job)
+{
+    if (!Settings::getInstance()->getBool("MiximageGenerate"))
+        return;
+
+    if (job->params.game->getMiximagePath() != "" &&
+        !Settings::getInstance()->getBool("MiximageOverwrite"))
+        return;
+
+    job->miximageGenerator =
+        std::make_unique<MiximageGenerator>(job->params.game, job->resultMessage);
+
+    std::promise<bool>().swap(job->promise);
+    job->future = job->promise.get_future();
+    job->stage = GENERATING_MIXIMAGE;
+    job->thread = std::thread(&MiximageGenerator::startThread, job->miximageGenerator.get(),
+                              &job->promise);
+}
+
+void ScraperPipeline::onJobError(Job* job, const std::string& error, const bool retry)
+{
+    LOG(LogError) << "ScraperPipeline: " << Utils::String::replace(error, "\n", "");
+
+    const int retries {
+        glm::clamp(Settings::getInstance()->getInt("ScraperRetryOnErrorCount"), 0, 10)};
+    if (retry && retries > 0 && job->retryCount < retries) {
+        ++job->retryCount;
+        LOG(LogInfo) << "ScraperPipeline: Attempting automatic retry " << job->retryCount
+                     << " of " << retries;
+        job->retryAccumulator = 0;
+        job->stage = WAITING_FOR_RETRY;
+        return;
+    }
+
+    job->stage = FAILED;
+    mFailedJob = job;
+    mErrorCallback(error);
+}
+
+bool ScraperPipeline::useFileHashSearch(const long fileSize)
+{
+    return Settings::getInstance()->getBool("ScraperSearchFileHash") &&
+           Settings::getInstance()->getString("Scraper") == "screenscraper" && fileSize != 0 &&
+           fileSize <=
+               Settings::getInstance()->getInt("ScraperSearchFileHashMaxSize") * 1024 * 1024;
+}
+
+void ScraperPipeline::calculateMD5Hash(Job* job)
+{
+    const ROMHashDatabase::Hashes hashes {
+        ROMHashDatabase::getInstance().getHashes(job->params.game->getPath())};
+    job->params.md5Hash = hashes.md5;
+    job->params.crc32Hash = hashes.crc32;
+    job->params.sha1Hash = hashes.sha1;
+    job->promise.set_value(true);
+}
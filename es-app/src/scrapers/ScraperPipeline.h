@@ -0,0 +1,135 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  ScraperPipeline.h
+//
+//  Scrapes multiple games concurrently when running the multi-scraper in automatic mode.
+//  Each game passes through the file hashing, search, media URL retrieval, media download
+//  and miximage generation stages independently of the other games in flight.
+//  Called from GuiScraperMulti.
+//
+
+#ifndef ES_APP_SCRAPERS_SCRAPER_PIPELINE_H
+#define ES_APP_SCRAPERS_SCRAPER_PIPELINE_H
+
+#include "MiximageGenerator.h"
+#include "scrapers/Scraper.h"
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <queue>
+#include <thread>
+#include <vector>
+
+class ScraperPipeline
+{
+public:
+    ScraperPipeline(std::queue<ScraperSearchParams>& searchQueue);
+    ~ScraperPipeline();
+
+    void update(int deltaTime);
+
+    // Called when a game has been scraped and all its media files have been downloaded.
+    void setAcceptCallback(
+        const std::function<void(ScraperSearchParams&, const ScraperSearchResult&)>& callback)
+    {
+        mAcceptCallback = callback;
+    }
+    // Called when no matching game was found.
+    void setSkipCallback(const std::function<void(ScraperSearchParams&)>& callback)
+    {
+        mSkipCallback = callback;
+    }
+    // Called when all automatic retries have failed, the pipeline is then paused until
+    // either retryFailed() or skipFailed() is called.
+    void setErrorCallback(const std::function<void(const std::string&)>& callback)
+    {
+        mErrorCallback = callback;
+    }
+
+    void retryFailed();
+    void skipFailed();
+
+    bool isFinished() const { return mSearchQueue.empty() && mJobs.empty(); }
+    unsigned int getJobCount() const { return static_cast<unsigned int>(mJobs.size()); }
+    // The system and game of the most recently started job.
+    const ScraperSearchParams& getLastStarted() const { return mLastStarted; }
+    float getGamesPerMinute() const;
+
+    // How many games can be in flight at the same time. For ScreenScraper this is limited
+    // to the number of threads allowed for the account, which is reported by the server.
+    unsigned int getConcurrencyLimit() const;
+
+private:
+    enum Stage {
+        HASHING,
+        SEARCHING,
+        FETCHING_MEDIA_URLS,
+        DOWNLOADING_MEDIA,
+        GENERATING_MIXIMAGE,
+        WAITING_FOR_RETRY,
+        FAILED
+    };
+
+    struct Job {
+        ScraperSearchParams params;
+        Stage stage;
+        std::vector<ScraperSearchResult> results;
+        ScraperSearchResult result;
+        std::unique_ptr<ScraperSearchHandle> searchHandle;
+        std::unique_ptr<MDResolveHandle> resolveHandle;
+
+        // Used both for the MD5 hash calculation and for the miximage generator.
+        std::thread thread;
+        std::promise<bool> promise;
+        std::future<bool> future;
+        std::unique_ptr<MiximageGenerator> miximageGenerator;
+        std::string resultMessage;
+
+        int retryCount;
+        int retryAccumulator;
+
+        Job(const ScraperSearchParams& searchParams)
+            : params {searchParams}
+            , stage {SEARCHING}
+            , retryCount {0}
+            , retryAccumulator {0}
+        {
+        }
+        ~Job()
+        {
+            // We always let the hashing and miximage generator threads complete.
+            if (thread.joinable())
+                thread.join();
+        }
+    };
+
+    void startJob(Job* job);
+    // Returns true if the job is complete and should be removed.
+    bool updateJob(Job* job, int deltaTime);
+    void onSearchDone(Job* job);
+    void onMediaDownloaded(Job* job);
+    // Schedules an automatic retry if possible, otherwise the pipeline is paused.
+    void onJobError(Job* job, const std::string& error, const bool retry);
+
+    // Whether a file of this size should be searched for using its hashes.
+    static bool useFileHashSearch(const long fileSize);
+    static void calculateMD5Hash(Job* job);
+
+    std::queue<ScraperSearchParams>& mSearchQueue;
+    std::vector<std::unique_ptr<Job>> mJobs;
+    Job* mFailedJob;
+    ScraperSearchParams mLastStarted;
+
+    std::function<void(ScraperSearchParams&, const ScraperSearchResult&)> mAcceptCallback;
+    std::function<void(ScraperSearchParams&)> mSkipCallback;
+    std::function<void(const std::string&)> mErrorCallback;
+
+    unsigned int mMaxThreads;
+    unsigned int mCompletedGames;
+    int mRetryTimer;
+    int mElapsedTime;
+};
+
+#endif // ES_APP_SCRAPERS_SCRAPER_PIPELINE_H
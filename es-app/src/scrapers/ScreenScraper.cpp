@@ -193,6 +193,8 @@ void screenscraper_generate_scraper_requests(const ScraperSearchParams& params,
     ScreenScraperRequest::ScreenScraperConfig ssConfig;
 
     ssConfig.automaticMode = params.automaticMode;
+    ssConfig.crc32Hash = params.crc32Hash;
+    ssConfig.sha1Hash = params.sha1Hash;
 
     if (params.game->isArcadeGame())
         ssConfig.isArcadeSystem = true;
@@ -361,6 +363,8 @@ void ScreenScraperRequest::processGame(const pugi::xml_document& xmldoc,
     unsigned requestsToday {data.child("ssuser").child("requeststoday").text().as_uint()};
     unsigned maxRequestsPerDay {data.child("ssuser").child("maxrequestsperday").text().as_uint()};
     unsigned int scraperRequestAllowance {maxRequestsPerDay - requestsToday};
+    // The number of parallel requests allowed for the account, used for multi-game scraping.
+    unsigned int scraperMaxThreads {data.child("ssuser").child("maxthreads").text().as_uint()};
 
     // Scraping allowance.
     if (maxRequestsPerDay > 0) {
@@ -381,6 +385,7 @@ void ScreenScraperRequest::processGame(const pugi::xml_document& xmldoc,
         ScreenScraperRequest::ScreenScraperConfig ssConfig;
 
         result.scraperRequestAllowance = scraperRequestAllowance;
+        result.scraperMaxThreads = scraperMaxThreads;
         result.gameID = game.attribute("id").as_string();
 
         std::string region {
@@ -751,6 +756,18 @@ int ScreenScraperRequest::processMedia(ScraperSearchResult& result,
     return regionPos;
 }
 
+std::string ScreenScraperRequest::ScreenScraperConfig::getApiUrlBase() const
+{
+    std::string server {Settings::getInstance()->getString("ScraperServerScreenScraper")};
+    if (server == "")
+        return API_URL_BASE;
+
+    while (server.size() > 1 && server.back() == '/')
+        server.pop_back();
+
+    return server;
+}
+
 std::string ScreenScraperRequest::ScreenScraperConfig::getGameSearchUrl(const std::string& gameName,
                                                                         const std::string& md5Hash,
                                                                         const long fileSize) const
@@ -836,7 +853,7 @@ std::string ScreenScraperRequest::ScreenScraperConfig::getGameSearchUrl(const st
     if (automaticMode || singleSearch) {
         if (Settings::getInstance()->getBool("ScraperAutomaticRemoveDots"))
             searchName = Utils::String::replace(searchName, ".", "");
-        screenScraperURL.append(API_URL_BASE)
+        screenScraperURL.append(getApiUrlBase())
             .append("/jeuInfos.php?devid=")
             .append(Utils::String::scramble(API_DEV_U, API_DEV_KEY))
             .append("&devpassword=")
@@ -851,10 +868,14 @@ std::string ScreenScraperRequest::ScreenScraperConfig::getGameSearchUrl(const st
                 .append(md5Hash)
                 .append("&romtaille=")
                 .append(std::to_string(fileSize));
+            if (crc32Hash != "")
+                screenScraperURL.append("&crc=").append(crc32Hash);
+            if (sha1Hash != "")
+                screenScraperURL.append("&sha1=").append(sha1Hash);
         }
     }
     else {
-        screenScraperURL.append(API_URL_BASE)
+        screenScraperURL.append(getApiUrlBase())
             .append("/jeuRecherche.php?devid=")
             .append(Utils::String::scramble(API_DEV_U, API_DEV_KEY))
             .append("&devpassword=")
@@ -45,6 +45,10 @@ public:
                                      const std::string& md5Hash,
                                      const long fileSize) const;
 
+        // Returns API_URL_BASE unless the ScraperServerScreenScraper setting has been used
+        // to point to a different server, such as a local test server.
+        std::string getApiUrlBase() const;
+
         // Access to the API.
         const std::string API_DEV_U = {15, 21, 39, 22, 42, 40};
         const std::string API_DEV_P = {32, 70, 46, 54, 12, 5, 13, 120, 50, 66, 25};
@@ -106,6 +110,9 @@ public:
 
         bool isArcadeSystem;
         bool automaticMode;
+        // Sent together with the MD5 hash to improve the chance of finding a match.
+        std::string crc32Hash;
+        std::string sha1Hash;
 
         // Which Region to use when selecting the artwork.
         // Applies to: artwork, name of the game, date of release.
@@ -15,6 +15,7 @@
 
 #include "CollectionSystemsManager.h"
 #include "FileFilterIndex.h"
+#include "MediaDirectoryIndex.h"
 #include "UIModeController.h"
 #include "guis/GuiGamelistOptions.h"
 #include "views/ViewController.h"
@@ -421,11 +422,9 @@ bool GamelistBase::input(InputConfig* config, Input input)
                     // was unmarked. We couldn't do this earlier as we didn't have the list
                     // sorted yet.
                     if (removedLastFavorite) {
-                        ViewController::getInstance()
-                            ->getGamelistView(entryToUpdate->getSystem())
-                            ->setCursor(ViewController::getInstance()
-                                            ->getGamelistView(entryToUpdate->getSystem())
-                                            ->getFirstEntry());
+                        if (auto view = ViewController::getInstance()->getGamelistViewIfExists(
+                                entryToUpdate->getSystem()))
+                            view->setCursor(view->getFirstEntry());
                     }
                     return true;
                 }
@@ -451,11 +450,9 @@ bool GamelistBase::input(InputConfig* config, Input input)
                     // Jump to the first entry in the gamelist if the last favorite was unmarked.
                     if (foldersOnTop && removedLastFavorite &&
                         !entryToUpdate->getSystem()->isCustomCollection()) {
-                        ViewController::getInstance()
-                            ->getGamelistView(entryToUpdate->getSystem())
-                            ->setCursor(ViewController::getInstance()
-                                            ->getGamelistView(entryToUpdate->getSystem())
-                                            ->getFirstGameEntry());
+                        if (auto entryView = ViewController::getInstance()->getGamelistViewIfExists(
+                                entryToUpdate->getSystem()))
+                            entryView->setCursor(entryView->getFirstGameEntry());
                     }
                     else if (removedLastFavorite &&
                              !entryToUpdate->getSystem()->isCustomCollection()) {
@@ -475,9 +472,9 @@ bool GamelistBase::input(InputConfig* config, Input input)
                     if (isEditing) {
                         for (auto it = SystemData::sSystemVector.begin();
                              it != SystemData::sSystemVector.end(); ++it) {
-                            ViewController::getInstance()->getGamelistView((*it))->onFileChanged(
-                                ViewController::getInstance()->getGamelistView((*it))->getCursor(),
-                                false);
+                            if (auto systemView =
+                                    ViewController::getInstance()->getGamelistViewIfExists((*it)))
+                                systemView->onFileChanged(systemView->getCursor(), false);
                         }
                     }
                     return true;
@@ -626,6 +623,7 @@ void GamelistBase::remove(FileData* game, bool deleteFile)
     parent->getSystem()->writeMetaData();
 
     // Remove before repopulating (removes from parent), then update the view.
+    FileFilterIndex::removeFromSystemIndexes(game);
     delete game;
 
     if (deleteFile) {
@@ -666,6 +664,7 @@ void GamelistBase::removeMedia(FileData* game)
         path = game->getVideoPath();
         if (!Utils::FileSystem::removeFile(path))
             break;
+        MediaDirectoryIndex::getInstance().removeFile(path);
         removeEmptyDirFunc(systemMediaDir, mediaType, path);
     }
 
@@ -674,6 +673,7 @@ void GamelistBase::removeMedia(FileData* game)
         path = game->getManualPath();
         if (!Utils::FileSystem::removeFile(path))
             break;
+        MediaDirectoryIndex::getInstance().removeFile(path);
         removeEmptyDirFunc(systemMediaDir, mediaType, path);
     }
 
@@ -682,6 +682,7 @@ void GamelistBase::removeMedia(FileData* game)
         path = game->getMiximagePath();
         if (!Utils::FileSystem::removeFile(path))
             break;
+        MediaDirectoryIndex::getInstance().removeFile(path);
         removeEmptyDirFunc(systemMediaDir, mediaType, path);
     }
 
@@ -690,6 +691,7 @@ void GamelistBase::removeMedia(FileData* game)
         path = game->getScreenshotPath();
         if (!Utils::FileSystem::removeFile(path))
             break;
+        MediaDirectoryIndex::getInstance().removeFile(path);
         removeEmptyDirFunc(systemMediaDir, mediaType, path);
     }
 
@@ -698,6 +700,7 @@ void GamelistBase::removeMedia(FileData* game)
         path = game->getTitleScreenPath();
         if (!Utils::FileSystem::removeFile(path))
             break;
+        MediaDirectoryIndex::getInstance().removeFile(path);
         removeEmptyDirFunc(systemMediaDir, mediaType, path);
     }
 
@@ -706,6 +709,7 @@ void GamelistBase::removeMedia(FileData* game)
         path = game->getCoverPath();
         if (!Utils::FileSystem::removeFile(path))
             break;
+        MediaDirectoryIndex::getInstance().removeFile(path);
         removeEmptyDirFunc(systemMediaDir, mediaType, path);
     }
 
@@ -714,6 +718,7 @@ void GamelistBase::removeMedia(FileData* game)
         path = game->getBackCoverPath();
         if (!Utils::FileSystem::removeFile(path))
             break;
+        MediaDirectoryIndex::getInstance().removeFile(path);
         removeEmptyDirFunc(systemMediaDir, mediaType, path);
     }
 
@@ -722,6 +727,7 @@ void GamelistBase::removeMedia(FileData* game)
         path = game->getFanArtPath();
         if (!Utils::FileSystem::removeFile(path))
             break;
+        MediaDirectoryIndex::getInstance().removeFile(path);
         removeEmptyDirFunc(systemMediaDir, mediaType, path);
     }
 
@@ -730,6 +736,7 @@ void GamelistBase::removeMedia(FileData* game)
         path = game->getMarqueePath();
         if (!Utils::FileSystem::removeFile(path))
             break;
+        MediaDirectoryIndex::getInstance().removeFile(path);
         removeEmptyDirFunc(systemMediaDir, mediaType, path);
     }
 
@@ -738,6 +745,7 @@ void GamelistBase::removeMedia(FileData* game)
         path = game->get3DBoxPath();
         if (!Utils::FileSystem::removeFile(path))
             break;
+        MediaDirectoryIndex::getInstance().removeFile(path);
         removeEmptyDirFunc(systemMediaDir, mediaType, path);
     }
 
@@ -746,6 +754,7 @@ void GamelistBase::removeMedia(FileData* game)
         path = game->getPhysicalMediaPath();
         if (!Utils::FileSystem::removeFile(path))
             break;
+        MediaDirectoryIndex::getInstance().removeFile(path);
         removeEmptyDirFunc(systemMediaDir, mediaType, path);
     }
 }
@@ -9,8 +9,10 @@
 #include "views/GamelistView.h"
 
 #include "CollectionSystemsManager.h"
+#include "Scripting.h"
 #include "UIModeController.h"
 #include "animations/LambdaAnimation.h"
+#include "utils/FileSystemUtil.h"
 
 #define FADE_IN_START_OPACITY 0.5f
 #define FADE_IN_TIME 325
@@ -557,7 +559,7 @@ std::vector<HelpPrompt> GamelistView::getHelpPrompts()
     return prompts;
 }
 
-void GamelistView::updateView(const CursorState& state)
+void GamelistView::updateView(const CursorState& state, bool preload)
 {
     bool loadedTexture {false};
 
@@ -596,6 +598,12 @@ void GamelistView::updateView(const CursorState& state)
             hideMetaDataFields = true;
             mLastUpdated = nullptr;
         }
+        else if (!preload) {
+            Scripting::fireEvent("game-select", Utils::FileSystem::getEscapedPath(file->getPath()),
+                                 file->getSourceFileData()->metadata.get("name"),
+                                 file->getSourceFileData()->getSystem()->getName(),
+                                 file->getSourceFileData()->getSystem()->getFullName());
+        }
     }
 
     // If we're scrolling, hide the metadata fields if the last game had this options set,
@@ -25,7 +25,7 @@ public:
     void onShow() override;
     void onTransition() override;
 
-    void preloadGamelist() { updateView(CursorState::CURSOR_STOPPED); }
+    void preloadGamelist() { updateView(CursorState::CURSOR_STOPPED, true); }
     void launch(FileData* game) override { ViewController::getInstance()->triggerGameLaunch(game); }
 
     void startViewVideos() override
@@ -107,7 +107,8 @@ public:
     std::vector<HelpPrompt> getHelpPrompts() override;
 
 private:
-    void updateView(const CursorState& state);
+    // The game-select event is not fired when preloading as the view is not yet shown.
+    void updateView(const CursorState& state, bool preload = false);
     void setGameImage(FileData* file, GuiComponent* comp);
 
     Renderer* mRenderer;
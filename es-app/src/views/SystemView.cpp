@@ -9,6 +9,7 @@
 #include "views/SystemView.h"
 
 #include "Log.h"
+#include "Scripting.h"
 #include "Settings.h"
 #include "Sound.h"
 #include "UIModeController.h"
@@ -160,6 +161,41 @@ void SystemView::update(int deltaTime)
     GuiComponent::update(deltaTime);
 }
 
+bool SystemView::isAnimating()
+{
+    if (mPrimary == nullptr || mSystemElements.empty())
+        return GuiComponent::isAnimating();
+
+    if (mPrimary->isAnimating())
+        return true;
+
+    // As for update(), only the elements for the selected system need to be checked.
+    const SystemViewElements& elements {mSystemElements[mPrimary->getCursor()]};
+
+    for (auto& text : elements.textComponents) {
+        if (text->isAnimating())
+            return true;
+    }
+    for (auto& video : elements.videoComponents) {
+        if (video->isAnimating())
+            return true;
+    }
+    for (auto& anim : elements.lottieAnimComponents) {
+        if (anim->isAnimating())
+            return true;
+    }
+    for (auto& anim : elements.GIFAnimComponents) {
+        if (anim->isAnimating())
+            return true;
+    }
+    for (auto& container : elements.containerComponents) {
+        if (container->isAnimating())
+            return true;
+    }
+
+    return GuiComponent::isAnimating();
+}
+
 void SystemView::render(const glm::mat4& parentTrans)
 {
     if (mPrimary == nullptr)
@@ -310,6 +346,11 @@ void SystemView::onCursorChanged(const CursorState& state)
 
     mLastCursor = cursor;
 
+    if (state == CursorState::CURSOR_STOPPED) {
+        Scripting::fireEvent("system-select", mPrimary->getSelected()->getName(),
+                             mPrimary->getSelected()->getFullName());
+    }
+
     for (auto& video : mSystemElements[cursor].videoComponents)
         video->setStaticVideo();
 
@@ -44,6 +44,7 @@ public:
     bool input(InputConfig* config, Input input) override;
     void update(int deltaTime) override;
     void render(const glm::mat4& parentTrans) override;
+    bool isAnimating() override;
 
     bool isScrolling() { return mPrimary->isScrolling(); }
     void stopScrolling()
@@ -72,6 +73,7 @@ public:
                                         CarouselComponent<SystemData*>::CarouselType::NO_CAROUSEL;
     }
     SystemData* getFirstSystem() { return mPrimary->getFirst(); }
+    SystemData* getSelectedSystem() { return mPrimary->getSelected(); }
 
     void startViewVideos() override
     {
@@ -17,6 +17,7 @@
 #include "FileFilterIndex.h"
 #include "InputManager.h"
 #include "Log.h"
+#include "MediaDirectoryIndex.h"
 #include "Scripting.h"
 #include "Settings.h"
 #include "Sound.h"
@@ -34,6 +35,8 @@
 #include "views/GamelistView.h"
 #include "views/SystemView.h"
 
+#include <unordered_set>
+
 ViewController::ViewController() noexcept
     : mRenderer {Renderer::getInstance()}
     , mNoGamesMessageBox {nullptr}
@@ -41,6 +44,7 @@ ViewController::ViewController() noexcept
     , mPreviousView {nullptr}
     , mSkipView {nullptr}
     , mLastTransitionAnim {ViewTransitionAnimation::INSTANT}
+    , mGamelistViewsUseCounter {0}
     , mGameToLaunch {nullptr}
     , mCamera {Renderer::getIdentity()}
     , mSystemViewTransition {false}
@@ -903,14 +907,21 @@ void ViewController::removeGamelistView(SystemData* system)
         exists->second.reset();
         mGamelistViews.erase(system);
     }
+    mGamelistViewsLastUsed.erase(system);
+    mEvictedGamelistViews.erase(system);
 }
 
 std::shared_ptr<GamelistView> ViewController::getGamelistView(SystemData* system)
 {
+    const bool lazyGamelistViews {Settings::getInstance()->getInt("GamelistViewCacheSize") > 0};
+
     // If we have already created an entry for this system, then return that one.
     auto exists = mGamelistViews.find(system);
-    if (exists != mGamelistViews.cend())
+    if (exists != mGamelistViews.cend()) {
+        if (lazyGamelistViews)
+            mGamelistViewsLastUsed[system] = ++mGamelistViewsUseCounter;
         return exists->second;
+    }
 
     system->getIndex()->setKidModeFilters();
     // If there's no entry, then create it and return it.
@@ -1024,9 +1035,112 @@ std::shared_ptr<GamelistView> ViewController::getGamelistView(SystemData* system
     addChild(view.get());
 
     mGamelistViews[system] = view;
+
+    if (lazyGamelistViews) {
+        restoreGamelistViewState(system, view.get());
+        mGamelistViewsLastUsed[system] = ++mGamelistViewsUseCounter;
+        evictGamelistViews(system);
+    }
+
     return view;
 }
 
+std::shared_ptr<GamelistView> ViewController::getGamelistViewIfExists(SystemData* system)
+{
+    auto exists = mGamelistViews.find(system);
+    if (exists != mGamelistViews.cend())
+        return exists->second;
+
+    return nullptr;
+}
+
+void ViewController::evictGamelistViews(SystemData* requestedSystem)
+{
+    const size_t cacheSize {static_cast<size_t>(
+        glm::clamp(Settings::getInstance()->getInt("GamelistViewCacheSize"), 0, 1000))};
+
+    while (mGamelistViews.size() > cacheSize) {
+        auto evictIt = mGamelistViews.end();
+        unsigned int lastUsed {0};
+
+        // Views that are displayed or that are part of a transition are never removed.
+        for (auto it = mGamelistViews.begin(); it != mGamelistViews.end(); ++it) {
+            if (it->first == requestedSystem || it->second == mCurrentView ||
+                it->second == mPreviousView || it->second == mSkipView)
+                continue;
+            if (evictIt == mGamelistViews.end() || mGamelistViewsLastUsed[it->first] < lastUsed) {
+                evictIt = it;
+                lastUsed = mGamelistViewsLastUsed[it->first];
+            }
+        }
+
+        if (evictIt == mGamelistViews.end())
+            break;
+
+        LOG(LogDebug) << "ViewController::evictGamelistViews(): Removing gamelist view for \""
+                      << evictIt->first->getName() << "\"";
+
+        GamelistViewState& state {mEvictedGamelistViews[evictIt->first]};
+        state.cursor = evictIt->second->getCursor();
+        state.cursorHistory.clear();
+        evictIt->second->copyCursorHistory(state.cursorHistory);
+
+        mGamelistViewsLastUsed.erase(evictIt->first);
+        mGamelistViews.erase(evictIt);
+    }
+}
+
+void ViewController::restoreGamelistViewState(SystemData* system, GamelistView* view)
+{
+    auto stateIt = mEvictedGamelistViews.find(system);
+    if (stateIt == mEvictedGamelistViews.end())
+        return;
+
+    // Games may have been deleted since the view was removed, so make sure we don't attempt
+    // to set the cursor or the cursor history to any nonexistent entries.
+    const std::vector<FileData*> children {system->getRootFolder()->getChildrenRecursive()};
+    const std::unordered_set<FileData*> childrenSet {children.cbegin(), children.cend()};
+
+    std::vector<FileData*> cursorHistory;
+    for (auto entry : stateIt->second.cursorHistory) {
+        if (childrenSet.find(entry) != childrenSet.cend())
+            cursorHistory.emplace_back(entry);
+    }
+
+    if (childrenSet.find(stateIt->second.cursor) != childrenSet.cend())
+        view->setCursor(stateIt->second.cursor);
+    if (cursorHistory.size() == stateIt->second.cursorHistory.size())
+        view->populateCursorHistory(cursorHistory);
+
+    mEvictedGamelistViews.erase(stateIt);
+}
+
+void ViewController::prepareGamelistViews()
+{
+    const std::vector<SystemData*>& sysVec {SystemData::sSystemVector};
+    const int cacheSize {glm::clamp(Settings::getInstance()->getInt("GamelistViewCacheSize"), 0,
+                                    1000)};
+    auto selectedIt = std::find(sysVec.cbegin(), sysVec.cend(),
+                                mSystemListView->getSelectedSystem());
+
+    if (cacheSize == 0 || selectedIt == sysVec.cend())
+        return;
+
+    const int selected {static_cast<int>(selectedIt - sysVec.cbegin())};
+    const int systemCount {static_cast<int>(sysVec.size())};
+
+    // The selected system first, followed by the next and the previous systems.
+    for (int offset : {0, 1, -1}) {
+        if (std::abs(offset) * 2 + 1 > cacheSize)
+            break;
+        SystemData* system {sysVec[(selected + offset + systemCount) % systemCount]};
+        if (mGamelistViews.find(system) == mGamelistViews.cend()) {
+            getGamelistView(system)->preloadGamelist();
+            return;
+        }
+    }
+}
+
 std::shared_ptr<SystemView> ViewController::getSystemListView()
 {
     // If we have already created a system view entry, then return it.
@@ -1120,6 +1234,13 @@ void ViewController::update(int deltaTime)
     if (mCurrentView)
         mCurrentView->update(deltaTime);
 
+    // Create the gamelist views for the systems near the system view cursor position while
+    // the user is not navigating, so that entering a gamelist does not lead to a pause.
+    if (mSystemListView && mCurrentView == mSystemListView && !isCameraMoving() &&
+        !mSystemListView->isScrolling() &&
+        Settings::getInstance()->getInt("GamelistViewCacheSize") > 0)
+        prepareGamelistViews();
+
     updateSelf(deltaTime);
 
     if (mGameToLaunch) {
@@ -1128,6 +1249,14 @@ void ViewController::update(int deltaTime)
     }
 }
 
+bool ViewController::isAnimating()
+{
+    if (isCameraMoving() || (mCurrentView && mCurrentView->isAnimating()))
+        return true;
+
+    return GuiComponent::isAnimating();
+}
+
 void ViewController::render(const glm::mat4& parentTrans)
 {
     glm::mat4 trans {mCamera * parentTrans};
@@ -1189,11 +1318,27 @@ void ViewController::preload()
         getSystemListView();
 
     const bool splashScreen {Settings::getInstance()->getBool("SplashScreen")};
+    const bool lazyGamelistViews {Settings::getInstance()->getInt("GamelistViewCacheSize") > 0};
+    SystemData* startupSystem {nullptr};
     float loadedSystems {0.0f};
     unsigned int lastTime {0};
     unsigned int accumulator {0};
     SDL_Event event {};
 
+    // If the gamelist views are created on demand, then only create the view for the system
+    // that goToStart() will display or that is initially selected in the system view.
+    if (lazyGamelistViews && !SystemData::sSystemVector.empty()) {
+        const std::string& requestedSystem {Settings::getInstance()->getString("StartupSystem")};
+        for (auto system : SystemData::sSystemVector) {
+            if (system->getName() == requestedSystem) {
+                startupSystem = system;
+                break;
+            }
+        }
+        if (startupSystem == nullptr)
+            startupSystem = getSystemListView()->getFirstSystem();
+    }
+
     for (auto it = SystemData::sSystemVector.cbegin(); // Line break.
          it != SystemData::sSystemVector.cend(); ++it) {
         // Poll events so that the OS doesn't think the application is hanging on startup,
@@ -1206,6 +1351,11 @@ void ViewController::preload()
             }
         };
 
+        if (lazyGamelistViews && *it != startupSystem) {
+            (*it)->getIndex()->resetFilters();
+            continue;
+        }
+
         const std::string entryType {(*it)->isCustomCollection() ? "custom collection" : "system"};
         LOG(LogDebug) << "ViewController::preload(): Populating gamelist for " << entryType << " \""
                       << (*it)->getName() << "\"";
@@ -1316,6 +1466,11 @@ void ViewController::reloadAll()
 
     cancelViewTransitions();
 
+    // Media files may have been added or removed outside the application.
+    MediaDirectoryIndex::getInstance().clear();
+
+    const bool lazyGamelistViews {Settings::getInstance()->getInt("GamelistViewCacheSize") > 0};
+
     // Clear all GamelistViews.
     std::map<SystemData*, FileData*> cursorMap;
     for (auto it = mGamelistViews.cbegin(); it != mGamelistViews.cend(); ++it) {
@@ -1325,6 +1480,7 @@ void ViewController::reloadAll()
     }
 
     mGamelistViews.clear();
+    mGamelistViewsLastUsed.clear();
     mCurrentView = nullptr;
 
     // Load themes, create GamelistViews and reset filters.
@@ -1333,6 +1489,20 @@ void ViewController::reloadAll()
         it->first->getIndex()->resetFilters();
     }
 
+    // Systems without a gamelist view still need their themes reloaded, and the views that
+    // were just cleared will get their cursor positions restored when they are recreated.
+    if (lazyGamelistViews) {
+        for (auto system : SystemData::sSystemVector) {
+            if (cursorMap.find(system) == cursorMap.cend()) {
+                system->loadTheme(ThemeTriggers::TriggerType::NONE);
+                system->getIndex()->resetFilters();
+            }
+        }
+        for (auto it = cursorMap.cbegin(); it != cursorMap.cend(); ++it)
+            mEvictedGamelistViews[it->first] = {it->second, {}};
+        cursorMap.clear();
+    }
+
     ThemeData::setThemeTransitions();
 
     // Rebuild SystemListView.
@@ -1386,16 +1556,11 @@ void ViewController::rescanROMDirectory()
 {
     mWindow->setBlockInput(true);
     resetCamera();
-
-    mState.viewing = ViewMode::NOTHING;
-    mGamelistViews.clear();
-    mSystemListView.reset();
-    mCurrentView.reset();
-    mPreviousView.reset();
-    mSkipView.reset();
+    deinit();
 
     mWindow->renderSplashScreen(Window::SplashScreenState::SCANNING, 0.0f);
     CollectionSystemsManager::getInstance()->deinit(false);
+    MediaDirectoryIndex::getInstance().clear();
     SystemData::loadConfig();
 
     if (SystemData::sStartupExitSignal) {
@@ -1424,6 +1589,18 @@ void ViewController::rescanROMDirectory()
     }
 }
 
+void ViewController::deinit()
+{
+    mState.viewing = ViewMode::NOTHING;
+    mGamelistViews.clear();
+    mGamelistViewsLastUsed.clear();
+    mEvictedGamelistViews.clear();
+    mSystemListView.reset();
+    mCurrentView.reset();
+    mPreviousView.reset();
+    mSkipView.reset();
+}
+
 std::vector<HelpPrompt> ViewController::getHelpPrompts()
 {
     std::vector<HelpPrompt> prompts;
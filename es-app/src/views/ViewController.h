@@ -43,7 +43,9 @@ public:
     void updateAvailableDialog();
 
     // Try to completely populate the GamelistView map.
-    // Caches things so there's no pauses during transitions.
+    // Caches things so there's no pauses during transitions. If the GamelistViewCacheSize
+    // setting is non-zero then only the gamelist view for the startup system is created,
+    // and the other views are created on demand.
     void preload();
 
     // If a basic view detected a metadata change, it can request to recreate
@@ -51,13 +53,17 @@ public:
     void reloadGamelistView(GamelistView* gamelist, bool reloadTheme = false);
     void reloadGamelistView(SystemData* system, bool reloadTheme = false)
     {
-        reloadGamelistView(getGamelistView(system).get(), reloadTheme);
+        reloadGamelistView(getGamelistViewIfExists(system).get(), reloadTheme);
     }
     // Reload everything with a theme, used when the "Theme" setting changes.
     void reloadAll();
 
     // Rescan the ROM directory for any changes to games and systems.
     void rescanROMDirectory();
+    // Remove all views. Also called during application shutdown, as the views would otherwise
+    // be destroyed together with the static ViewController instance, after singletons such
+    // as AnimationFrameCache which the components depend on.
+    void deinit();
 
     // Navigation.
     void goToNextGamelist();
@@ -99,6 +105,7 @@ public:
     bool input(InputConfig* config, Input input) override;
     void update(int deltaTime) override;
     void render(const glm::mat4& parentTrans) override;
+    bool isAnimating() override;
 
     enum class ViewMode {
         NOTHING,
@@ -128,6 +135,10 @@ public:
     HelpStyle getViewHelpStyle();
 
     std::shared_ptr<GamelistView> getGamelistView(SystemData* system);
+    // Returns nullptr if the view has not been created, or if it has been removed due to the
+    // GamelistViewCacheSize setting. Use this when an existing view only needs to be notified
+    // of changes, as a view that is created later is populated from the current game data.
+    std::shared_ptr<GamelistView> getGamelistViewIfExists(SystemData* system);
     std::shared_ptr<SystemView> getSystemListView();
     void removeGamelistView(SystemData* system);
 
@@ -178,10 +189,26 @@ private:
     // Restore view position if it was moved during wrap around.
     void restoreViewPosition();
 
+    // Used if the GamelistViewCacheSize setting is non-zero, in which case the least recently
+    // used gamelist views are removed. The cursor position of a removed view is retained so
+    // it can be restored when the view is recreated.
+    struct GamelistViewState {
+        FileData* cursor;
+        std::vector<FileData*> cursorHistory;
+    };
+    void evictGamelistViews(SystemData* requestedSystem);
+    void restoreGamelistViewState(SystemData* system, GamelistView* view);
+    // Creates the gamelist views for the selected system and its neighbors in the system view,
+    // one view per call.
+    void prepareGamelistViews();
+
     std::shared_ptr<GuiComponent> mCurrentView;
     std::shared_ptr<GuiComponent> mPreviousView;
     std::shared_ptr<GuiComponent> mSkipView;
     std::map<SystemData*, std::shared_ptr<GamelistView>> mGamelistViews;
+    std::map<SystemData*, unsigned int> mGamelistViewsLastUsed;
+    std::map<SystemData*, GamelistViewState> mEvictedGamelistViews;
+    unsigned int mGamelistViewsUseCounter;
     std::shared_ptr<SystemView> mSystemListView;
     ViewTransitionAnimation mLastTransitionAnim;
 
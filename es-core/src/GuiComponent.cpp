@@ -86,6 +86,21 @@ void GuiComponent::update(int deltaTime)
     updateChildren(deltaTime);
 }
 
+bool GuiComponent::isAnimating()
+{
+    for (unsigned char i {0}; i < MAX_ANIMATIONS; ++i) {
+        if (isAnimationPlaying(i))
+            return true;
+    }
+
+    for (unsigned int i {0}; i < getChildCount(); ++i) {
+        if (getChild(i)->isAnimating())
+            return true;
+    }
+
+    return false;
+}
+
 void GuiComponent::render(const glm::mat4& parentTrans)
 {
     if (!isVisible())
@@ -336,6 +336,12 @@ public:
     // Returns true if the component is busy doing background processing (e.g. HTTP downloads).
     const bool isProcessing() const { return mIsProcessing; }
 
+    // Returns true if the component or any of its children will change appearance without
+    // any input, which means the screen needs to be continuously redrawn. The default
+    // implementation checks for running animations, components that scroll, play videos or
+    // otherwise animate on their own need to override this.
+    virtual bool isAnimating();
+
     const static unsigned char MAX_ANIMATIONS = 4;
 
 protected:
@@ -0,0 +1,352 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  HttpCache.cpp
+//
+//  On-disk cache of scraper HTTP responses, used by HttpReq so that re-scraping a system
+//  can be served mostly from local storage. Entries are keyed by the normalized request
+//  URL with any passwords and API keys removed and the account name hashed, and the
+//  response bodies are stored by content hash so identical files returned for different
+//  URLs are only stored once. Responses with an ETag or Last-Modified header are
+//  revalidated with the server every time they are used.
+//
+
+#include "HttpCache.h"
+
+#include "Log.h"
+#include "Settings.h"
+#include "utils/CacheFileUtil.h"
+#include "utils/FileSystemUtil.h"
+#include "utils/MathUtil.h"
+#include "utils/StringUtil.h"
+#include "utils/TimeUtil.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace
+{
+    const std::string indexFileMagic {"ESDEHTTP"};
+    const unsigned int indexFileVersion {2};
+
+    // Query parameters containing credentials or the application version, which are left
+    // out of the cache key.
+    const std::vector<std::string> strippedParameters {"apikey", "devid", "devpassword",
+                                                       "softname", "sspassword"};
+
+    // ScreenScraper responses contain account specific data such as the request quota and
+    // the allowed number of threads, so the account name is kept in the key but hashed.
+    const std::vector<std::string> hashedParameters {"ssid"};
+} // namespace
+
+HttpCache::HttpCache()
+    : mTotalSize {0}
+    , mLoaded {false}
+    , mModified {false}
+{
+    mCacheDirectory = Utils::FileSystem::getAppDataDirectory() + "/cache/scraper";
+}
+
+HttpCache& HttpCache::getInstance()
+{
+    static HttpCache instance;
+    return instance;
+}
+
+std::string HttpCache::getKey(const std::string& url)
+{
+    if (Settings::getInstance()->getInt("ScraperCacheSize") <= 0)
+        return "";
+
+    std::string base {url.substr(0, url.find('#'))};
+    std::string query;
+
+    const size_t queryPos {base.find('?')};
+    if (queryPos != std::string::npos) {
+        query = base.substr(queryPos + 1);
+        base.erase(queryPos);
+    }
+
+    // The scheme and host are case insensitive, and any username and password are removed.
+    const size_t schemeEnd {base.find("://")};
+    if (schemeEnd != std::string::npos) {
+        size_t hostEnd {base.find('/', schemeEnd + 3)};
+        if (hostEnd == std::string::npos)
+            hostEnd = base.size();
+        std::string host {base.substr(schemeEnd + 3, hostEnd - schemeEnd - 3)};
+        const size_t userInfoEnd {host.rfind('@')};
+        if (userInfoEnd != std::string::npos)
+            host.erase(0, userInfoEnd + 1);
+        base = Utils::String::toLower(base.substr(0, schemeEnd + 3)) +
+               Utils::String::toLower(host) + base.substr(hostEnd);
+    }
+
+    std::vector<std::string> parameters;
+    for (auto& parameter : Utils::String::delimitedStringToVector(query, "&")) {
+        const std::string name {Utils::String::toLower(parameter.substr(0, parameter.find('=')))};
+        if (name.empty() || std::find(strippedParameters.cbegin(), strippedParameters.cend(),
+                                      name) != strippedParameters.cend())
+            continue;
+        if (std::find(hashedParameters.cbegin(), hashedParameters.cend(), name) !=
+            hashedParameters.cend()) {
+            const size_t valuePos {parameter.find('=')};
+            const std::string value {
+                valuePos == std::string::npos ? "" : parameter.substr(valuePos + 1)};
+            parameters.emplace_back(name + "=" + Utils::Math::md5Hash(value, false));
+            continue;
+        }
+        parameters.emplace_back(parameter);
+    }
+
+    if (parameters.empty())
+        return base;
+
+    std::sort(parameters.begin(), parameters.end());
+    return base + "?" + Utils::String::vectorToDelimitedString(parameters, "&");
+}
+
+HttpCache::LookupResult HttpCache::lookup(const std::string& key,
+                                          std::string& etag,
+                                          std::string& lastModified)
+{
+    std::unique_lock<std::mutex> lock {mMutex};
+
+    if (!mLoaded)
+        loadIndex();
+
+    auto entry = mEntries.find(key);
+    if (entry == mEntries.end())
+        return MISS;
+
+    if (entry->second.etag != "" || entry->second.lastModified != "") {
+        etag = entry->second.etag;
+        lastModified = entry->second.lastModified;
+        return REVALIDATE;
+    }
+
+    // Responses without any validators are used until they reach the maximum age.
+    const long long maxAge {
+        static_cast<long long>(
+            glm::clamp(Settings::getInstance()->getInt("ScraperCacheMaxAge"), 0, 365)) *
+        86400};
+    if (Utils::Time::now() - entry->second.storeTime >= maxAge)
+        return MISS;
+
+    return FRESH;
+}
+
+bool HttpCache::read(const std::string& key, std::string& content)
+{
+    std::unique_lock<std::mutex> lock {mMutex};
+
+    if (!mLoaded)
+        loadIndex();
+
+    auto entry = mEntries.find(key);
+    if (entry == mEntries.end())
+        return false;
+
+    const std::string contentPath {getContentPath(entry->second.contentHash)};
+
+#if defined(_WIN64)
+    std::ifstream stream {Utils::String::stringToWideString(contentPath).c_str(),
+                          std::ios::binary};
+#else
+    std::ifstream stream {contentPath, std::ios::binary};
+#endif
+    if (!stream.good()) {
+        LOG(LogWarning) << "HttpCache: Couldn't read cache file \"" << contentPath << "\"";
+        removeEntry(entry);
+        return false;
+    }
+
+    content.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    entry->second.accessTime = Utils::Time::now();
+    mModified = true;
+
+    return true;
+}
+
+void HttpCache::write(const std::string& key,
+                      const std::string& etag,
+                      const std::string& lastModified,
+                      const std::string& content)
+{
+    if (content.empty())
+        return;
+
+    const std::string contentHash {Utils::Math::md5Hash(content, false)};
+
+    std::unique_lock<std::mutex> lock {mMutex};
+
+    if (!mLoaded)
+        loadIndex();
+
+    auto entry = mEntries.find(key);
+    if (entry != mEntries.end()) {
+        if (entry->second.contentHash == contentHash) {
+            entry->second.etag = etag;
+            entry->second.lastModified = lastModified;
+            entry->second.storeTime = Utils::Time::now();
+            entry->second.accessTime = entry->second.storeTime;
+            mModified = true;
+            return;
+        }
+        removeEntry(entry);
+    }
+
+    if (mContentRefs.find(contentHash) == mContentRefs.end()) {
+        if (!Utils::FileSystem::exists(mCacheDirectory) &&
+            !Utils::FileSystem::createDirectory(mCacheDirectory)) {
+            LOG(LogWarning) << "HttpCache: Couldn't create directory \"" << mCacheDirectory
+                            << "\"";
+            return;
+        }
+
+        const std::string contentPath {getContentPath(contentHash)};
+        const std::string tempPath {contentPath + ".tmp"};
+
+#if defined(_WIN64)
+        std::ofstream stream {Utils::String::stringToWideString(tempPath).c_str(),
+                              std::ios::binary | std::ios::trunc};
+#else
+        std::ofstream stream {tempPath, std::ios::binary | std::ios::trunc};
+#endif
+        stream.write(content.data(), content.size());
+        stream.close();
+
+        if (stream.fail() || Utils::FileSystem::renameFile(tempPath, contentPath, true)) {
+            LOG(LogWarning) << "HttpCache: Couldn't write cache file \"" << contentPath << "\"";
+            Utils::FileSystem::removeFile(tempPath);
+            return;
+        }
+
+        mTotalSize += static_cast<long long>(content.size());
+    }
+
+    ++mContentRefs[contentHash];
+
+    const long long currentTime {Utils::Time::now()};
+    mEntries[key] = Entry {contentHash,
+                           etag,
+                           lastModified,
+                           static_cast<long long>(content.size()),
+                           currentTime,
+                           currentTime};
+    mModified = true;
+
+    evict();
+}
+
+void HttpCache::saveIndex()
+{
+    std::unique_lock<std::mutex> lock {mMutex};
+
+    if (!mModified)
+        return;
+
+    const std::string indexPath {mCacheDirectory + "/index.bin"};
+    Utils::CacheFile::Writer writer {indexPath, indexFileMagic, indexFileVersion};
+    writer.write<unsigned int>(static_cast<unsigned int>(mEntries.size()));
+
+    for (auto& entry : mEntries) {
+        writer.writeString(entry.first);
+        writer.writeString(entry.second.contentHash);
+        writer.writeString(entry.second.etag);
+        writer.writeString(entry.second.lastModified);
+        writer.write<long long>(entry.second.size);
+        writer.write<long long>(entry.second.storeTime);
+        writer.write<long long>(entry.second.accessTime);
+    }
+
+    if (writer.commit() == -1)
+        LOG(LogWarning) << "HttpCache: Couldn't write index file \"" << indexPath << "\"";
+    else
+        mModified = false;
+}
+
+void HttpCache::loadIndex()
+{
+    mLoaded = true;
+
+    const std::string indexPath {mCacheDirectory + "/index.bin"};
+    if (!Utils::FileSystem::exists(mCacheDirectory))
+        return;
+
+    if (Utils::FileSystem::exists(indexPath)) {
+        Utils::CacheFile::Reader reader {indexPath, indexFileMagic, indexFileVersion};
+        const unsigned int entryCount {reader.read<unsigned int>()};
+
+        for (unsigned int i {0}; i < entryCount && reader.isValid(); ++i) {
+            const std::string key {reader.readString()};
+            Entry entry;
+            entry.contentHash = reader.readString();
+            entry.etag = reader.readString();
+            entry.lastModified = reader.readString();
+            entry.size = reader.read<long long>();
+            entry.storeTime = reader.read<long long>();
+            entry.accessTime = reader.read<long long>();
+            if (!reader.isValid())
+                break;
+            if (mContentRefs[entry.contentHash]++ == 0)
+                mTotalSize += entry.size;
+            mEntries[key] = entry;
+        }
+
+        if (!reader.isValid()) {
+            LOG(LogInfo) << "HttpCache: Index file \"" << indexPath
+                         << "\" is outdated or corrupt, the scraper cache will be rebuilt";
+            mEntries.clear();
+            mContentRefs.clear();
+            mTotalSize = 0;
+            Utils::FileSystem::removeFile(indexPath);
+        }
+    }
+
+    // Remove all content files that are not part of the index. These are the files from an
+    // outdated or corrupt index, as well as any files written after the index was last saved
+    // if the application was not shut down cleanly. They would otherwise never be evicted.
+    for (auto& file : Utils::FileSystem::getDirContent(mCacheDirectory)) {
+        if (Utils::FileSystem::getFileName(file) == "index.bin")
+            continue;
+        if (Utils::FileSystem::getExtension(file) == ".bin" &&
+            mContentRefs.find(Utils::FileSystem::getStem(file)) != mContentRefs.cend())
+            continue;
+        Utils::FileSystem::removeFile(file);
+    }
+}
+
+void HttpCache::removeEntry(std::unordered_map<std::string, Entry>::iterator entry)
+{
+    auto refs = mContentRefs.find(entry->second.contentHash);
+    if (refs != mContentRefs.end() && --refs->second == 0) {
+        Utils::FileSystem::removeFile(getContentPath(entry->second.contentHash));
+        mTotalSize -= entry->second.size;
+        mContentRefs.erase(refs);
+    }
+
+    mEntries.erase(entry);
+    mModified = true;
+}
+
+void HttpCache::evict()
+{
+    const long long maxSize {
+        static_cast<long long>(
+            glm::clamp(Settings::getInstance()->getInt("ScraperCacheSize"), 0, 65536)) *
+        1024 * 1024};
+
+    while (mTotalSize > maxSize && !mEntries.empty()) {
+        auto oldest = std::min_element(mEntries.begin(), mEntries.end(), [](auto& a, auto& b) {
+            return a.second.accessTime < b.second.accessTime;
+        });
+        removeEntry(oldest);
+    }
+}
+
+std::string HttpCache::getContentPath(const std::string& contentHash) const
+{
+    return mCacheDirectory + "/" + contentHash + ".bin";
+}
@@ -0,0 +1,76 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  HttpCache.h
+//
+//  On-disk cache of scraper HTTP responses, used by HttpReq so that re-scraping a system
+//  can be served mostly from local storage. Entries are keyed by the normalized request
+//  URL with any passwords and API keys removed and the account name hashed, and the
+//  response bodies are stored by content hash so identical files returned for different
+//  URLs are only stored once. Responses with an ETag or Last-Modified header are
+//  revalidated with the server every time they are used.
+//
+
+#ifndef ES_CORE_HTTP_CACHE_H
+#define ES_CORE_HTTP_CACHE_H
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+class HttpCache
+{
+public:
+    enum LookupResult {
+        MISS,      // Not cached, or the cached entry has expired.
+        FRESH,     // Can be used without contacting the server.
+        REVALIDATE // Needs to be revalidated using the returned ETag and Last-Modified values.
+    };
+
+    static HttpCache& getInstance();
+
+    // Returns an empty string if the cache is disabled.
+    std::string getKey(const std::string& url);
+
+    LookupResult lookup(const std::string& key, std::string& etag, std::string& lastModified);
+    // Returns false if there is no entry or if the content file could not be read.
+    bool read(const std::string& key, std::string& content);
+    void write(const std::string& key,
+               const std::string& etag,
+               const std::string& lastModified,
+               const std::string& content);
+
+    // Writes the index file if there have been any changes. Called when a scraping run has
+    // finished and when the curl multi handle is cleaned up. Content files written after the
+    // index was last saved are removed when the index is loaded.
+    void saveIndex();
+
+private:
+    struct Entry {
+        std::string contentHash;
+        std::string etag;
+        std::string lastModified;
+        long long size;
+        long long storeTime;
+        long long accessTime;
+    };
+
+    HttpCache();
+
+    void loadIndex();
+    void removeEntry(std::unordered_map<std::string, Entry>::iterator entry);
+    // Removes the least recently used entries until the cache fits within ScraperCacheSize.
+    void evict();
+    std::string getContentPath(const std::string& contentHash) const;
+
+    std::unordered_map<std::string, Entry> mEntries;
+    // Number of entries referring to each content file.
+    std::unordered_map<std::string, unsigned int> mContentRefs;
+    std::mutex mMutex;
+    std::string mCacheDirectory;
+    long long mTotalSize;
+    bool mLoaded;
+    bool mModified;
+};
+
+#endif // ES_CORE_HTTP_CACHE_H
@@ -14,6 +14,7 @@
 #include "Settings.h"
 #include "resources/ResourceManager.h"
 #include "utils/FileSystemUtil.h"
+#include "utils/StringUtil.h"
 
 #include <algorithm>
 #include <assert.h>
@@ -40,6 +41,8 @@ std::string HttpReq::urlEncode(const std::string& s)
 
 HttpReq::HttpReq(const std::string& url, bool scraperRequest)
     : mStatus {REQ_IN_PROGRESS}
+    , mCacheUpdatePending {false}
+    , mResponseCode {0}
     , mHandle {nullptr}
     , mTotalBytes {0}
     , mDownloadedBytes {0}
@@ -50,6 +53,28 @@ HttpReq::HttpReq(const std::string& url, bool scraperRequest)
     if (!sMultiHandle)
         sMultiHandle = curl_multi_init();
 
+    if (!mPollThread) {
+        sStopPoll = false;
+        mPollThread = std::make_unique<std::thread>(&HttpReq::pollCurl, this);
+    }
+
+    // Scraper responses may be served from the local cache, see HttpCache for details.
+    std::string etag;
+    std::string lastModified;
+
+    if (mScraperRequest)
+        mCacheKey = HttpCache::getInstance().getKey(url);
+
+    if (mCacheKey != "" &&
+        HttpCache::getInstance().lookup(mCacheKey, etag, lastModified) == HttpCache::FRESH) {
+        std::string content;
+        if (HttpCache::getInstance().read(mCacheKey, content)) {
+            mContent << content;
+            mStatus = REQ_SUCCESS;
+            return;
+        }
+    }
+
     mHandle = curl_easy_init();
 
     if (mHandle == nullptr) {
@@ -58,11 +83,6 @@ HttpReq::HttpReq(const std::string& url, bool scraperRequest)
         return;
     }
 
-    if (!mPollThread) {
-        sStopPoll = false;
-        mPollThread = std::make_unique<std::thread>(&HttpReq::pollCurl, this);
-    }
-
 #if defined(USE_BUNDLED_CERTIFICATES)
     // Use the bundled curl TLS/SSL certificates (which come from the Mozilla project).
     // This is used on Windows and also on Android as there is no way for curl to access
@@ -232,6 +252,42 @@ HttpReq::HttpReq(const std::string& url, bool scraperRequest)
         return;
     }
 
+    if (mCacheKey != "") {
+        // The ETag and Last-Modified headers are needed for revalidating the cached response.
+        err = curl_easy_setopt(mHandle, CURLOPT_HEADERFUNCTION, &HttpReq::writeHeader);
+        if (err != CURLE_OK) {
+            mStatus = REQ_IO_ERROR;
+            onError(curl_easy_strerror(err));
+            return;
+        }
+
+        err = curl_easy_setopt(mHandle, CURLOPT_HEADERDATA, this);
+        if (err != CURLE_OK) {
+            mStatus = REQ_IO_ERROR;
+            onError(curl_easy_strerror(err));
+            return;
+        }
+
+        if (etag != "" || lastModified != "") {
+            curl_slist* headers {nullptr};
+            if (etag != "")
+                headers = curl_slist_append(headers, ("If-None-Match: " + etag).c_str());
+            if (lastModified != "")
+                headers =
+                    curl_slist_append(headers, ("If-Modified-Since: " + lastModified).c_str());
+
+            // The header list is freed in pollCurl() when the easy handle is cleaned up.
+            curl_easy_setopt(mHandle, CURLOPT_PRIVATE, headers);
+
+            err = curl_easy_setopt(mHandle, CURLOPT_HTTPHEADER, headers);
+            if (err != CURLE_OK) {
+                mStatus = REQ_IO_ERROR;
+                onError(curl_easy_strerror(err));
+                return;
+            }
+        }
+    }
+
     // Add the handle to the multi. This is done in pollCurl(), running in a separate thread.
     std::unique_lock<std::mutex> handleLock {sHandleMutex};
     sAddHandleQueue.push(mHandle);
@@ -259,6 +315,19 @@ HttpReq::~HttpReq()
     }
 }
 
+HttpReq::Status HttpReq::status()
+{
+    if (mStatus == REQ_SUCCESS && mCacheUpdatePending) {
+        mCacheUpdatePending = false;
+        if (!updateCache()) {
+            onError("Couldn't read cached response");
+            mStatus = REQ_IO_ERROR;
+        }
+    }
+
+    return mStatus;
+}
+
 std::string HttpReq::getContent() const
 {
     assert(mStatus == REQ_SUCCESS);
@@ -318,6 +387,59 @@ size_t HttpReq::writeContent(void* buff, size_t size, size_t nmemb, void* req_pt
     return nmemb;
 }
 
+size_t HttpReq::writeHeader(char* buff, size_t size, size_t nitems, void* req_ptr)
+{
+    const std::string header {buff, size * nitems};
+
+    // We need all the check logic below to make sure we're not attempting to write into
+    // a request that has just been removed by the main thread.
+    bool validEntry {false};
+
+    std::unique_lock<std::mutex> requestLock {sRequestMutex};
+    if (std::find_if(sRequests.cbegin(), sRequests.cend(), [&req_ptr](auto&& entry) {
+            return entry.second == req_ptr;
+        }) != sRequests.cend())
+        validEntry = true;
+
+    if (validEntry) {
+        HttpReq* req {static_cast<HttpReq*>(req_ptr)};
+        // A new status line means that a redirect was followed.
+        if (Utils::String::startsWith(header, "HTTP/")) {
+            req->mETag = "";
+            req->mLastModified = "";
+        }
+        else if (header.find(':') != std::string::npos) {
+            const std::string name {Utils::String::toLower(header.substr(0, header.find(':')))};
+            const std::string value {Utils::String::trim(header.substr(header.find(':') + 1))};
+            if (name == "etag")
+                req->mETag = value;
+            else if (name == "last-modified")
+                req->mLastModified = value;
+        }
+    }
+
+    requestLock.unlock();
+
+    return size * nitems;
+}
+
+bool HttpReq::updateCache()
+{
+    if (mResponseCode == 304) {
+        // Not modified, so the response body is read from the cache.
+        std::string content;
+        if (!HttpCache::getInstance().read(mCacheKey, content))
+            return false;
+        mContent.str("");
+        mContent << content;
+    }
+    else if (mResponseCode == 200) {
+        HttpCache::getInstance().write(mCacheKey, mETag, mLastModified, mContent.str());
+    }
+
+    return true;
+}
+
 void HttpReq::pollCurl()
 {
     int numfds {0};
@@ -357,7 +479,11 @@ void HttpReq::pollCurl()
                 LOG(LogError) << "Error removing curl easy handle from curl multi: "
                               << curl_multi_strerror(merr);
             }
+            char* headers {nullptr};
+            curl_easy_getinfo(sRemoveHandleQueue.front(), CURLINFO_PRIVATE, &headers);
             curl_easy_cleanup(sRemoveHandleQueue.front());
+            if (headers != nullptr)
+                curl_slist_free_all(reinterpret_cast<curl_slist*>(headers));
             sRemoveHandleQueue.pop();
         }
 
@@ -386,6 +512,11 @@ void HttpReq::pollCurl()
                     }
 
                     if (msg->data.result == CURLE_OK) {
+                        if (req->mCacheKey != "") {
+                            curl_easy_getinfo(msg->easy_handle, CURLINFO_RESPONSE_CODE,
+                                              &req->mResponseCode);
+                            req->mCacheUpdatePending = true;
+                        }
                         req->mStatus = REQ_SUCCESS;
                     }
                     else if (msg->data.result == CURLE_PEER_FAILED_VERIFICATION) {
@@ -10,6 +10,8 @@
 #ifndef ES_CORE_HTTP_REQ_H
 #define ES_CORE_HTTP_REQ_H
 
+#include "HttpCache.h"
+
 #include <curl/curl.h>
 
 #include <atomic>
@@ -38,7 +40,9 @@ public:
         // clang-format on
     };
 
-    Status status() { return mStatus; }
+    // For cached requests the cache is updated by the first call after the transfer has
+    // completed, so that large responses are not hashed and written by the poll thread.
+    Status status();
 
     std::string getErrorMsg() { return mErrorMsg; }
     std::string getContent() const;
@@ -58,6 +62,7 @@ public:
             curl_multi_cleanup(sMultiHandle);
             sMultiHandle = nullptr;
         }
+        HttpCache::getInstance().saveIndex();
     }
 
 private:
@@ -65,6 +70,11 @@ private:
     static int transferProgress(
         void* clientp, curl_off_t dltotal, curl_off_t dlnow, curl_off_t ultotal, curl_off_t ulnow);
     static size_t writeContent(void* buff, size_t size, size_t nmemb, void* req_ptr);
+    static size_t writeHeader(char* buff, size_t size, size_t nitems, void* req_ptr);
+
+    // Called from status() when a request using the cache has completed. Returns false if
+    // the server reported that the cached response is still valid but it could not be read.
+    bool updateCache();
 
     void onError(const std::string& msg) { mErrorMsg = msg; }
 
@@ -77,6 +87,8 @@ private:
     static inline std::queue<CURL*> sRemoveHandleQueue;
 
     std::atomic<Status> mStatus;
+    std::atomic<bool> mCacheUpdatePending;
+    long mResponseCode;
     CURL* mHandle;
 
     static inline std::unique_ptr<std::thread> mPollThread;
@@ -85,6 +97,9 @@ private:
 
     std::stringstream mContent;
     std::string mErrorMsg;
+    std::string mCacheKey;
+    std::string mETag;
+    std::string mLastModified;
     static inline std::atomic<bool> sStopPoll = false;
     std::atomic<long> mTotalBytes;
     std::atomic<long> mDownloadedBytes;
@@ -72,6 +72,41 @@ std::vector<unsigned char> ImageIO::loadFromMemoryRGBA32(const unsigned char* da
     return rawData;
 }
 
+std::vector<unsigned char> ImageIO::saveToMemoryPNG(const unsigned char* data,
+                                                    const size_t width,
+                                                    const size_t height)
+{
+    std::vector<unsigned char> pngData;
+    FIBITMAP* fiBitmap {FreeImage_ConvertFromRawBits(
+        const_cast<BYTE*>(data), static_cast<int>(width), static_cast<int>(height),
+        static_cast<int>(width * 4), 32, FI_RGBA_RED_MASK, FI_RGBA_GREEN_MASK, FI_RGBA_BLUE_MASK,
+        false)};
+
+    if (fiBitmap == nullptr) {
+        LOG(LogError) << "Failed to convert image data to bitmap";
+        return pngData;
+    }
+
+    FIMEMORY* fiMemory {FreeImage_OpenMemory()};
+    if (fiMemory != nullptr) {
+        // Encoding speed matters more than the file size as this is used for caching.
+        if (FreeImage_SaveToMemory(FIF_PNG, fiBitmap, fiMemory, PNG_Z_BEST_SPEED)) {
+            BYTE* memoryData {nullptr};
+            DWORD memorySize {0};
+            if (FreeImage_AcquireMemory(fiMemory, &memoryData, &memorySize))
+                pngData.assign(memoryData, memoryData + memorySize);
+        }
+        FreeImage_CloseMemory(fiMemory);
+    }
+
+    FreeImage_Unload(fiBitmap);
+
+    if (pngData.empty())
+        LOG(LogError) << "Failed to encode image as PNG";
+
+    return pngData;
+}
+
 void ImageIO::flipPixelsVert(unsigned char* imagePx, const size_t& width, const size_t& height)
 {
     unsigned int temp;
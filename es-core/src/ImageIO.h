@@ -19,6 +19,12 @@ public:
                                                            const size_t size,
                                                            size_t& width,
                                                            size_t& height);
+    // Encodes pixel data in the format returned by loadFromMemoryRGBA32() as a PNG image,
+    // which will decode to the same pixel data if it's fully opaque. Returns an empty
+    // vector if the image could not be encoded.
+    static std::vector<unsigned char> saveToMemoryPNG(const unsigned char* data,
+                                                      const size_t width,
+                                                      const size_t height);
     static void flipPixelsVert(unsigned char* imagePx, const size_t& width, const size_t& height);
 };
 
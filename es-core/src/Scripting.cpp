@@ -11,6 +11,13 @@
 //  For example, if the event is called "game-start", all scripts inside the directory
 //  <application data>/scripts/game-start/ will be executed.
 //
+//  The browse events game-select and system-select are executed by a separate thread so
+//  that slow scripts won't interrupt navigation, and only the latest queued event of each
+//  of these types is kept. All other events are executed in the calling thread after any
+//  queued events have finished executing. The script directory listings are cached and on
+//  Linux they're invalidated using inotify, otherwise the directory modification times
+//  are compared.
+//
 
 #include "Scripting.h"
 
@@ -21,6 +28,294 @@
 #include "utils/StringUtil.h"
 
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    // Events that are executed asynchronously by the dispatcher thread.
+    const std::vector<std::string> asyncEvents {"game-select", "system-select"};
+    // The queue can't really grow this large as the browse events are coalesced, but
+    // it's bounded anyway in case something fires events in a tight loop.
+    constexpr size_t maxQueueSize {16};
+
+    struct Event {
+        std::string name;
+        std::string arg1;
+        std::string arg2;
+        std::string arg3;
+        std::string arg4;
+    };
+
+    class EventDispatcher
+    {
+    public:
+        static EventDispatcher& getInstance()
+        {
+            static EventDispatcher instance;
+            return instance;
+        }
+
+        void dispatch(const Event& event, bool async);
+
+    private:
+        struct ScriptList {
+            std::list<std::string> scripts;
+            long long modTime;
+        };
+
+        EventDispatcher();
+        ~EventDispatcher();
+
+        void dispatcherThread();
+        void executeScripts(const Event& event);
+        const std::list<std::string>& getScripts(const std::string& eventName);
+        void addWatch(const std::string& path);
+        // Clears the script cache if any of the watched directories have changed.
+        void checkWatches();
+
+        std::deque<Event> mQueue;
+        std::mutex mMutex;
+        std::condition_variable mQueueCondition;
+        std::condition_variable mIdleCondition;
+        std::unique_ptr<std::thread> mThread;
+        bool mExecuting;
+        bool mExit;
+
+        // Held while executing scripts, this also protects the script cache.
+        std::mutex mExecutionMutex;
+        std::unordered_map<std::string, ScriptList> mScriptCache;
+        std::string mScriptsDirectory;
+        int mInotifyFD;
+    };
+
+    EventDispatcher::EventDispatcher()
+        : mExecuting {false}
+        , mExit {false}
+        , mInotifyFD {-1}
+    {
+        mScriptsDirectory = Utils::FileSystem::getAppDataDirectory() + "/scripts";
+#if defined(__linux__)
+        mInotifyFD = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (mInotifyFD == -1) {
+            LOG(LogWarning) << "Scripting: Couldn't initialize inotify, falling back to "
+                               "checking the script directory modification times";
+        }
+        else {
+            // Watch the application data directory as well in case the scripts directory
+            // is created while the application is running.
+            addWatch(Utils::FileSystem::getAppDataDirectory());
+            addWatch(mScriptsDirectory);
+        }
+#endif
+    }
+
+    EventDispatcher::~EventDispatcher()
+    {
+        if (mThread) {
+            {
+                std::unique_lock<std::mutex> lock {mMutex};
+                mExit = true;
+            }
+            mQueueCondition.notify_one();
+            mThread->join();
+            mThread.reset();
+        }
+#if defined(__linux__)
+        if (mInotifyFD != -1)
+            close(mInotifyFD);
+#endif
+    }
+
+    void EventDispatcher::dispatch(const Event& event, bool async)
+    {
+        std::unique_lock<std::mutex> lock {mMutex};
+
+        if (async) {
+            if (!mThread)
+                mThread = std::make_unique<std::thread>(&EventDispatcher::dispatcherThread, this);
+
+            auto it = std::find_if(mQueue.begin(), mQueue.end(),
+                                   [&event](const Event& queued) {
+                                       return queued.name == event.name;
+                                   });
+            if (it != mQueue.end()) {
+                // Replace the queued event as the selection has changed since it was fired.
+                *it = event;
+            }
+            else if (mQueue.size() >= maxQueueSize) {
+                LOG(LogWarning) << "Scripting: Event queue is full, discarding \"" << event.name
+                                << "\" event";
+                return;
+            }
+            else {
+                mQueue.emplace_back(event);
+            }
+            lock.unlock();
+            mQueueCondition.notify_one();
+            return;
+        }
+
+        // Any queued events are executed first so the scripts run in the same order as the
+        // events were fired.
+        mIdleCondition.wait(lock, [this] { return mQueue.empty() && !mExecuting; });
+        lock.unlock();
+
+        std::unique_lock<std::mutex> executionLock {mExecutionMutex};
+        executeScripts(event);
+    }
+
+    void EventDispatcher::dispatcherThread()
+    {
+        std::unique_lock<std::mutex> lock {mMutex};
+
+        while (true) {
+            mQueueCondition.wait(lock, [this] { return mExit || !mQueue.empty(); });
+            if (mExit)
+                break;
+
+            const Event event {mQueue.front()};
+            mQueue.pop_front();
+            mExecuting = true;
+            lock.unlock();
+            {
+                std::unique_lock<std::mutex> executionLock {mExecutionMutex};
+                executeScripts(event);
+            }
+            lock.lock();
+            mExecuting = false;
+            if (mQueue.empty())
+                mIdleCondition.notify_all();
+        }
+    }
+
+    void EventDispatcher::executeScripts(const Event& event)
+    {
+        const std::list<std::string> scripts {getScripts(event.name)};
+
+        for (auto it = scripts.cbegin(); it != scripts.cend(); ++it) {
+            std::string arg1Quotation;
+            std::string arg2Quotation;
+            std::string arg3Quotation;
+            std::string arg4Quotation;
+            // Add quotation marks around the arguments as long as these are not already
+            // present (i.e. for arguments with spaces in them).
+            if (!event.arg1.empty() && event.arg1.front() != '\"')
+                arg1Quotation = "\"";
+            if (!event.arg2.empty() && event.arg2.front() != '\"')
+                arg2Quotation = "\"";
+            if (!event.arg3.empty() && event.arg3.front() != '\"')
+                arg3Quotation = "\"";
+            if (!event.arg4.empty() && event.arg4.front() != '\"')
+                arg4Quotation = "\"";
+            std::string script;
+            script.append(*it)
+                .append(" ")
+                .append(arg1Quotation)
+                .append(event.arg1)
+                .append(arg1Quotation)
+                .append(" ")
+                .append(arg2Quotation)
+                .append(event.arg2)
+                .append(arg2Quotation)
+                .append(" ")
+                .append(arg3Quotation)
+                .append(event.arg3)
+                .append(arg3Quotation)
+                .append(" ")
+                .append(arg4Quotation)
+                .append(event.arg4)
+                .append(arg4Quotation);
+            LOG(LogDebug) << "Executing: " << script;
+#if defined(__ANDROID__)
+            Utils::Platform::runSystemCommand("sh " + script);
+#else
+            Utils::Platform::runSystemCommand(script);
+#endif
+        }
+    }
+
+    const std::list<std::string>& EventDispatcher::getScripts(const std::string& eventName)
+    {
+        const std::string scriptDir {mScriptsDirectory + "/" + eventName};
+        long long modTime {0};
+
+        if (mInotifyFD != -1)
+            checkWatches();
+        else
+            modTime = Utils::FileSystem::getModificationTime(scriptDir);
+
+        auto cached = mScriptCache.find(eventName);
+        if (cached != mScriptCache.end() && cached->second.modTime == modTime)
+            return cached->second.scripts;
+
+        ScriptList& scriptList {mScriptCache[eventName]};
+        scriptList.scripts.clear();
+        scriptList.modTime = modTime;
+
+        // The watch needs to be added before reading the directory contents so that
+        // no changes are missed.
+        if (mInotifyFD != -1) {
+            addWatch(mScriptsDirectory);
+            addWatch(scriptDir);
+        }
+
+        if (!Utils::FileSystem::exists(scriptDir))
+            return scriptList.scripts;
+
+        scriptList.scripts = Utils::FileSystem::getDirContent(scriptDir);
+        // Sort the scripts in case-sensitive order on Unix/Linux and in case-insensitive order
+        // on macOS and Windows.
+#if defined(__unix__)
+        scriptList.scripts.sort([](std::string a, std::string b) { return a.compare(b) < 0; });
+#else
+        scriptList.scripts.sort([](std::string a, std::string b) {
+            return Utils::String::toUpper(a).compare(Utils::String::toUpper(b)) < 0;
+        });
+#endif
+        return scriptList.scripts;
+    }
+
+    void EventDispatcher::addWatch(const std::string& path)
+    {
+#if defined(__linux__)
+        // Adding a watch for a directory that is already watched just returns the existing
+        // watch, and if the directory doesn't exist this fails silently.
+        if (Utils::FileSystem::isDirectory(path))
+            inotify_add_watch(mInotifyFD, path.c_str(),
+                              IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+                                  IN_DELETE_SELF | IN_MOVE_SELF);
+#endif
+    }
+
+    void EventDispatcher::checkWatches()
+    {
+#if defined(__linux__)
+        alignas(struct inotify_event) char buffer[4096];
+        bool changed {false};
+
+        // We don't care about the actual changes, any event simply invalidates the cache.
+        while (read(mInotifyFD, buffer, sizeof(buffer)) > 0)
+            changed = true;
+
+        if (changed)
+            mScriptCache.clear();
+#endif
+    }
+
+} // namespace
 
 namespace Scripting
 {
@@ -36,65 +331,9 @@ namespace Scripting
         LOG(LogDebug) << "Scripting::fireEvent(): " << eventName << " \"" << arg1 << "\" \"" << arg2
                       << "\" \"" << arg3 << "\" \"" << arg4 << "\"";
 
-        std::list<std::string> scriptDirList;
-        std::string scriptDir;
-
-        // Check in application data directory.
-        scriptDir = Utils::FileSystem::getAppDataDirectory() + "/scripts/" + eventName;
-        if (Utils::FileSystem::exists(scriptDir))
-            scriptDirList.push_back(scriptDir);
+        const bool async {std::find(asyncEvents.cbegin(), asyncEvents.cend(), eventName) !=
+                          asyncEvents.cend()};
 
-        for (auto dirIt = scriptDirList.cbegin(); dirIt != scriptDirList.cend(); ++dirIt) {
-            std::list<std::string> scripts {Utils::FileSystem::getDirContent(*dirIt)};
-            // Sort the scripts in case-sensitive order on Unix/Linux and in case-insensitive order
-            // on macOS and Windows.
-#if defined(__unix__)
-            scripts.sort([](std::string a, std::string b) { return a.compare(b) < 0; });
-#else
-            scripts.sort([](std::string a, std::string b) {
-                return Utils::String::toUpper(a).compare(Utils::String::toUpper(b)) < 0;
-            });
-#endif
-            for (auto it = scripts.cbegin(); it != scripts.cend(); ++it) {
-                std::string arg1Quotation;
-                std::string arg2Quotation;
-                std::string arg3Quotation;
-                std::string arg4Quotation;
-                // Add quotation marks around the arguments as long as these are not already
-                // present (i.e. for arguments with spaces in them).
-                if (!arg1.empty() && arg1.front() != '\"')
-                    arg1Quotation = "\"";
-                if (!arg2.empty() && arg2.front() != '\"')
-                    arg2Quotation = "\"";
-                if (!arg3.empty() && arg3.front() != '\"')
-                    arg3Quotation = "\"";
-                if (!arg4.empty() && arg4.front() != '\"')
-                    arg4Quotation = "\"";
-                std::string script;
-                script.append(*it)
-                    .append(" ")
-                    .append(arg1Quotation)
-                    .append(arg1)
-                    .append(arg1Quotation)
-                    .append(" ")
-                    .append(arg2Quotation)
-                    .append(arg2)
-                    .append(arg2Quotation)
-                    .append(" ")
-                    .append(arg3Quotation)
-                    .append(arg3)
-                    .append(arg3Quotation)
-                    .append(" ")
-                    .append(arg4Quotation)
-                    .append(arg4)
-                    .append(arg4Quotation);
-                LOG(LogDebug) << "Executing: " << script;
-#if defined(__ANDROID__)
-                Utils::Platform::runSystemCommand("sh " + script);
-#else
-                Utils::Platform::runSystemCommand(script);
-#endif
-            }
-        }
+        EventDispatcher::getInstance().dispatch({eventName, arg1, arg2, arg3, arg4}, async);
     }
 } // namespace Scripting
@@ -344,18 +344,34 @@ void Settings::setDefaults()
     mBoolMap["DebugSkipMissingThemeFilesCustomCollections"] = {true, true};
     mBoolMap["LegacyGamelistFileLocation"] = {false, false};
     mBoolMap["CreatePlaceholderSystemDirectories"] = {false, false};
+    mBoolMap["ROMDirectoryIndex"] = {true, true};
+    mBoolMap["ROMHashDatabase"] = {true, true};
+    mBoolMap["SkipIdleFrames"] = {true, true};
+    mBoolMap["ThemeCache"] = {true, true};
+    mBoolMap["VideoYUVPlanes"] = {false, false};
     mStringMap["OpenGLVersion"] = {"", ""};
 #if !defined(__ANDROID__)
     mStringMap["ROMDirectory"] = {"", ""};
 #endif
+    mStringMap["ScraperServerScreenScraper"] = {"", ""};
+    mStringMap["ScraperServerTheGamesDB"] = {"", ""};
     mStringMap["UIMode_passkey"] = {"uuddlrlrba", "uuddlrlrba"};
 #if !defined(__ANDROID__)
     mStringMap["UserThemeDirectory"] = {"", ""};
 #endif
+    mIntMap["GamelistViewCacheSize"] = {0, 0};
     mIntMap["LottieMaxFileCache"] = {150, 150};
     mIntMap["LottieMaxTotalCache"] = {1024, 1024};
+    mIntMap["PDFPageCacheSize"] = {256, 256};
+    mIntMap["ScraperCacheMaxAge"] = {7, 7};
+    mIntMap["ScraperCacheSize"] = {2048, 2048};
+    mIntMap["ScraperConcurrencyScreenScraper"] = {0, 0};
+    mIntMap["ScraperConcurrencyTheGamesDB"] = {4, 4};
     mIntMap["ScraperConnectionTimeout"] = {30, 30};
     mIntMap["ScraperTransferTimeout"] = {120, 120};
+    mIntMap["SystemLoadingThreads"] = {0, 0};
+    mIntMap["TextureCacheSize"] = {512, 512};
+    mIntMap["TextureLoaderThreads"] = {0, 0};
 
     //
     // Hardcoded or program-internal settings.
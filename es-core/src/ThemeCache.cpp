@@ -0,0 +1,168 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  ThemeCache.cpp
+//
+//  On-disk cache of resolved theme configurations, used by ThemeData to avoid having to
+//  parse the XML files and resolve all variables every time a system theme is loaded.
+//  Entries are invalidated when any of the theme files they were compiled from change.
+//
+
+#include "ThemeCache.h"
+
+#include "Log.h"
+#include "Settings.h"
+#include "utils/CacheFileUtil.h"
+#include "utils/FileSystemUtil.h"
+
+namespace
+{
+    // Increase the version whenever the theme parsing logic changes as well.
+    const std::string cacheFileMagic {"ESDETHMC"};
+    const unsigned int cacheFileVersion {1};
+
+    // Each combination of system, variant, color scheme, font size and aspect ratio gets its
+    // own file, so the least recently used files are removed when this size is exceeded.
+    const long long maxCacheSize {128 * 1024 * 1024};
+} // namespace
+
+ThemeCache::ThemeCache()
+    : mCacheDirectory {Utils::FileSystem::getAppDataDirectory() + "/cache/themes"}
+    , mDirectoryLimiter {mCacheDirectory}
+{
+}
+
+ThemeCache& ThemeCache::getInstance()
+{
+    static ThemeCache instance;
+    return instance;
+}
+
+bool ThemeCache::read(const std::string& key,
+                      std::map<std::string, ThemeData::ThemeView>& views,
+                      std::map<std::string, std::string>& variables,
+                      std::string& transitions)
+{
+    if (!Settings::getInstance()->getBool("ThemeCache"))
+        return false;
+
+    const std::string cachePath {Utils::CacheFile::getHashedPath(mCacheDirectory, key)};
+    Utils::CacheFile::Reader reader {cachePath, cacheFileMagic, cacheFileVersion};
+
+    // Different keys could end up with the same file name if there is a hash collision.
+    if (!reader.isValid() || reader.readString() != key)
+        return false;
+
+    const unsigned int sourceCount {reader.read<unsigned int>()};
+    for (unsigned int i {0}; i < sourceCount && reader.isValid(); ++i) {
+        const std::string path {reader.readString()};
+        const long long modTime {reader.read<long long>()};
+        const long long fileSize {reader.read<long long>()};
+        if (!reader.isValid() || modTime != Utils::FileSystem::getModificationTime(path) ||
+            fileSize != Utils::FileSystem::getFileSize(path))
+            return false;
+    }
+
+    std::map<std::string, ThemeData::ThemeView> cachedViews;
+    std::map<std::string, std::string> cachedVariables;
+    const std::string cachedTransitions {reader.readString()};
+
+    const unsigned int variableCount {reader.read<unsigned int>()};
+    for (unsigned int i {0}; i < variableCount && reader.isValid(); ++i) {
+        const std::string name {reader.readString()};
+        cachedVariables[name] = reader.readString();
+    }
+
+    const unsigned int viewCount {reader.read<unsigned int>()};
+    for (unsigned int i {0}; i < viewCount && reader.isValid(); ++i) {
+        ThemeData::ThemeView& view {cachedViews[reader.readString()]};
+        const unsigned int elementCount {reader.read<unsigned int>()};
+        for (unsigned int j {0}; j < elementCount && reader.isValid(); ++j) {
+            ThemeData::ThemeElement& element {view.elements[reader.readString()]};
+            element.type = reader.readString();
+            const unsigned int propertyCount {reader.read<unsigned int>()};
+            for (unsigned int k {0}; k < propertyCount && reader.isValid(); ++k) {
+                ThemeData::ThemeElement::Property& property {
+                    element.properties[reader.readString()]};
+                property.r = reader.read<glm::vec4>();
+                property.v = reader.read<glm::vec2>();
+                property.s = reader.readString();
+                property.i = reader.read<unsigned int>();
+                property.f = reader.read<float>();
+                property.b = reader.read<bool>();
+            }
+        }
+    }
+
+    if (!reader.isValid()) {
+        LOG(LogWarning) << "ThemeCache: Cache file \"" << cachePath
+                        << "\" is corrupt, the theme will be parsed instead";
+        return false;
+    }
+
+    views = std::move(cachedViews);
+    variables = std::move(cachedVariables);
+    transitions = cachedTransitions;
+
+    Utils::CacheFile::touchFile(cachePath);
+
+    return true;
+}
+
+void ThemeCache::write(const std::string& key,
+                       const std::vector<std::string>& sourceFiles,
+                       const std::map<std::string, ThemeData::ThemeView>& views,
+                       const std::map<std::string, std::string>& variables,
+                       const std::string& transitions)
+{
+    if (!Settings::getInstance()->getBool("ThemeCache"))
+        return;
+
+    const std::string cachePath {Utils::CacheFile::getHashedPath(mCacheDirectory, key)};
+    Utils::CacheFile::Writer writer {cachePath, cacheFileMagic, cacheFileVersion};
+    writer.writeString(key);
+
+    writer.write<unsigned int>(static_cast<unsigned int>(sourceFiles.size()));
+    for (auto& path : sourceFiles) {
+        writer.writeString(path);
+        writer.write<long long>(Utils::FileSystem::getModificationTime(path));
+        writer.write<long long>(Utils::FileSystem::getFileSize(path));
+    }
+
+    writer.writeString(transitions);
+
+    writer.write<unsigned int>(static_cast<unsigned int>(variables.size()));
+    for (auto& variable : variables) {
+        writer.writeString(variable.first);
+        writer.writeString(variable.second);
+    }
+
+    writer.write<unsigned int>(static_cast<unsigned int>(views.size()));
+    for (auto& view : views) {
+        writer.writeString(view.first);
+        writer.write<unsigned int>(static_cast<unsigned int>(view.second.elements.size()));
+        for (auto& element : view.second.elements) {
+            writer.writeString(element.first);
+            writer.writeString(element.second.type);
+            writer.write<unsigned int>(
+                static_cast<unsigned int>(element.second.properties.size()));
+            for (auto& property : element.second.properties) {
+                writer.writeString(property.first);
+                writer.write<glm::vec4>(property.second.r);
+                writer.write<glm::vec2>(property.second.v);
+                writer.writeString(property.second.s);
+                writer.write<unsigned int>(property.second.i);
+                writer.write<float>(property.second.f);
+                writer.write<bool>(property.second.b);
+            }
+        }
+    }
+
+    const long long fileSize {writer.commit()};
+    if (fileSize == -1) {
+        LOG(LogWarning) << "ThemeCache: Couldn't write cache file \"" << cachePath << "\"";
+        return;
+    }
+
+    mDirectoryLimiter.addFile(fileSize, maxCacheSize);
+}
@@ -0,0 +1,47 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  ThemeCache.h
+//
+//  On-disk cache of resolved theme configurations, used by ThemeData to avoid having to
+//  parse the XML files and resolve all variables every time a system theme is loaded.
+//  Entries are invalidated when any of the theme files they were compiled from change.
+//
+
+#ifndef ES_CORE_THEME_CACHE_H
+#define ES_CORE_THEME_CACHE_H
+
+#include "ThemeData.h"
+#include "utils/CacheFileUtil.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+class ThemeCache
+{
+public:
+    static ThemeCache& getInstance();
+
+    // The key should contain everything apart from the theme files that affects the result
+    // of the theme loading, such as the system variables and the selected variant. Returns
+    // false if there is no entry or if any of the source files have been modified.
+    bool read(const std::string& key,
+              std::map<std::string, ThemeData::ThemeView>& views,
+              std::map<std::string, std::string>& variables,
+              std::string& transitions);
+
+    void write(const std::string& key,
+               const std::vector<std::string>& sourceFiles,
+               const std::map<std::string, ThemeData::ThemeView>& views,
+               const std::map<std::string, std::string>& variables,
+               const std::string& transitions);
+
+private:
+    ThemeCache();
+
+    std::string mCacheDirectory;
+    Utils::CacheFile::DirectoryLimiter mDirectoryLimiter;
+};
+
+#endif // ES_CORE_THEME_CACHE_H
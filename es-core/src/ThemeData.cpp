@@ -12,6 +12,7 @@
 
 #include "Log.h"
 #include "Settings.h"
+#include "ThemeCache.h"
 #include "components/ImageComponent.h"
 #include "components/TextComponent.h"
 #include "utils/FileSystemUtil.h"
@@ -566,23 +567,6 @@ void ThemeData::loadFile(const std::map<std::string, std::string>& sysDataMap,
 
     mVariables.insert(sysDataMap.cbegin(), sysDataMap.cend());
 
-    pugi::xml_document doc;
-#if defined(_WIN64)
-    pugi::xml_parse_result res {doc.load_file(Utils::String::stringToWideString(path).c_str())};
-#else
-    pugi::xml_parse_result res {doc.load_file(path.c_str())};
-#endif
-    if (!res)
-        throw error << ": XML parsing error: " << res.description();
-
-    pugi::xml_node root {doc.child("theme")};
-    if (!root)
-        throw error << ": Missing <theme> tag";
-
-    // Check if there's an unsupported theme version tag.
-    if (root.child("formatVersion") != nullptr)
-        throw error << ": Unsupported <formatVersion> tag found";
-
     if (sCurrentTheme->second.capabilities.variants.size() > 0) {
         for (auto& variant : sCurrentTheme->second.capabilities.variants)
             mVariants.emplace_back(variant.name);
@@ -660,6 +644,42 @@ void ThemeData::loadFile(const std::map<std::string, std::string>& sysDataMap,
         }
     }
 
+    // The resolved theme only depends on the theme files and on the selections and variables
+    // that are known at this point, so these are used as the key for the theme cache.
+    std::string cacheKey {path};
+    cacheKey.append("\n")
+        .append(mSelectedVariant)
+        .append("\n")
+        .append(mOverrideVariant)
+        .append("\n")
+        .append(mSelectedColorScheme)
+        .append("\n")
+        .append(mSelectedFontSize)
+        .append("\n")
+        .append(sSelectedAspectRatio)
+        .append("\n")
+        .append(mCustomCollection ? "1" : "0");
+    for (auto& variable : mVariables)
+        cacheKey.append("\n").append(variable.first).append("=").append(variable.second);
+
+    if (ThemeCache::getInstance().read(cacheKey, mViews, mVariables, sVariantDefinedTransitions))
+        return;
+
+    mSourceFiles.clear();
+    mSourceFiles.emplace_back(path);
+    if (sCurrentTheme != sThemes.end())
+        mSourceFiles.emplace_back(sCurrentTheme->second.path + "/capabilities.xml");
+
+    const std::shared_ptr<const pugi::xml_document> doc {loadDocument(path, error)};
+
+    pugi::xml_node root {doc->child("theme")};
+    if (!root)
+        throw error << ": Missing <theme> tag";
+
+    // Check if there's an unsupported theme version tag.
+    if (root.child("formatVersion") != nullptr)
+        throw error << ": Unsupported <formatVersion> tag found";
+
     parseVariables(root);
     parseColorSchemes(root);
     parseFontSizes(root);
@@ -669,6 +689,9 @@ void ThemeData::loadFile(const std::map<std::string, std::string>& sysDataMap,
         throw error << ": Unsupported <feature> tag found";
     parseVariants(root);
     parseAspectRatios(root);
+
+    ThemeCache::getInstance().write(cacheKey, mSourceFiles, mViews, mVariables,
+                                    sVariantDefinedTransitions);
 }
 
 bool ThemeData::hasView(const std::string& view)
@@ -776,7 +799,15 @@ void ThemeData::populateThemes()
 #else
                 LOG(LogDebug) << "Loading theme capabilities for \"" << *it << "\"...";
 #endif
-                ThemeCapability capabilities {parseThemeCapabilities((*it))};
+                const std::string capFile {*it + "/capabilities.xml"};
+                const long long modTime {Utils::FileSystem::getModificationTime(capFile)};
+                auto cacheIt = sCapabilityCache.find(*it);
+                if (cacheIt == sCapabilityCache.end() || modTime == -1 ||
+                    cacheIt->second.modTime != modTime) {
+                    sCapabilityCache[*it] = {modTime, parseThemeCapabilities((*it))};
+                    cacheIt = sCapabilityCache.find(*it);
+                }
+                ThemeCapability capabilities {cacheIt->second.capabilities};
 
                 if (!capabilities.validTheme)
                     continue;
@@ -1515,6 +1546,37 @@ ThemeData::ThemeCapability ThemeData::parseThemeCapabilities(const std::string&
     return capabilities;
 }
 
+std::shared_ptr<const pugi::xml_document> ThemeData::loadDocument(const std::string& path,
+                                                                   ThemeException& error)
+{
+    const long long modTime {Utils::FileSystem::getModificationTime(path)};
+    const std::string themePath {sCurrentTheme != sThemes.end() ? sCurrentTheme->second.path : ""};
+
+    {
+        std::unique_lock<std::mutex> lock {sDocumentCacheMutex};
+        if (sDocumentCacheTheme != themePath) {
+            sDocumentCache.clear();
+            sDocumentCacheTheme = themePath;
+        }
+        auto cacheIt = sDocumentCache.find(path);
+        if (cacheIt != sDocumentCache.end() && modTime != -1 && cacheIt->second.modTime == modTime)
+            return cacheIt->second.document;
+    }
+
+    std::shared_ptr<pugi::xml_document> doc {std::make_shared<pugi::xml_document>()};
+#if defined(_WIN64)
+    pugi::xml_parse_result res {doc->load_file(Utils::String::stringToWideString(path).c_str())};
+#else
+    pugi::xml_parse_result res {doc->load_file(path.c_str())};
+#endif
+    if (!res)
+        throw error << ": XML parsing error: " << res.description();
+
+    std::unique_lock<std::mutex> lock {sDocumentCacheMutex};
+    sDocumentCache[path] = {modTime, doc};
+    return doc;
+}
+
 void ThemeData::parseIncludes(const pugi::xml_node& root)
 {
     for (pugi::xml_node node {root.child("include")}; node; node = node.next_sibling("include")) {
@@ -1528,6 +1590,7 @@ void ThemeData::parseIncludes(const pugi::xml_node& root)
 
         std::string relPath {resolvePlaceholders(node.text().as_string())};
         std::string path {Utils::FileSystem::resolveRelativePath(relPath, mPaths.back(), true)};
+        mSourceFiles.emplace_back(path);
 
         if (!ResourceManager::getInstance().fileExists(path)) {
             // For explicit paths, throw an error if the file couldn't be found, but only
@@ -1562,17 +1625,9 @@ void ThemeData::parseIncludes(const pugi::xml_node& root)
 
         mPaths.push_back(path);
 
-        pugi::xml_document includeDoc;
-#if defined(_WIN64)
-        pugi::xml_parse_result result {
-            includeDoc.load_file(Utils::String::stringToWideString(path).c_str())};
-#else
-        pugi::xml_parse_result result {includeDoc.load_file(path.c_str())};
-#endif
-        if (!result)
-            throw error << ": Error parsing file: " << result.description();
+        const std::shared_ptr<const pugi::xml_document> includeDoc {loadDocument(path, error)};
 
-        pugi::xml_node theme {includeDoc.child("theme")};
+        pugi::xml_node theme {includeDoc->child("theme")};
         if (!theme)
             throw error << ": Missing <theme> tag";
 
@@ -21,6 +21,7 @@
 #include <deque>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <vector>
 
@@ -63,6 +64,11 @@ namespace ThemeTriggers
     };
 } // namespace ThemeTriggers
 
+namespace pugi
+{
+    class xml_document;
+}
+
 class ThemeException : public std::exception
 {
 public:
@@ -109,12 +115,12 @@ public:
             void operator=(const float& value) { f = value; }
             void operator=(const bool& value) { b = value; }
 
-            glm::vec4 r;
-            glm::vec2 v;
+            glm::vec4 r {};
+            glm::vec2 v {};
             std::string s;
-            unsigned int i;
-            float f;
-            bool b;
+            unsigned int i {0};
+            float f {0.0f};
+            bool b {false};
         };
 
         std::map<std::string, Property> properties;
@@ -250,6 +256,21 @@ private:
 
     static ThemeCapability parseThemeCapabilities(const std::string& path);
 
+    // Parsed theme files are shared between all ThemeData instances as the same include files
+    // are normally used by every system. Entries are invalidated if the file modification time
+    // changes, and the cache is cleared when a different theme is loaded.
+    struct CachedDocument {
+        long long modTime;
+        std::shared_ptr<const pugi::xml_document> document;
+    };
+    struct CachedCapability {
+        long long modTime;
+        ThemeCapability capabilities;
+    };
+
+    static std::shared_ptr<const pugi::xml_document> loadDocument(const std::string& path,
+                                                                  ThemeException& error);
+
     void parseIncludes(const pugi::xml_node& root);
     void parseVariants(const pugi::xml_node& root);
     void parseColorSchemes(const pugi::xml_node& root);
@@ -279,8 +300,15 @@ private:
     static inline std::map<std::string, Theme, StringComparator>::iterator sCurrentTheme {};
     static inline std::string sVariantDefinedTransitions;
 
+    static inline std::map<std::string, CachedDocument> sDocumentCache;
+    static inline std::map<std::string, CachedCapability> sCapabilityCache;
+    static inline std::string sDocumentCacheTheme;
+    static inline std::mutex sDocumentCacheMutex;
+
     std::map<std::string, ThemeView> mViews;
     std::deque<std::string> mPaths;
+    // All theme files including those which were not found, used for validating the cache.
+    std::vector<std::string> mSourceFiles;
     std::vector<std::string> mVariants;
     std::vector<std::string> mColorSchemes;
     std::vector<std::string> mFontSizes;
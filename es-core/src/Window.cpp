@@ -17,6 +17,7 @@
 #include "components/ImageComponent.h"
 #include "guis/GuiInfoPopup.h"
 #include "resources/Font.h"
+#include "resources/FrameBufferPool.h"
 
 #if defined(__ANDROID__)
 #include "InputOverlay.h"
@@ -41,8 +42,12 @@ Window::Window() noexcept
     , mFrameCountElapsed {0}
     , mAverageDeltaTime {10}
     , mTimeSinceLastInput {0}
+    , mIdleTime {0}
+    , mSkippedFrames {0}
     , mBlockInput {false}
     , mNormalizeNextUpdate {false}
+    , mRedrawRequested {true}
+    , mIdle {false}
     , mRenderScreensaver {false}
     , mRenderMediaViewer {false}
     , mRenderLaunchScreen {false}
@@ -213,6 +218,8 @@ void Window::deinit()
 
     mPostprocessedBackground.reset();
 
+    LOG(LogDebug) << "Window::deinit(): Skipped " << mSkippedFrames << " frames while idle";
+
     InputManager::getInstance().deinit();
     ResourceManager::getInstance().unloadAll();
     mRenderer->deinit();
@@ -367,6 +374,8 @@ void Window::update(int deltaTime)
             deltaTime = mAverageDeltaTime;
     }
 
+    bool renderStatistics {false};
+
     mFrameTimeElapsed += deltaTime;
     ++mFrameCountElapsed;
     if (mFrameTimeElapsed > 500) {
@@ -395,9 +404,34 @@ void Window::update(int deltaTime)
             ss << "\nFont VRAM: " << fontVramUsageMiB
                << " MiB\nTexture VRAM: " << textureVramUsageMiB
                << " MiB\nMax Texture VRAM: " << textureTotalUsageMiB << " MiB";
+
+            // Texture loader.
+            const TextureLoader::Statistics loaderStats {TextureResource::getLoaderStatistics()};
+            ss << "\nTexture queue: " << loaderStats.queueDepth << " (decoded "
+               << loaderStats.decodedCount << ", avg " << loaderStats.averageDecodeTime
+               << " ms, dropped " << loaderStats.cancelledCount << ")";
+
+            // Video frame buffer pool.
+            const FrameBufferPool::Statistics poolStats {
+                FrameBufferPool::getInstance().getStatistics()};
+            ss << "\nVideo frame pool: " << poolStats.hits << " hits, " << poolStats.misses
+               << " misses (" << poolStats.pooledBytes / 1024 / 1024 << " MiB)";
+
+            // Renderer.
+            const Renderer::FrameStatistics& frameStats {mRenderer->getFrameStatistics()};
+            ss << "\nDraw calls: " << frameStats.drawCalls << " (batched "
+               << frameStats.batchedDraws << ")\nVertex uploads: " << frameStats.vertexUploads
+               << " (" << std::setprecision(1)
+               << static_cast<float>(frameStats.uploadedBytes) / 1024.0f << " KiB)";
+
+            // Idle frame skipping.
+            ss << "\nSkipped idle frames: " << mSkippedFrames;
+
             mFrameDataText = std::unique_ptr<TextCache>(mDefaultFonts.at(0)->buildTextCache(
                 ss.str(), mRenderer->getScreenWidth() * 0.02f, mRenderer->getScreenHeight() * 0.02f,
                 0xFF00FFFF, 1.3f));
+            // Render a single frame so the statistics are updated also while idle.
+            renderStatistics = true;
         }
 
         mFrameTimeElapsed = 0;
@@ -452,6 +486,36 @@ void Window::update(int deltaTime)
     if (Settings::getInstance()->getBool("InputTouchOverlay"))
         InputOverlay::getInstance().update(deltaTime);
 #endif
+
+    // This is checked here rather than in render() as rendering is skipped while idle.
+    unsigned int screensaverTimer {
+        static_cast<unsigned int>(Settings::getInstance()->getInt("ScreensaverTimer"))};
+    if (mTimeSinceLastInput >= screensaverTimer && screensaverTimer != 0) {
+        // If the media viewer or PDF viewer is running, or if a menu is open, then reset the
+        // screensaver timer so that the screensaver won't start.
+        if (mRenderMediaViewer || mRenderPDFViewer || mGuiStack.front() != mGuiStack.back())
+            mTimeSinceLastInput = 0;
+        // If a game has been launched, reset the screensaver timer as we don't want to start
+        // the screensaver in the background when running a game.
+        else if (mGameLaunchedState)
+            mTimeSinceLastInput = 0;
+        else if (!isProcessing() && !mScreensaver->isScreensaverActive())
+            startScreensaver(true);
+    }
+
+    // Rendering is skipped once nothing on screen has changed for a short while. The delay
+    // gives one-off changes that are not tracked, such as image fade-ins once a texture has
+    // been loaded, time to complete.
+    if (mRedrawRequested || !Settings::getInstance()->getBool("SkipIdleFrames") || isAnimating())
+        mIdleTime = 0;
+    else
+        mIdleTime = std::min(mIdleTime + static_cast<unsigned int>(deltaTime), 60000u);
+
+    mRedrawRequested = false;
+    mIdle = mIdleTime > IDLE_DELAY && !renderStatistics;
+
+    if (mIdle)
+        ++mSkippedFrames;
 }
 
 bool Window::isBackgroundDimmed()
@@ -518,9 +582,17 @@ void Window::render()
 #if (CLOCK_BACKGROUND_CREATION)
                 const auto backgroundStartTime = std::chrono::system_clock::now();
 #endif
-                std::vector<unsigned char> processedTexture(
-                    static_cast<size_t>(mRenderer->getScreenWidth()) *
-                    static_cast<size_t>(mRenderer->getScreenHeight()) * 4);
+                size_t textureWidth {static_cast<size_t>(mRenderer->getScreenWidth())};
+                size_t textureHeight {static_cast<size_t>(mRenderer->getScreenHeight())};
+                if (mRenderer->getScreenRotation() == 90 || mRenderer->getScreenRotation() == 270)
+                    std::swap(textureWidth, textureHeight);
+
+                // The post-processed background is copied to this texture and is never read
+                // back to RAM, the ownership is then passed to mPostprocessedBackground.
+                const unsigned int backgroundTexture {mRenderer->createTexture(
+                    0, Renderer::TextureType::RGBA, true, false, false, false,
+                    static_cast<unsigned int>(textureWidth),
+                    static_cast<unsigned int>(textureHeight), nullptr)};
 
                 // De-focus the background using multiple passes of gaussian blur, with the number
                 // of iterations relative to the screen resolution.
@@ -544,7 +616,8 @@ void Window::render()
                     mRenderer->shaderPostprocessing(Renderer::Shader::CORE |
                                                         Renderer::Shader::BLUR_HORIZONTAL |
                                                         Renderer::Shader::BLUR_VERTICAL,
-                                                    backgroundParameters, &processedTexture[0]);
+                                                    backgroundParameters, nullptr,
+                                                    backgroundTexture);
                 }
                 else {
                     // Dim the background slightly.
@@ -554,19 +627,11 @@ void Window::render()
                         backgroundParameters.dimming = 0.80f;
 
                     mRenderer->shaderPostprocessing(Renderer::Shader::CORE, backgroundParameters,
-                                                    &processedTexture[0]);
+                                                    nullptr, backgroundTexture);
                 }
 
-                if (mRenderer->getScreenRotation() == 0 || mRenderer->getScreenRotation() == 180) {
-                    mPostprocessedBackground->initFromPixels(
-                        &processedTexture[0], static_cast<size_t>(mRenderer->getScreenWidth()),
-                        static_cast<size_t>(mRenderer->getScreenHeight()));
-                }
-                else {
-                    mPostprocessedBackground->initFromPixels(
-                        &processedTexture[0], static_cast<size_t>(mRenderer->getScreenHeight()),
-                        static_cast<size_t>(mRenderer->getScreenWidth()));
-                }
+                mPostprocessedBackground->initFromTexture(backgroundTexture, textureWidth,
+                                                          textureHeight);
 
                 mBackgroundOverlay->setImage(mPostprocessedBackground);
 
@@ -641,21 +706,6 @@ void Window::render()
         delete cache;
     }
 
-    unsigned int screensaverTimer {
-        static_cast<unsigned int>(Settings::getInstance()->getInt("ScreensaverTimer"))};
-    if (mTimeSinceLastInput >= screensaverTimer && screensaverTimer != 0) {
-        // If the media viewer or PDF viewer is running, or if a menu is open, then reset the
-        // screensaver timer so that the screensaver won't start.
-        if (mRenderMediaViewer || mRenderPDFViewer || mGuiStack.front() != mGuiStack.back())
-            mTimeSinceLastInput = 0;
-        // If a game has been launched, reset the screensaver timer as we don't want to start
-        // the screensaver in the background when running a game.
-        else if (mGameLaunchedState)
-            mTimeSinceLastInput = 0;
-        else if (!isProcessing() && !mScreensaver->isScreensaverActive())
-            startScreensaver(true);
-    }
-
     if (mInfoPopup)
         mInfoPopup->render(trans);
 
@@ -940,6 +990,28 @@ void Window::invalidateCachedBackground()
     mInitiateCacheTimer = true;
 }
 
+bool Window::isAnimating()
+{
+    // Idle frame skipping only applies to the system and gamelist views.
+    if (mGuiStack.size() != 1 || mRenderScreensaver || mRenderMediaViewer || mRenderPDFViewer ||
+        mRenderLaunchScreen)
+        return true;
+
+    if (!mInfoPopupQueue.empty() || (mInfoPopup != nullptr && mInfoPopup->isRunning()) ||
+        mListScrollOpacity != 0.0f || mInvalidateCacheTimer > 0)
+        return true;
+
+    if (mVideoPlayerCount > 0 || TextureResource::isLoading() || isProcessing())
+        return true;
+
+#if defined(__ANDROID__)
+    if (Settings::getInstance()->getBool("InputTouchOverlay"))
+        return true;
+#endif
+
+    return mGuiStack.front()->isAnimating();
+}
+
 bool Window::isProcessing()
 {
     return count_if(mGuiStack.cbegin(), mGuiStack.cend(),
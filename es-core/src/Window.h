@@ -29,6 +29,11 @@ class InputConfig;
 class TextCache;
 struct HelpStyle;
 
+// Time in ms that nothing on screen must have changed before rendering is skipped.
+#define IDLE_DELAY 500
+// Maximum time in ms to wait for input while idle, so timers keep running.
+#define IDLE_WAIT_TIME 250
+
 class Window
 {
 public:
@@ -49,6 +54,8 @@ public:
 
         virtual FileData* getCurrentGame() = 0;
         virtual void triggerNextGame() = 0;
+        // Called when the metadata or media files for a game have changed.
+        virtual void onFileChanged(FileData* file) = 0;
     };
 
     class MediaViewer
@@ -104,7 +111,18 @@ public:
     void render();
 
     void setBlockInput(const bool state) { mBlockInput = state; }
-    void normalizeNextUpdate() { mNormalizeNextUpdate = true; }
+    void normalizeNextUpdate()
+    {
+        mNormalizeNextUpdate = true;
+        mRedrawRequested = true;
+    }
+
+    // Rendering is skipped while nothing on screen is changing, in which case the main loop
+    // can wait for input for up to getIdleWaitTime() milliseconds before calling update().
+    void requestRedraw() { mRedrawRequested = true; }
+    bool isIdle() { return mIdle; }
+    int getIdleWaitTime() { return mIdle ? IDLE_WAIT_TIME : 0; }
+    unsigned int getSkippedFrames() { return mSkippedFrames; }
 
     enum class SplashScreenState {
         SCANNING,
@@ -131,6 +149,11 @@ public:
     void startScreensaver(bool onTimer);
     bool stopScreensaver();
     void screensaverTriggerNextGame() { mScreensaver->triggerNextGame(); }
+    void screensaverOnFileChanged(FileData* file)
+    {
+        if (mScreensaver)
+            mScreensaver->onFileChanged(file);
+    }
     void setScreensaver(Screensaver* screensaver) { mScreensaver = screensaver; }
     bool isScreensaverActive() { return mRenderScreensaver; }
 
@@ -175,6 +198,8 @@ private:
 
     // Returns true if at least one component on the stack is processing.
     bool isProcessing();
+    // Returns true if anything on screen is changing or is about to change.
+    bool isAnimating();
 
     struct ProgressBarRectangle {
         float barWidth;
@@ -219,9 +244,13 @@ private:
     int mFrameCountElapsed;
     int mAverageDeltaTime;
     unsigned int mTimeSinceLastInput;
+    unsigned int mIdleTime;
+    unsigned int mSkippedFrames;
 
     bool mBlockInput;
     bool mNormalizeNextUpdate;
+    bool mRedrawRequested;
+    bool mIdle;
 
     bool mRenderScreensaver;
     bool mRenderMediaViewer;
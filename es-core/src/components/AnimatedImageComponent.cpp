@@ -85,6 +85,11 @@ void AnimatedImageComponent::update(int deltaTime)
     }
 }
 
+bool AnimatedImageComponent::isAnimating()
+{
+    return (mEnabled && mFrames.size() > 1) || GuiComponent::isAnimating();
+}
+
 void AnimatedImageComponent::render(const glm::mat4& trans)
 {
     if (mFrames.size())
@@ -35,6 +35,7 @@ public:
     void reset(); // Set to frame 0.
 
     void update(int deltaTime) override;
+    bool isAnimating() override;
     void render(const glm::mat4& trans) override;
 
     void onSizeChanged() override;
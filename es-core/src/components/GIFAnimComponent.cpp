@@ -23,9 +23,6 @@ GIFAnimComponent::GIFAnimComponent()
     : mRenderer {Renderer::getInstance()}
     , mTargetSize {0.0f, 0.0f}
     , mFrameSize {0}
-    , mAnimFile {nullptr}
-    , mAnimation {nullptr}
-    , mFrame {nullptr}
     , mStartDirection {"normal"}
     , mTotalFrames {0}
     , mFrameNum {0}
@@ -36,7 +33,6 @@ GIFAnimComponent::GIFAnimComponent()
     , mSpeedModifier {1.0f}
     , mTargetPacing {0}
     , mTimeAccumulator {0}
-    , mLastRenderedFrame {-1}
     , mSkippedFrames {0}
     , mHoldFrame {true}
     , mPause {false}
@@ -66,21 +62,11 @@ GIFAnimComponent::GIFAnimComponent()
     mTexture->setLinearMagnify(false);
 }
 
-GIFAnimComponent::~GIFAnimComponent()
-{
-    if (mAnimFile != nullptr) {
-        fclose(mAnimFile);
-        mAnimFile = nullptr;
-    }
-}
-
 void GIFAnimComponent::setAnimation(const std::string& path)
 {
-    if (mAnimation != nullptr) {
-        FreeImage_CloseMultiBitmap(mAnimation, 0);
-        mAnimation = nullptr;
-        mPictureRGBA.clear();
-        mLastRenderedFrame = -1;
+    if (mSource != nullptr) {
+        mSource.reset();
+        mCurrentFrame.reset();
         mFileWidth = 0;
         mFileHeight = 0;
     }
@@ -124,30 +110,18 @@ void GIFAnimComponent::setAnimation(const std::string& path)
         return;
     }
 
+    FILE* animFile {nullptr};
+    FIMULTIBITMAP* animation {nullptr};
+    FIBITMAP* frame {nullptr};
+
     // Make sure that we can actually read this format.
     if (FreeImage_FIFSupportsReading(fileFormat)) {
-
-#if defined(_WIN64)
-        mAnimFile = _wfopen(Utils::String::stringToWideString(mPath).c_str(), L"r+b");
-#else
-        mAnimFile = fopen(mPath.c_str(), "r+b");
-#endif
-        if (mAnimFile != nullptr)
-            mAnimation = FreeImage_OpenMultiBitmapFromHandle(
-                fileFormat, &mAnimIO, static_cast<fi_handle>(mAnimFile), GIF_PLAYBACK);
-
-        mFrame = FreeImage_LockPage(mAnimation, 0);
-        FITAG* tagFrameTime {nullptr};
-
-        FreeImage_GetMetadata(FIMD_ANIMATION, mFrame, "FrameTime", &tagFrameTime);
-        if (tagFrameTime != nullptr) {
-            if (FreeImage_GetTagCount(tagFrameTime) == 1) {
-                const uint32_t frameTime {
-                    *static_cast<const uint32_t*>(FreeImage_GetTagValue(tagFrameTime))};
-                if (frameTime >= 20 && frameTime <= 1000)
-                    mFrameTime = frameTime;
-            }
-        }
+        animFile = openFile(mPath);
+        if (animFile != nullptr)
+            animation = FreeImage_OpenMultiBitmapFromHandle(
+                fileFormat, &mAnimIO, static_cast<fi_handle>(animFile), GIF_PLAYBACK);
+        if (animation != nullptr)
+            frame = FreeImage_LockPage(animation, 0);
     }
     else {
         LOG(LogError) << "GIFAnimComponent::setAnimation(): Couldn't process file \"" << mPath
@@ -155,22 +129,41 @@ void GIFAnimComponent::setAnimation(const std::string& path)
         return;
     }
 
-    if (!mAnimation) {
+    if (frame == nullptr) {
         LOG(LogError) << "GIFAnimComponent::setAnimation(): Couldn't load animation file \""
                       << mPath << "\"";
+        if (animation != nullptr)
+            FreeImage_CloseMultiBitmap(animation, 0);
+        if (animFile != nullptr)
+            fclose(animFile);
         return;
     }
 
+    FITAG* tagFrameTime {nullptr};
+
+    FreeImage_GetMetadata(FIMD_ANIMATION, frame, "FrameTime", &tagFrameTime);
+    if (tagFrameTime != nullptr) {
+        if (FreeImage_GetTagCount(tagFrameTime) == 1) {
+            const uint32_t frameTime {
+                *static_cast<const uint32_t*>(FreeImage_GetTagValue(tagFrameTime))};
+            if (frameTime >= 20 && frameTime <= 1000)
+                mFrameTime = frameTime;
+        }
+    }
+
     size_t width {0};
     size_t height {0};
 
-    unsigned int filePitch {0};
+    mTotalFrames = static_cast<size_t>(FreeImage_GetPageCount(animation));
 
-    mTotalFrames = static_cast<size_t>(FreeImage_GetPageCount(mAnimation));
+    mFileWidth = FreeImage_GetWidth(frame);
+    mFileHeight = FreeImage_GetHeight(frame);
 
-    mFileWidth = FreeImage_GetWidth(mFrame);
-    mFileHeight = FreeImage_GetHeight(mFrame);
-    filePitch = FreeImage_GetPitch(mFrame);
+    // The frames are decoded by the frame cache, so the file only needs to be open for
+    // reading the animation properties.
+    FreeImage_UnlockPage(animation, frame, false);
+    FreeImage_CloseMultiBitmap(animation, 0);
+    fclose(animFile);
 
     if (mTargetIsMax || mSize.x == 0.0f || mSize.y == 0.0f) {
         const double sizeRatio {static_cast<double>(mFileWidth) / static_cast<double>(mFileHeight)};
@@ -221,17 +214,6 @@ void GIFAnimComponent::setAnimation(const std::string& path)
     if (!mTargetIsMax)
         mTargetSize = mSize;
 
-    FreeImage_PreMultiplyWithAlpha(mFrame);
-    mPictureRGBA.resize(mFileWidth * mFileHeight * 4);
-
-    FreeImage_ConvertToRawBits(reinterpret_cast<BYTE*>(&mPictureRGBA.at(0)), mFrame, filePitch, 32,
-                               FI_RGBA_BLUE, FI_RGBA_GREEN, FI_RGBA_RED, 1);
-
-    mTexture->initFromPixels(&mPictureRGBA.at(0), mFileWidth, mFileHeight);
-
-    FreeImage_UnlockPage(mAnimation, mFrame, false);
-    FreeImage_CloseMultiBitmap(mAnimation, 0);
-
     mDirection = mStartDirection;
     mFrameRate = 1000.0 / static_cast<double>(mFrameTime);
     mFrameSize = mFileWidth * mFileHeight * 4;
@@ -240,6 +222,53 @@ void GIFAnimComponent::setAnimation(const std::string& path)
     if (mDirection == "reverse")
         mFrameNum = mTotalFrames - 1;
 
+    // The frames are always decoded at the original resolution, so the same frames can be
+    // used regardless of the component size.
+    const std::string cacheKey {
+        mPath + ":" + std::to_string(Utils::FileSystem::getFileSize(mPath)) + ":" +
+        std::to_string(Utils::FileSystem::getModificationTime(mPath))};
+    const std::string animPath {mPath};
+    FreeImageIO animIO {mAnimIO};
+
+    mSource = AnimationFrameCache::getInstance().getSource(
+        cacheKey, mTotalFrames, mFrameSize,
+        [animPath, animIO]() -> AnimationFrameCache::FrameDecoder {
+            FILE* file {openFile(animPath)};
+            if (file == nullptr)
+                return nullptr;
+            std::shared_ptr<FILE> animFile {file, [](FILE* handle) { fclose(handle); }};
+            return [animFile, animIO](int frameNum, std::vector<uint8_t>& pixels) mutable {
+                FIMULTIBITMAP* animation {FreeImage_OpenMultiBitmapFromHandle(
+                    FIF_GIF, &animIO, static_cast<fi_handle>(animFile.get()), GIF_PLAYBACK)};
+                if (animation == nullptr)
+                    return false;
+                FIBITMAP* frame {FreeImage_LockPage(animation, frameNum)};
+                if (frame == nullptr) {
+                    FreeImage_CloseMultiBitmap(animation, 0);
+                    return false;
+                }
+                FreeImage_PreMultiplyWithAlpha(frame);
+                FreeImage_ConvertToRawBits(reinterpret_cast<BYTE*>(pixels.data()), frame,
+                                           FreeImage_GetPitch(frame), 32, FI_RGBA_RED,
+                                           FI_RGBA_GREEN, FI_RGBA_BLUE, 1);
+                FreeImage_UnlockPage(animation, frame, false);
+                FreeImage_CloseMultiBitmap(animation, 0);
+                return true;
+            };
+        });
+
+    if (mSource == nullptr) {
+        LOG(LogError) << "GIFAnimComponent::setAnimation(): Couldn't load animation file \""
+                      << mPath << "\"";
+        return;
+    }
+
+    // Start decoding the first frames, these may already be available if the animation is
+    // used elsewhere.
+    mCurrentFrame = mSource->getFrame(mFrameNum, mDirection == "reverse");
+    if (mCurrentFrame != nullptr)
+        mTexture->initFromPixels(mCurrentFrame->data(), mFileWidth, mFileHeight);
+
     if (DEBUG_ANIMATION) {
         const int duration {mTargetPacing * mTotalFrames};
         LOG(LogDebug) << "GIFAnimComponent::setAnimation(): Width: " << mFileWidth;
@@ -271,9 +300,6 @@ void GIFAnimComponent::resetComponent()
     mTimeAccumulator = 0;
     mDirection = mStartDirection;
     mFrameNum = mStartDirection == "reverse" ? mTotalFrames - 1 : 0;
-
-    if (mAnimation != nullptr)
-        mLastRenderedFrame = static_cast<int>(mFrameNum);
 }
 
 void GIFAnimComponent::onSizeChanged()
@@ -430,7 +456,7 @@ void GIFAnimComponent::applyTheme(const std::shared_ptr<ThemeData>& theme,
 
 void GIFAnimComponent::update(int deltaTime)
 {
-    if (mAnimation == nullptr || !isVisible() || mOpacity == 0.0f || mThemeOpacity == 0.0f)
+    if (mSource == nullptr || !isVisible() || mOpacity == 0.0f || mThemeOpacity == 0.0f)
         return;
 
     if (mWindow->getAllowFileAnimation()) {
@@ -479,17 +505,29 @@ void GIFAnimComponent::update(int deltaTime)
     }
 }
 
+bool GIFAnimComponent::isAnimating()
+{
+    if (mSource != nullptr && isVisible() && mOpacity != 0.0f && mThemeOpacity != 0.0f &&
+        !mExternalPause && mWindow->getAllowFileAnimation())
+        return true;
+
+    return GuiComponent::isAnimating();
+}
+
 void GIFAnimComponent::render(const glm::mat4& parentTrans)
 {
-    if (mAnimation == nullptr || !isVisible() || mOpacity == 0.0f || mThemeOpacity == 0.0f)
+    if (mSource == nullptr || !isVisible() || mOpacity == 0.0f || mThemeOpacity == 0.0f)
         return;
 
     glm::mat4 trans {parentTrans * getTransform()};
 
     // This is necessary as there may otherwise be no texture to render when paused.
     if ((mExternalPause || mPause) && mTexture->getSize().x == 0.0f) {
-        mTexture->initFromPixels(&mPictureRGBA.at(0), static_cast<size_t>(mSize.x),
-                                 static_cast<size_t>(mSize.y));
+        if (mCurrentFrame == nullptr)
+            mCurrentFrame = mSource->getFrame(glm::clamp(mFrameNum, 0, mTotalFrames - 1),
+                                              mDirection == "reverse");
+        if (mCurrentFrame != nullptr)
+            mTexture->initFromPixels(mCurrentFrame->data(), mFileWidth, mFileHeight);
     }
 
     bool doRender {true};
@@ -542,27 +580,18 @@ void GIFAnimComponent::render(const glm::mat4& parentTrans)
         }
 
         if (!mHoldFrame) {
-            mAnimation = FreeImage_OpenMultiBitmapFromHandle(
-                FIF_GIF, &mAnimIO, static_cast<fi_handle>(mAnimFile), GIF_PLAYBACK);
-
-            mFrame = FreeImage_LockPage(mAnimation, mFrameNum);
-            FreeImage_PreMultiplyWithAlpha(mFrame);
-            mPictureRGBA.clear();
-            mPictureRGBA.resize(mFrameSize);
-
-            FreeImage_ConvertToRawBits(reinterpret_cast<BYTE*>(&mPictureRGBA.at(0)), mFrame,
-                                       FreeImage_GetPitch(mFrame), 32, FI_RGBA_RED, FI_RGBA_GREEN,
-                                       FI_RGBA_BLUE, 1);
-
-            mTexture->initFromPixels(&mPictureRGBA.at(0), mFileWidth, mFileHeight);
-
-            FreeImage_UnlockPage(mAnimation, mFrame, false);
-            FreeImage_CloseMultiBitmap(mAnimation, 0);
-
-            if (mDirection == "reverse")
-                --mFrameNum;
-            else
-                ++mFrameNum;
+            AnimationFrameCache::Frame frame {
+                mSource->getFrame(mFrameNum, mDirection == "reverse")};
+            // If the frame has not been decoded yet, then keep showing the current frame.
+            if (frame != nullptr) {
+                mCurrentFrame = frame;
+                mTexture->initFromPixels(mCurrentFrame->data(), mFileWidth, mFileHeight);
+
+                if (mDirection == "reverse")
+                    --mFrameNum;
+                else
+                    ++mFrameNum;
+            }
         }
     }
 
@@ -12,8 +12,10 @@
 #include "GuiComponent.h"
 #include "ThemeData.h"
 #include "renderers/Renderer.h"
+#include "resources/AnimationFrameCache.h"
 #include "resources/TextureResource.h"
 #include "utils/MathUtil.h"
+#include "utils/StringUtil.h"
 
 #include <FreeImage.h>
 #include <chrono>
@@ -22,7 +24,6 @@ class GIFAnimComponent : public GuiComponent
 {
 public:
     GIFAnimComponent();
-    ~GIFAnimComponent();
 
     void setAnimation(const std::string& path);
     void setPauseAnimation(bool state) { mExternalPause = state; }
@@ -36,6 +37,7 @@ public:
                             unsigned int properties) override;
 
     void update(int deltaTime) override;
+    bool isAnimating() override;
 
 private:
     void render(const glm::mat4& parentTrans) override;
@@ -68,17 +70,24 @@ private:
         return ftell(reinterpret_cast<FILE*>(handle));
     }
 
+    static inline FILE* openFile(const std::string& path)
+    {
+#if defined(_WIN64)
+        return _wfopen(Utils::String::stringToWideString(path).c_str(), L"r+b");
+#else
+        return fopen(path.c_str(), "r+b");
+#endif
+    }
+
     Renderer* mRenderer;
     glm::vec2 mTargetSize;
     std::shared_ptr<TextureResource> mTexture;
-    std::vector<uint8_t> mPictureRGBA;
+    std::shared_ptr<AnimationFrameCache::Source> mSource;
+    AnimationFrameCache::Frame mCurrentFrame;
     size_t mFrameSize;
 
     std::chrono::time_point<std::chrono::system_clock> mAnimationStartTime;
-    FILE* mAnimFile;
     FreeImageIO mAnimIO;
-    FIMULTIBITMAP* mAnimation;
-    FIBITMAP* mFrame;
     std::string mPath;
     std::string mStartDirection;
     std::string mDirection;
@@ -93,7 +102,6 @@ private:
     float mSpeedModifier;
     int mTargetPacing;
     int mTimeAccumulator;
-    int mLastRenderedFrame;
     int mSkippedFrames;
 
     bool mHoldFrame;
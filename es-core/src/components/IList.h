@@ -131,6 +131,15 @@ public:
 
     const int getScrollingVelocity() const { return mScrollVelocity; }
 
+    // Returns how many steps ahead of the cursor that textures should be prefetched, based on
+    // how far the list will scroll within roughly half a second at the current scroll speed.
+    int getPrefetchSteps(int maxSteps) const
+    {
+        if (mScrollVelocity == 0)
+            return 0;
+        return glm::clamp(500 / mTierList.tiers[mScrollTier].scrollDelay, 1, maxSteps);
+    }
+
     void clear()
     {
         mEntries.clear();
@@ -115,6 +115,7 @@ public:
     std::shared_ptr<TextureResource> getTexture() { return mTexture; }
 
     void render(const glm::mat4& parentTrans) override;
+    bool isAnimating() override { return mFading || GuiComponent::isAnimating(); }
 
     void applyTheme(const std::shared_ptr<ThemeData>& theme,
                     const std::string& view,
@@ -18,12 +18,7 @@
 LottieAnimComponent::LottieAnimComponent()
     : mRenderer {Renderer::getInstance()}
     , mTargetSize {0.0f, 0.0f}
-    , mCacheFrames {true}
-    , mMaxCacheSize {0}
-    , mCacheSize {0}
     , mFrameSize {0}
-    , mAnimation {nullptr}
-    , mSurface {nullptr}
     , mStartDirection {"normal"}
     , mTotalFrames {0}
     , mFrameNum {0}
@@ -31,7 +26,6 @@ LottieAnimComponent::LottieAnimComponent()
     , mSpeedModifier {1.0f}
     , mTargetPacing {0}
     , mTimeAccumulator {0}
-    , mLastRenderedFrame {-1}
     , mSkippedFrames {0}
     , mHoldFrame {true}
     , mPause {false}
@@ -48,17 +42,6 @@ LottieAnimComponent::LottieAnimComponent()
     // Get an empty texture for rendering the animation.
     mTexture = TextureResource::get("");
 
-    // Keep per-file cache size within 0 to 1024 MiB.
-    mMaxCacheSize = static_cast<size_t>(
-        glm::clamp(Settings::getInstance()->getInt("LottieMaxFileCache"), 0, 1024) * 1024 * 1024);
-
-    // Keep total cache size within 0 to 4096 MiB.
-    int maxTotalCache {glm::clamp(Settings::getInstance()->getInt("LottieMaxTotalCache"), 0, 4096) *
-                       1024 * 1024};
-
-    if (mMaxTotalFrameCache != static_cast<size_t>(maxTotalCache))
-        mMaxTotalFrameCache = static_cast<size_t>(maxTotalCache);
-
     // Set component defaults.
     setSize(mRenderer->getScreenWidth() * 0.2f, mRenderer->getScreenHeight() * 0.2f);
     setPosition(mRenderer->getScreenWidth() * 0.3f, mRenderer->getScreenHeight() * 0.3f);
@@ -66,25 +49,11 @@ LottieAnimComponent::LottieAnimComponent()
     setZIndex(35.0f);
 }
 
-LottieAnimComponent::~LottieAnimComponent()
-{
-    // This is required as rlottie could otherwise crash on application shutdown.
-    if (mFuture.valid())
-        mFuture.get();
-
-    mTotalFrameCache -= mCacheSize;
-}
-
 void LottieAnimComponent::setAnimation(const std::string& path)
 {
-    if (mAnimation != nullptr) {
-        if (mFuture.valid())
-            mFuture.get();
-        mSurface.reset();
-        mAnimation.reset();
-        mPictureRGBA.clear();
-        mCacheSize = 0;
-        mLastRenderedFrame = -1;
+    if (mSource != nullptr) {
+        mSource.reset();
+        mCurrentFrame.reset();
     }
 
     mPath = path;
@@ -106,20 +75,22 @@ void LottieAnimComponent::setAnimation(const std::string& path)
 
     ResourceData animData {ResourceManager::getInstance().getFileData(mPath)};
     std::string cache;
+    // This is shared with the frame decoder if the animation is not already in the frame cache.
+    std::shared_ptr<rlottie::Animation> animation;
 
     // If in debug mode, then disable the rlottie caching so that animations can be replaced on
     // the fly using Ctrl+r reloads.
     if (Settings::getInstance()->getBool("Debug")) {
-        mAnimation = rlottie::Animation::loadFromData(
+        animation = rlottie::Animation::loadFromData(
             std::string(reinterpret_cast<char*>(animData.ptr.get()), animData.length), cache, "",
             false);
     }
     else {
-        mAnimation = rlottie::Animation::loadFromData(
+        animation = rlottie::Animation::loadFromData(
             std::string(reinterpret_cast<char*>(animData.ptr.get()), animData.length), cache);
     }
 
-    if (mAnimation == nullptr) {
+    if (animation == nullptr) {
         LOG(LogError) << "Couldn't parse Lottie animation file \"" << mPath << "\"";
         return;
     }
@@ -131,7 +102,7 @@ void LottieAnimComponent::setAnimation(const std::string& path)
         size_t viewportWidth {0};
         size_t viewportHeight {0};
 
-        mAnimation->size(viewportWidth, viewportHeight);
+        animation->size(viewportWidth, viewportHeight);
         const double sizeRatio {static_cast<double>(viewportWidth) /
                                 static_cast<double>(viewportHeight)};
 
@@ -181,19 +152,9 @@ void LottieAnimComponent::setAnimation(const std::string& path)
     if (!mTargetIsMax)
         mTargetSize = mSize;
 
-    mPictureRGBA.resize(width * height * 4);
-    mSurface = std::make_unique<rlottie::Surface>(reinterpret_cast<uint32_t*>(&mPictureRGBA[0]),
-                                                  width, height, width * sizeof(uint32_t));
-
-    if (mSurface == nullptr) {
-        LOG(LogError) << "Couldn't create Lottie surface for file \"" << mPath << "\"";
-        mAnimation.reset();
-        return;
-    }
-
     // Some statistics for the file.
-    mTotalFrames = mAnimation->totalFrame();
-    mFrameRate = mAnimation->frameRate();
+    mTotalFrames = animation->totalFrame();
+    mFrameRate = animation->frameRate();
     mFrameSize = width * height * 4;
     mTargetPacing = static_cast<int>((1000.0 / mFrameRate) / static_cast<double>(mSpeedModifier));
 
@@ -203,7 +164,7 @@ void LottieAnimComponent::setAnimation(const std::string& path)
         mFrameNum = mTotalFrames - 1;
 
     if (DEBUG_ANIMATION) {
-        const double duration {mAnimation->duration()};
+        const double duration {animation->duration()};
         LOG(LogDebug) << "LottieAnimComponent::setAnimation(): Rasterized width: " << mSize.x;
         LOG(LogDebug) << "LottieAnimComponent::setAnimation(): Rasterized height: " << mSize.y;
         LOG(LogDebug) << "LottieAnimComponent::setAnimation(): Total number of frames: "
@@ -222,11 +183,34 @@ void LottieAnimComponent::setAnimation(const std::string& path)
                       << std::setprecision(1)
                       << static_cast<double>(mFrameSize * mTotalFrames) / 1024.0 / 1024.0
                       << " MiB)";
-        LOG(LogDebug) << "LottieAnimComponent::setAnimation(): Per file maximum cache size: "
-                      << mMaxCacheSize << " bytes (" << std::fixed << std::setprecision(1)
-                      << static_cast<double>(mMaxCacheSize) / 1024.0 / 1024.0 << " MiB)";
     }
 
+    // The frames are rasterized at the component size, so this is part of the cache key.
+    const std::string cacheKey {
+        mPath + ":" + std::to_string(Utils::FileSystem::getFileSize(mPath)) + ":" +
+        std::to_string(Utils::FileSystem::getModificationTime(mPath)) + ":" +
+        std::to_string(width) + "x" + std::to_string(height)};
+
+    mSource = AnimationFrameCache::getInstance().getSource(
+        cacheKey, static_cast<int>(mTotalFrames), mFrameSize,
+        [animation, width, height]() -> AnimationFrameCache::FrameDecoder {
+            return [animation, width, height](int frameNum, std::vector<uint8_t>& pixels) {
+                rlottie::Surface surface {reinterpret_cast<uint32_t*>(pixels.data()), width,
+                                          height, width * sizeof(uint32_t)};
+                animation->renderSync(static_cast<size_t>(frameNum), surface, false);
+                return true;
+            };
+        });
+
+    if (mSource == nullptr) {
+        LOG(LogError) << "Couldn't create Lottie frame cache entry for file \"" << mPath << "\"";
+        return;
+    }
+
+    // Start rendering the first frames, these may already be available if the animation is
+    // used elsewhere.
+    mCurrentFrame = mSource->getFrame(static_cast<int>(mFrameNum), mDirection == "reverse");
+
     mAnimationStartTime = std::chrono::system_clock::now();
 }
 
@@ -238,12 +222,8 @@ void LottieAnimComponent::resetComponent()
     mDirection = mStartDirection;
     mFrameNum = mStartDirection == "reverse" ? mTotalFrames - 1 : 0;
 
-    if (mAnimation != nullptr) {
-        if (mFuture.valid())
-            mFuture.get();
-        mFuture = mAnimation->render(mFrameNum, *mSurface, false);
-        mLastRenderedFrame = static_cast<int>(mFrameNum);
-    }
+    if (mSource != nullptr)
+        mCurrentFrame = mSource->getFrame(static_cast<int>(mFrameNum), mDirection == "reverse");
 }
 
 void LottieAnimComponent::onSizeChanged()
@@ -400,7 +380,7 @@ void LottieAnimComponent::applyTheme(const std::shared_ptr<ThemeData>& theme,
 
 void LottieAnimComponent::update(int deltaTime)
 {
-    if (mAnimation == nullptr || !isVisible() || mOpacity == 0.0f || mThemeOpacity == 0.0f)
+    if (mSource == nullptr || !isVisible() || mOpacity == 0.0f || mThemeOpacity == 0.0f)
         return;
 
     if (mWindow->getAllowFileAnimation()) {
@@ -449,17 +429,30 @@ void LottieAnimComponent::update(int deltaTime)
     }
 }
 
+bool LottieAnimComponent::isAnimating()
+{
+    if (mSource != nullptr && isVisible() && mOpacity != 0.0f && mThemeOpacity != 0.0f &&
+        !mExternalPause && mWindow->getAllowFileAnimation())
+        return true;
+
+    return GuiComponent::isAnimating();
+}
+
 void LottieAnimComponent::render(const glm::mat4& parentTrans)
 {
-    if (mAnimation == nullptr || !isVisible() || mOpacity == 0.0f || mThemeOpacity == 0.0f)
+    if (mSource == nullptr || !isVisible() || mOpacity == 0.0f || mThemeOpacity == 0.0f)
         return;
 
     glm::mat4 trans {parentTrans * getTransform()};
 
     // This is necessary as there may otherwise be no texture to render when paused.
     if ((mExternalPause || mPause) && mTexture->getSize().x == 0.0f) {
-        mTexture->initFromPixels(&mPictureRGBA.at(0), static_cast<size_t>(mSize.x),
-                                 static_cast<size_t>(mSize.y));
+        if (mCurrentFrame == nullptr)
+            mCurrentFrame = mSource->getFrame(
+                static_cast<int>(std::min(mFrameNum, mTotalFrames - 1)), mDirection == "reverse");
+        if (mCurrentFrame != nullptr)
+            mTexture->initFromPixels(mCurrentFrame->data(), static_cast<size_t>(mSize.x),
+                                     static_cast<size_t>(mSize.y));
     }
 
     bool doRender {true};
@@ -512,64 +505,21 @@ void LottieAnimComponent::render(const glm::mat4& parentTrans)
                 mAnimationStartTime = std::chrono::system_clock::now();
         }
 
-        bool renderNextFrame {false};
-
-        if (mFuture.valid()) {
-            if (mFuture.wait_for(std::chrono::milliseconds(1)) == std::future_status::ready) {
-                mFuture.get();
-                // Cache frame if caching is enabled and we're not exceeding either the per-file
-                // max cache size or the total cache size. Note that this is completely unrelated
-                // to the texture caching used for images.
-                if (mCacheFrames && mLastRenderedFrame != -1 &&
-                    mFrameCache.find(mLastRenderedFrame) == mFrameCache.end()) {
-                    size_t newCacheSize {mCacheSize + mFrameSize};
-                    if (newCacheSize < mMaxCacheSize &&
-                        mTotalFrameCache + mFrameSize < mMaxTotalFrameCache) {
-                        mFrameCache[mLastRenderedFrame] = mPictureRGBA;
-                        mCacheSize += mFrameSize;
-                        mTotalFrameCache += mFrameSize;
-                        mLastRenderedFrame = -1;
-                    }
-                }
-
-                mTexture->initFromPixels(&mPictureRGBA.at(0), static_cast<size_t>(mSize.x),
+        if (!mHoldFrame) {
+            AnimationFrameCache::Frame frame {
+                mSource->getFrame(static_cast<int>(mFrameNum), mDirection == "reverse")};
+            // If the frame has not been rendered yet, then keep showing the current frame.
+            if (frame != nullptr) {
+                mCurrentFrame = frame;
+                mTexture->initFromPixels(mCurrentFrame->data(), static_cast<size_t>(mSize.x),
                                          static_cast<size_t>(mSize.y));
 
                 if (mDirection == "reverse")
                     --mFrameNum;
                 else
                     ++mFrameNum;
-
-                if (mDirection == "reverse" && mFrameNum == 0)
-                    renderNextFrame = false;
-                else if (mFrameNum == mTotalFrames)
-                    renderNextFrame = false;
-                else
-                    renderNextFrame = true;
             }
         }
-        else {
-            if (mFrameCache.find(mFrameNum) != mFrameCache.end()) {
-                if (!mHoldFrame) {
-                    mTexture->initFromPixels(&mFrameCache[mFrameNum][0],
-                                             static_cast<size_t>(mSize.x),
-                                             static_cast<size_t>(mSize.y));
-
-                    if (mDirection == "reverse")
-                        --mFrameNum;
-                    else
-                        ++mFrameNum;
-                }
-            }
-            else {
-                renderNextFrame = true;
-            }
-        }
-
-        if (renderNextFrame && !mHoldFrame) {
-            mFuture = mAnimation->render(mFrameNum, *mSurface, false);
-            mLastRenderedFrame = static_cast<int>(mFrameNum);
-        }
     }
 
     mRenderer->setMatrix(trans);
@@ -16,27 +16,20 @@
 
 #include "GuiComponent.h"
 #include "renderers/Renderer.h"
+#include "resources/AnimationFrameCache.h"
 #include "resources/TextureResource.h"
 #include "utils/MathUtil.h"
 
 #include "rlottie.h"
 
 #include <chrono>
-#include <future>
-#include <unordered_map>
 
 class LottieAnimComponent : public GuiComponent
 {
 public:
     LottieAnimComponent();
-    ~LottieAnimComponent();
 
     void setAnimation(const std::string& path);
-    void setFrameCaching(bool value) { mCacheFrames = value; }
-    void setMaxCacheSize(int value)
-    {
-        mMaxCacheSize = static_cast<size_t>(glm::clamp(value, 0, 1024) * 1024 * 1024);
-    }
     void setPauseAnimation(bool state) { mExternalPause = state; }
 
     void resetComponent() override;
@@ -48,6 +41,7 @@ public:
                             unsigned int properties) override;
 
     void update(int deltaTime) override;
+    bool isAnimating() override;
 
 private:
     void render(const glm::mat4& parentTrans) override;
@@ -55,20 +49,11 @@ private:
     Renderer* mRenderer;
     glm::vec2 mTargetSize;
     std::shared_ptr<TextureResource> mTexture;
-    std::vector<uint8_t> mPictureRGBA;
-    std::unordered_map<size_t, std::vector<uint8_t>> mFrameCache;
-    // Set a 1024 MiB total Lottie animation cache as default.
-    static inline size_t mMaxTotalFrameCache {1024 * 1024 * 1024};
-    static inline size_t mTotalFrameCache;
-    bool mCacheFrames;
-    size_t mMaxCacheSize;
-    size_t mCacheSize;
+    std::shared_ptr<AnimationFrameCache::Source> mSource;
+    AnimationFrameCache::Frame mCurrentFrame;
     size_t mFrameSize;
 
     std::chrono::time_point<std::chrono::system_clock> mAnimationStartTime;
-    std::unique_ptr<rlottie::Animation> mAnimation;
-    std::unique_ptr<rlottie::Surface> mSurface;
-    std::future<rlottie::Surface> mFuture;
     std::string mPath;
     std::string mStartDirection;
     std::string mDirection;
@@ -79,7 +64,6 @@ private:
     float mSpeedModifier;
     int mTargetPacing;
     int mTimeAccumulator;
-    int mLastRenderedFrame;
     int mSkippedFrames;
 
     bool mHoldFrame;
@@ -237,6 +237,18 @@ void ScrollableContainer::update(int deltaTime)
     GuiComponent::update(deltaTime);
 }
 
+bool ScrollableContainer::isAnimating()
+{
+    // The adjusted height is set on the first update, and text that fits within the container
+    // is never scrolled.
+    if (isVisible() && mUpdatedSize && mAutoScrollSpeed != 0 && !mChildren.empty() &&
+        mWindow->getAllowTextScrolling() &&
+        glm::round(mChildren.front()->getSize().y) > mAdjustedHeight)
+        return true;
+
+    return GuiComponent::isAnimating();
+}
+
 void ScrollableContainer::render(const glm::mat4& parentTrans)
 {
     if (!isVisible() || mThemeOpacity == 0.0f || mChildren.front()->getValue() == "")
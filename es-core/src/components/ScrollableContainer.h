@@ -42,6 +42,7 @@ public:
                     unsigned int properties) override;
 
     void update(int deltaTime) override;
+    bool isAnimating() override;
     void render(const glm::mat4& parentTrans) override;
 
 private:
@@ -449,6 +449,16 @@ void TextComponent::update(int deltaTime)
     updateSelf(deltaTime);
 }
 
+bool TextComponent::isAnimating()
+{
+    if (mHorizontalScrolling && mTextCache != nullptr && isVisible() &&
+        mWindow->getAllowTextScrolling() &&
+        mTextCache->metrics.size.x > mSize.x * mRelativeScale)
+        return true;
+
+    return GuiComponent::isAnimating();
+}
+
 void TextComponent::onTextChanged()
 {
     mTextCache.reset();
@@ -109,6 +109,7 @@ public:
     }
 
     void update(int deltaTime) override;
+    bool isAnimating() override;
 
 protected:
     virtual void onTextChanged();
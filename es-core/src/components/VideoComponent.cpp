@@ -453,6 +453,17 @@ void VideoComponent::update(int deltaTime)
     GuiComponent::update(deltaTime);
 }
 
+bool VideoComponent::isAnimating()
+{
+    // Videos are started from update(), so any visible video that has not finished playing
+    // counts as animating. This includes the period when the static image is shown.
+    if (mHasVideo && mVideoPath != "" && isVisible() && mThemeOpacity != 0.0f && !mPaused &&
+        (mIterationCount == 0 || mPlayCount != mIterationCount))
+        return true;
+
+    return GuiComponent::isAnimating();
+}
+
 void VideoComponent::startVideoPlayer()
 {
     mPlayCount = 0;
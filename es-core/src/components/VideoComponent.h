@@ -58,6 +58,7 @@ public:
     bool hasStaticVideo() { return !mConfig.staticVideoPath.empty(); }
     bool hasStaticImage() { return mStaticImage.getTextureSize() != glm::ivec2 {0, 0}; }
     bool hasStartDelay() { return mConfig.startDelay > 0; }
+    bool isPlaying() const { return mIsPlaying; }
 
     // These functions update the embedded static image.
     void onOriginChanged() override { mStaticImage.setOrigin(mOrigin); }
@@ -72,6 +73,7 @@ public:
     std::vector<HelpPrompt> getHelpPrompts() override;
 
     void update(int deltaTime) override;
+    bool isAnimating() override;
 
     // Resize the video to be as large as possible but fit within a box of this size.
     // This can be set before or after a video is loaded.
@@ -11,7 +11,9 @@
 #include "AudioManager.h"
 #include "Settings.h"
 #include "Window.h"
+#include "resources/FrameBufferPool.h"
 #include "resources/TextureResource.h"
+#include "utils/FileSystemUtil.h"
 #include "utils/StringUtil.h"
 
 #include <SDL2/SDL.h>
@@ -31,6 +33,9 @@
 
 VideoFFmpegComponent::VideoFFmpegComponent()
     : mBlackFrameOffset {0.0f, 0.0f}
+    , mPlaneTextures {0, 0, 0}
+    , mPlaneTextureWidth {0}
+    , mPlaneTextureHeight {0}
     , mFrameProcessingThread {nullptr}
     , mFormatContext {nullptr}
     , mVideoStream {nullptr}
@@ -59,6 +64,8 @@ VideoFFmpegComponent::VideoFFmpegComponent()
     , mDecodedFrame {false}
     , mReadAllFrames {false}
     , mEndOfVideo {false}
+    , mSWDecoder {true}
+    , mYUVPlanes {false}
 {
 }
 
@@ -270,12 +277,7 @@ void VideoFFmpegComponent::render(const glm::mat4& parentTrans)
             int pictureHeight {0};
 
             if (pictureSize > 0) {
-                tempPictureRGBA.insert(tempPictureRGBA.begin(),
-                                       std::make_move_iterator(mOutputPicture.pictureRGBA.begin()),
-                                       std::make_move_iterator(mOutputPicture.pictureRGBA.end()));
-
-                mOutputPicture.pictureRGBA.erase(mOutputPicture.pictureRGBA.begin(),
-                                                 mOutputPicture.pictureRGBA.end());
+                tempPictureRGBA.swap(mOutputPicture.pictureRGBA);
 
                 pictureWidth = mOutputPicture.width;
                 pictureHeight = mOutputPicture.height;
@@ -287,15 +289,25 @@ void VideoFFmpegComponent::render(const glm::mat4& parentTrans)
 
             if (pictureSize > 0) {
                 // Build a texture for the video frame.
-                mTexture->initFromPixels(&tempPictureRGBA.at(0), pictureWidth, pictureHeight);
+                if (mYUVPlanes)
+                    uploadPlanes(&tempPictureRGBA.at(0), pictureWidth, pictureHeight);
+                else
+                    mTexture->initFromPixels(&tempPictureRGBA.at(0), pictureWidth, pictureHeight);
+                FrameBufferPool::getInstance().release(tempPictureRGBA);
             }
         }
         else {
             pictureLock.unlock();
         }
 
-        if (mTexture != nullptr)
+        if (mYUVPlanes && mPlaneTextures[0] != 0) {
+            for (unsigned int i {0}; i < 3; ++i)
+                mRenderer->bindTexture(mPlaneTextures[i], i);
+            vertices->shaderFlags = vertices->shaderFlags | Renderer::ShaderFlags::YUV_PLANES;
+        }
+        else if (mTexture != nullptr) {
             mTexture->bind(0);
+        }
 
         // Render scanlines if this option is enabled. However, if this is the media viewer
         // or the video screensaver, then skip this as the scanline rendering is then handled
@@ -340,6 +352,7 @@ void VideoFFmpegComponent::updatePlayer()
         mTimeReference = std::chrono::high_resolution_clock::now();
         while (mAudioFrameQueue.size() > 1 && mVideoFrameQueue.size() > 1 &&
                mAudioFrameQueue.front().pts > mVideoFrameQueue.front().pts) {
+            FrameBufferPool::getInstance().release(mVideoFrameQueue.front().frameRGBA);
             mVideoFrameQueue.pop();
         }
         return;
@@ -536,8 +549,14 @@ bool VideoFFmpegComponent::setupVideoFilters()
         // }
     }
 
+    // If uploading the Y, U and V planes as separate textures, the color conversion is
+    // performed by the shader and the filter graph only needs to convert any other pixel
+    // formats (such as NV12 from hardware decoders) to planar YUV 4:2:0.
+    mYUVPlanes = Settings::getInstance()->getBool("VideoYUVPlanes");
+
     filterDescription.append("format=pix_fmts=")
-        .append(std::string(av_get_pix_fmt_name(AV_PIX_FMT_BGRA)));
+        .append(std::string(
+            av_get_pix_fmt_name(mYUVPlanes ? AV_PIX_FMT_YUV420P : AV_PIX_FMT_BGRA)));
 
     returnValue = avfilter_graph_parse_ptr(mVFilterGraph, filterDescription.c_str(),
                                            &mVFilterInputs, &mVFilterOutputs, nullptr);
@@ -835,6 +854,8 @@ void VideoFFmpegComponent::readFrames()
 
 void VideoFFmpegComponent::getProcessedFrames()
 {
+    FrameBufferPool& framePool {FrameBufferPool::getInstance()};
+
     // Video frames.
     while (av_buffersink_get_frame(mVBufferSinkContext, mVideoFrameResampled) >= 0) {
 
@@ -844,7 +865,7 @@ void VideoFFmpegComponent::getProcessedFrames()
         // This is likely unnecessary as AV_PIX_FMT_RGBA always uses 4 bytes per pixel.
         // const int bytesPerPixel {
         //    av_get_padded_bits_per_pixel(av_pix_fmt_desc_get(AV_PIX_FMT_RGBA)) / 8};
-        const int bytesPerPixel {4};
+        const int bytesPerPixel {mYUVPlanes ? 1 : 4};
         const int width {mVideoFrameResampled->linesize[0] / bytesPerPixel};
 
         currFrame.width = width;
@@ -871,11 +892,36 @@ void VideoFFmpegComponent::getProcessedFrames()
         currFrame.pts = pts;
         currFrame.frameDuration = frameDuration;
 
-        const int bufferSize {width * mVideoFrameResampled->height * 4};
-
-        currFrame.frameRGBA.insert(
-            currFrame.frameRGBA.begin(), std::make_move_iterator(&mVideoFrameResampled->data[0][0]),
-            std::make_move_iterator(&mVideoFrameResampled->data[0][bufferSize]));
+        if (mYUVPlanes) {
+            // The chroma planes are copied row by row as their line sizes may include padding
+            // which is not necessarily half of the luma line size.
+            const int lumaSize {width * mVideoFrameResampled->height};
+            const int chromaWidth {width / 2};
+            const int chromaHeight {(mVideoFrameResampled->height + 1) / 2};
+            currFrame.frameRGBA = framePool.acquire(lumaSize + chromaWidth * chromaHeight * 2);
+            currFrame.frameRGBA.assign(&mVideoFrameResampled->data[0][0],
+                                       &mVideoFrameResampled->data[0][lumaSize]);
+            for (int plane {1}; plane < 3; ++plane) {
+                const int rowSize {std::min(chromaWidth, mVideoFrameResampled->linesize[plane])};
+                for (int row {0}; row < chromaHeight; ++row) {
+                    const uint8_t* rowData {mVideoFrameResampled->data[plane] +
+                                            row * mVideoFrameResampled->linesize[plane]};
+                    currFrame.frameRGBA.insert(currFrame.frameRGBA.end(), rowData,
+                                               rowData + rowSize);
+                    if (rowSize < chromaWidth)
+                        currFrame.frameRGBA.insert(currFrame.frameRGBA.end(),
+                                                   chromaWidth - rowSize, 0);
+                }
+            }
+        }
+        else {
+            // The buffers are recycled via the frame pool, so steady state playback does not
+            // need to allocate any memory for the video frames.
+            const int bufferSize {width * mVideoFrameResampled->height * 4};
+            currFrame.frameRGBA = framePool.acquire(bufferSize);
+            currFrame.frameRGBA.assign(&mVideoFrameResampled->data[0][0],
+                                       &mVideoFrameResampled->data[0][bufferSize]);
+        }
 
         mVideoFrameQueue.emplace(std::move(currFrame));
         av_frame_unref(mVideoFrameResampled);
@@ -1022,11 +1068,10 @@ void VideoFFmpegComponent::outputFrames()
                 }
             }
 
-            mOutputPicture.pictureRGBA.clear();
-            mOutputPicture.pictureRGBA.insert(
-                mOutputPicture.pictureRGBA.begin(),
-                std::make_move_iterator(mVideoFrameQueue.front().frameRGBA.begin()),
-                std::make_move_iterator(mVideoFrameQueue.front().frameRGBA.end()));
+            // Swap the buffers and return the previous picture (if it was never rendered)
+            // to the frame pool.
+            mOutputPicture.pictureRGBA.swap(mVideoFrameQueue.front().frameRGBA);
+            FrameBufferPool::getInstance().release(mVideoFrameQueue.front().frameRGBA);
 
             mOutputPicture.width = mVideoFrameQueue.front().width;
             mOutputPicture.height = mVideoFrameQueue.front().height;
@@ -1048,6 +1093,50 @@ void VideoFFmpegComponent::outputFrames()
         mEndOfVideo = true;
 }
 
+void VideoFFmpegComponent::uploadPlanes(const uint8_t* planeData,
+                                        const int width,
+                                        const int height)
+{
+    const int chromaWidth {width / 2};
+    const int chromaHeight {(height + 1) / 2};
+    const std::array<int, 3> planeWidths {width, chromaWidth, chromaWidth};
+    const std::array<int, 3> planeHeights {height, chromaHeight, chromaHeight};
+
+    if (width != mPlaneTextureWidth || height != mPlaneTextureHeight)
+        destroyPlaneTextures();
+
+    for (size_t i {0}; i < 3; ++i) {
+        void* data {const_cast<uint8_t*>(planeData)};
+        const unsigned int planeWidth {static_cast<unsigned int>(planeWidths[i])};
+        const unsigned int planeHeight {static_cast<unsigned int>(planeHeights[i])};
+        if (mPlaneTextures[i] == 0) {
+            mPlaneTextures[i] =
+                mRenderer->createTexture(0, Renderer::TextureType::RED, true, mLinearInterpolation,
+                                         false, false, planeWidth, planeHeight, data);
+        }
+        else {
+            mRenderer->updateTexture(mPlaneTextures[i], 0, Renderer::TextureType::RED, 0, 0,
+                                     planeWidth, planeHeight, data);
+        }
+        planeData += planeWidths[i] * planeHeights[i];
+    }
+
+    mPlaneTextureWidth = width;
+    mPlaneTextureHeight = height;
+}
+
+void VideoFFmpegComponent::destroyPlaneTextures()
+{
+    for (auto& texture : mPlaneTextures) {
+        if (texture != 0)
+            mRenderer->destroyTexture(texture);
+        texture = 0;
+    }
+
+    mPlaneTextureWidth = 0;
+    mPlaneTextureHeight = 0;
+}
+
 void VideoFFmpegComponent::calculateBlackFrame()
 {
     // Calculate the position and size for the black frame image that will be rendered behind
@@ -1438,18 +1527,22 @@ void VideoFFmpegComponent::startVideoStream()
 
         // File operations and basic setup.
 
-        if (avformat_open_input(&mFormatContext, filePath.c_str(), nullptr, nullptr)) {
-            LOG(LogError) << "VideoFFmpegComponent::startVideoStream(): "
-                             "Couldn't open video file \""
-                          << mVideoPath << "\"";
-            return;
-        }
+        mFormatContext = takePrefetchedVideo(mVideoPath);
 
-        if (avformat_find_stream_info(mFormatContext, nullptr)) {
-            LOG(LogError) << "VideoFFmpegComponent::startVideoStream(): "
-                             "Couldn't read stream information from video file \""
-                          << mVideoPath << "\"";
-            return;
+        if (mFormatContext == nullptr) {
+            if (avformat_open_input(&mFormatContext, filePath.c_str(), nullptr, nullptr)) {
+                LOG(LogError) << "VideoFFmpegComponent::startVideoStream(): "
+                                 "Couldn't open video file \""
+                              << mVideoPath << "\"";
+                return;
+            }
+
+            if (avformat_find_stream_info(mFormatContext, nullptr)) {
+                LOG(LogError) << "VideoFFmpegComponent::startVideoStream(): "
+                                 "Couldn't read stream information from video file \""
+                              << mVideoPath << "\"";
+                return;
+            }
         }
 
         mVideoStreamIndex = -1;
@@ -1622,6 +1715,68 @@ void VideoFFmpegComponent::startVideoStream()
     }
 }
 
+void VideoFFmpegComponent::prefetchVideo(const std::string& path)
+{
+    cancelPrefetch();
+
+    if (path.empty())
+        return;
+
+    // Same conversion as done by VideoComponent::setVideo().
+    sPrefetchPath = Utils::FileSystem::getCanonicalPath(path);
+    sPrefetchState = std::make_shared<PrefetchState>();
+
+    std::thread prefetchThread {[state = sPrefetchState, filePath = "file:" + sPrefetchPath] {
+        AVFormatContext* formatContext {nullptr};
+
+        if (!avformat_open_input(&formatContext, filePath.c_str(), nullptr, nullptr) &&
+            avformat_find_stream_info(formatContext, nullptr))
+            avformat_close_input(&formatContext);
+
+        std::unique_lock<std::mutex> lock {state->mutex};
+        if (state->cancelled && formatContext != nullptr)
+            avformat_close_input(&formatContext);
+        state->formatContext = formatContext;
+        state->finished = true;
+        state->finishedCondition.notify_one();
+    }};
+    prefetchThread.detach();
+}
+
+void VideoFFmpegComponent::cancelPrefetch()
+{
+    if (sPrefetchState) {
+        std::unique_lock<std::mutex> lock {sPrefetchState->mutex};
+        sPrefetchState->cancelled = true;
+        if (sPrefetchState->formatContext != nullptr)
+            avformat_close_input(&sPrefetchState->formatContext);
+    }
+
+    sPrefetchState.reset();
+    sPrefetchPath = "";
+}
+
+AVFormatContext* VideoFFmpegComponent::takePrefetchedVideo(const std::string& path)
+{
+    if (!sPrefetchState || sPrefetchPath != path)
+        return nullptr;
+
+    AVFormatContext* formatContext {nullptr};
+    {
+        // If the prefetch has not completed yet then we wait for it, as this would otherwise
+        // have to be done in this thread anyway.
+        std::unique_lock<std::mutex> lock {sPrefetchState->mutex};
+        sPrefetchState->finishedCondition.wait(lock, [] { return sPrefetchState->finished; });
+        formatContext = sPrefetchState->formatContext;
+        sPrefetchState->formatContext = nullptr;
+    }
+
+    sPrefetchState.reset();
+    sPrefetchPath = "";
+
+    return formatContext;
+}
+
 void VideoFFmpegComponent::stopVideoPlayer(bool muteAudio)
 {
     if (muteAudio)
@@ -1633,6 +1788,7 @@ void VideoFFmpegComponent::stopVideoPlayer(bool muteAudio)
     mReadAllFrames = false;
     mEndOfVideo = false;
     mTexture.reset();
+    destroyPlaneTextures();
 
     if (mFrameProcessingThread) {
         if (mWindow->getVideoPlayerCount() == 0)
@@ -1644,7 +1800,11 @@ void VideoFFmpegComponent::stopVideoPlayer(bool muteAudio)
     }
 
     // Clear the video and audio frame queues.
-    std::queue<VideoFrame>().swap(mVideoFrameQueue);
+    FrameBufferPool::getInstance().release(mOutputPicture.pictureRGBA);
+    while (!mVideoFrameQueue.empty()) {
+        FrameBufferPool::getInstance().release(mVideoFrameQueue.front().frameRGBA);
+        mVideoFrameQueue.pop();
+    }
     std::queue<AudioFrame>().swap(mAudioFrameQueue);
 
     // Clear the audio buffer.
@@ -24,8 +24,10 @@ extern "C" {
 #include <libavutil/imgutils.h>
 }
 
+#include <array>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <mutex>
 #include <queue>
 #include <thread>
@@ -59,9 +61,30 @@ public:
     // Needed to be able to display the default image even if no image types have been defined.
     const std::string getDefaultImage() const override { return mDefaultImagePath; }
 
+    // Opens the video file and reads the stream information in a separate thread, so that a
+    // following startVideoPlayer() call for the same file can skip these steps. Only a single
+    // video can be prefetched at a time. Used by the video screensaver.
+    static void prefetchVideo(const std::string& path);
+    // The prefetch thread is detached rather than joined, so this never blocks.
+    static void cancelPrefetch();
+
 private:
+    // State shared with the prefetch thread. If the prefetch is cancelled then the thread
+    // closes the video file itself once it has finished reading the stream information.
+    struct PrefetchState {
+        std::mutex mutex;
+        std::condition_variable finishedCondition;
+        AVFormatContext* formatContext {nullptr};
+        bool finished {false};
+        bool cancelled {false};
+    };
+
     void startVideoStream() override;
 
+    // Returns the format context opened by prefetchVideo(), or nullptr if the prefetched
+    // video is not for this file.
+    static AVFormatContext* takePrefetchedVideo(const std::string& path);
+
     // Calculates the correct mSize from our resizing information (set by setResize/setMaxSize).
     // Used internally whenever the resizing parameters or texture change.
     void resize();
@@ -82,6 +105,11 @@ private:
     // Output frames to AudioManager and to the video surface (via the main thread).
     void outputFrames();
 
+    // Upload the Y, U and V planes of a frame to the plane textures, which are (re)created if
+    // the frame size has changed.
+    void uploadPlanes(const uint8_t* planeData, const int width, const int height);
+    void destroyPlaneTextures();
+
     // Calculate the black frame that is rendered behind all videos and which may also be
     // adding pillarboxes/letterboxes.
     void calculateBlackFrame();
@@ -97,8 +125,14 @@ private:
     static inline std::vector<std::string> sSWDecodedVideos;
     static inline std::vector<std::string> sHWDecodedVideos;
 
+    static inline std::shared_ptr<PrefetchState> sPrefetchState;
+    static inline std::string sPrefetchPath;
+
     std::shared_ptr<TextureResource> mTexture;
     glm::vec2 mBlackFrameOffset;
+    std::array<unsigned int, 3> mPlaneTextures;
+    int mPlaneTextureWidth;
+    int mPlaneTextureHeight;
 
     std::unique_ptr<std::thread> mFrameProcessingThread;
     std::mutex mPictureMutex;
@@ -122,6 +156,8 @@ private:
     AVFrame* mAudioFrame;
     AVFrame* mAudioFrameResampled;
 
+    // If mYUVPlanes is set then frameRGBA and pictureRGBA contain the Y plane followed by
+    // the U and V planes at half the width and height, otherwise they contain BGRA pixels.
     struct VideoFrame {
         std::vector<uint8_t> frameRGBA;
         int width;
@@ -177,6 +213,7 @@ private:
     std::atomic<bool> mReadAllFrames;
     std::atomic<bool> mEndOfVideo;
     bool mSWDecoder;
+    bool mYUVPlanes;
 };
 
 #endif // ES_CORE_COMPONENTS_VIDEO_FFMPEG_COMPONENT_H
@@ -19,6 +19,7 @@ struct CarouselEntry {
     std::shared_ptr<GuiComponent> item;
     std::string imagePath;
     std::string defaultImagePath;
+    std::string prefetchPath;
 };
 
 template <typename T>
@@ -26,6 +27,7 @@ class CarouselComponent : public PrimaryComponent<T>, protected IList<CarouselEn
 {
 protected:
     using List = IList<CarouselEntry, T>;
+    using List::getPrefetchSteps;
     using List::mCursor;
     using List::mEntries;
     using List::mLastCursor;
@@ -93,6 +95,7 @@ public:
 
     bool input(InputConfig* config, Input input) override;
     void update(int deltaTime) override;
+    bool isAnimating() override;
     void render(const glm::mat4& parentTrans) override;
     void applyTheme(const std::shared_ptr<ThemeData>& theme,
                     const std::string& view,
@@ -100,8 +103,18 @@ public:
                     unsigned int properties) override;
 
 private:
-    void onShowPrimary() override { mEntries.at(mCursor).data.item->resetComponent(); }
+    void onShowPrimary() override
+    {
+        if (mEntries.at(mCursor).data.item)
+            mEntries.at(mCursor).data.item->resetComponent();
+    }
     void onCursorChanged(const CursorState& state) override;
+    std::string getImagePath(const Entry& entry);
+    void prefetchTextures(int firstPos, int lastPos);
+    std::shared_ptr<TextComponent> createTextItem(const std::string& text);
+    void setItemOrigin(const std::shared_ptr<GuiComponent>& item);
+    void bindItem(int index);
+    void releaseItems(int firstPos, int lastPos);
     void onScroll() override
     {
         if (mGamelistView)
@@ -118,14 +131,29 @@ private:
             GuiComponent::finishAnimation(0);
     }
     const int getScrollingVelocity() override { return List::getScrollingVelocity(); }
-    void clear() override { List::clear(); }
+    void clear() override
+    {
+        List::clear();
+        mBoundEntries.clear();
+    }
     const T& getSelected() const override { return List::getSelected(); }
     const T& getNext() const override { return List::getNext(); }
     const T& getPrevious() const override { return List::getPrevious(); }
     const T& getFirst() const override { return List::getFirst(); }
     const T& getLast() const override { return List::getLast(); }
     bool setCursor(const T& obj) override { return List::setCursor(obj); }
-    bool remove(const T& obj) override { return List::remove(obj); }
+    bool remove(const T& obj) override
+    {
+        if (!List::remove(obj))
+            return false;
+        // The entry indices have changed so the bound entries need to be looked up again.
+        mBoundEntries.clear();
+        for (int i {0}; mGamelistView && i < size(); ++i) {
+            if (mEntries.at(i).data.item)
+                mBoundEntries.emplace_back(i);
+        }
+        return true;
+    }
     int size() const override { return List::size(); }
 
     int getCursor() override { return mCursor; }
@@ -138,6 +166,12 @@ private:
         COVER
     };
 
+    // Limits for how far ahead of the visible items that textures are prefetched while scrolling.
+    static inline const int maxPrefetchItems {12};
+    static inline const size_t maxPrefetchPaths {64};
+    // Maximum number of unused item components to keep around for reuse.
+    static inline const size_t maxPooledItems {128};
+
     Renderer* mRenderer;
     std::function<void(CursorState state)> mCursorChangedCallback;
     std::function<void()> mCancelTransitionsCallback;
@@ -145,6 +179,14 @@ private:
     float mEntryCamOffset;
     float mEntryCamTarget;
     int mPreviousScrollVelocity;
+    std::vector<std::string> mPrefetchPaths;
+    int mPrefetchDirection;
+
+    // In the gamelist view items are only created for the entries in and around the visible
+    // area. These are released when scrolled out of range and their components are reused.
+    std::vector<int> mBoundEntries;
+    std::vector<std::shared_ptr<ImageComponent>> mImagePool;
+    std::vector<std::shared_ptr<TextComponent>> mTextPool;
     bool mPositiveDirection;
     bool mTriggerJump;
     bool mGamelistView;
@@ -227,6 +269,7 @@ CarouselComponent<T>::CarouselComponent()
     , mEntryCamOffset {0.0f}
     , mEntryCamTarget {0.0f}
     , mPreviousScrollVelocity {0}
+    , mPrefetchDirection {0}
     , mPositiveDirection {false}
     , mTriggerJump {false}
     , mGamelistView {std::is_same_v<T, FileData*> ? true : false}
@@ -375,41 +418,16 @@ void CarouselComponent<T>::addEntry(Entry& entry, const std::shared_ptr<ThemeDat
         entry.data.imagePath = "";
     }
 
-    if (!entry.data.item) {
-        // Always add the item text as fallback in case there is no image. This is also displayed
-        // when quick-jumping as textures are not loaded in this case.
-        auto text = std::make_shared<TextComponent>(
-            entry.name, mFont, 0x000000FF, mItemHorizontalAlignment, mItemVerticalAlignment,
-            glm::vec3 {0.0f, 0.0f, 0.0f},
-            glm::round(mItemSize * (mItemScale >= 1.0f ? mItemScale : 1.0f)), 0x00000000,
-            mLineSpacing, mTextRelativeScale, mTextHorizontalScrolling, mTextHorizontalScrollSpeed,
-            mTextHorizontalScrollDelay, mTextHorizontalScrollGap);
-        if (!mGamelistView)
-            text->setValue(entry.name);
-        text->setColor(mTextColor);
-        text->setBackgroundColor(mTextBackgroundColor);
-        text->setRenderBackground(true);
-
+    // Always add the item text as fallback in case there is no image. For the gamelist view
+    // this is instead done in bindItem() when the entry is about to be displayed.
+    if (!entry.data.item && !mGamelistView) {
+        auto text = createTextItem(entry.name);
+        text->setValue(entry.name);
         entry.data.item = text;
     }
 
-    // Set origin for the items based on their alignment so they line up properly.
-    if (mItemHorizontalAlignment == ALIGN_LEFT)
-        entry.data.item->setOrigin(0.0f, 0.5f);
-    else if (mItemHorizontalAlignment == ALIGN_RIGHT)
-        entry.data.item->setOrigin(1.0f, 0.5f);
-    else
-        entry.data.item->setOrigin(0.5f, 0.5f);
-
-    if (mItemVerticalAlignment == ALIGN_TOP)
-        entry.data.item->setOrigin(entry.data.item->getOrigin().x, 0.0f);
-    else if (mItemVerticalAlignment == ALIGN_BOTTOM)
-        entry.data.item->setOrigin(entry.data.item->getOrigin().x, 1.0f);
-    else
-        entry.data.item->setOrigin(entry.data.item->getOrigin().x, 0.5f);
-
-    glm::vec2 denormalized {glm::round(mItemSize * entry.data.item->getOrigin())};
-    entry.data.item->setPosition(glm::vec3 {denormalized.x, denormalized.y, 0.0f});
+    if (entry.data.item)
+        setItemOrigin(entry.data.item);
 
     List::add(entry);
 }
@@ -418,55 +436,52 @@ template <typename T>
 void CarouselComponent<T>::updateEntry(Entry& entry, const std::shared_ptr<ThemeData>& theme)
 {
     if (entry.data.imagePath != "") {
-        auto item = std::make_shared<ImageComponent>(false, true);
-        item->setLinearInterpolation(mLinearInterpolation);
-        item->setMipmapping(true);
-        if (mImagefit == ImageFit::CONTAIN) {
-            item->setMaxSize(glm::round(mItemSize * (mItemScale >= 1.0f ? mItemScale : 1.0f)));
-        }
-        else if (mImagefit == ImageFit::FILL) {
-            item->setResize(glm::round(mItemSize * (mItemScale >= 1.0f ? mItemScale : 1.0f)));
+        std::shared_ptr<ImageComponent> item;
+        if (!mImagePool.empty()) {
+            // The pooled components have already been set up using the theme configuration.
+            item = mImagePool.back();
+            mImagePool.pop_back();
+            item->setImage(entry.data.imagePath);
         }
-        else if (mImagefit == ImageFit::COVER) {
-            item->setCropPos(mImageCropPos);
-            item->setCroppedSize(glm::round(mItemSize * (mItemScale >= 1.0f ? mItemScale : 1.0f)));
+        else {
+            item = std::make_shared<ImageComponent>(false, true);
+            item->setLinearInterpolation(mLinearInterpolation);
+            item->setMipmapping(true);
+            if (mImagefit == ImageFit::CONTAIN) {
+                item->setMaxSize(glm::round(mItemSize * (mItemScale >= 1.0f ? mItemScale : 1.0f)));
+            }
+            else if (mImagefit == ImageFit::FILL) {
+                item->setResize(glm::round(mItemSize * (mItemScale >= 1.0f ? mItemScale : 1.0f)));
+            }
+            else if (mImagefit == ImageFit::COVER) {
+                item->setCropPos(mImageCropPos);
+                item->setCroppedSize(
+                    glm::round(mItemSize * (mItemScale >= 1.0f ? mItemScale : 1.0f)));
+            }
+            item->setCornerRadius(mImageCornerRadius);
+            item->setImage(entry.data.imagePath);
+            if (mImageBrightness != 0.0)
+                item->setBrightness(mImageBrightness);
+            if (mImageSaturation != 1.0)
+                item->setSaturation(mImageSaturation);
+            if (mImageColorShift != 0xFFFFFFFF)
+                item->setColorShift(mImageColorShift);
+            if (mImageColorShiftEnd != mImageColorShift)
+                item->setColorShiftEnd(mImageColorShiftEnd);
+            if (!mImageColorGradientHorizontal)
+                item->setColorGradientHorizontal(false);
+            item->setRotateByTargetSize(true);
         }
-        item->setCornerRadius(mImageCornerRadius);
-        item->setImage(entry.data.imagePath);
-        if (mImageBrightness != 0.0)
-            item->setBrightness(mImageBrightness);
-        if (mImageSaturation != 1.0)
-            item->setSaturation(mImageSaturation);
-        if (mImageColorShift != 0xFFFFFFFF)
-            item->setColorShift(mImageColorShift);
-        if (mImageColorShiftEnd != mImageColorShift)
-            item->setColorShiftEnd(mImageColorShiftEnd);
-        if (!mImageColorGradientHorizontal)
-            item->setColorGradientHorizontal(false);
-        item->setRotateByTargetSize(true);
+        // The item being replaced is the text fallback that was added by bindItem().
+        if (mGamelistView && entry.data.item && mTextPool.size() < maxPooledItems)
+            mTextPool.emplace_back(std::static_pointer_cast<TextComponent>(entry.data.item));
         entry.data.item = item;
     }
     else {
         return;
     }
 
-    // Set origin for the items based on their alignment so they line up properly.
-    if (mItemHorizontalAlignment == ALIGN_LEFT)
-        entry.data.item->setOrigin(0.0f, 0.5f);
-    else if (mItemHorizontalAlignment == ALIGN_RIGHT)
-        entry.data.item->setOrigin(1.0f, 0.5f);
-    else
-        entry.data.item->setOrigin(0.5f, 0.5f);
-
-    if (mItemVerticalAlignment == ALIGN_TOP)
-        entry.data.item->setOrigin(entry.data.item->getOrigin().x, 0.0f);
-    else if (mItemVerticalAlignment == ALIGN_BOTTOM)
-        entry.data.item->setOrigin(entry.data.item->getOrigin().x, 1.0f);
-    else
-        entry.data.item->setOrigin(entry.data.item->getOrigin().x, 0.5f);
-
-    glm::vec2 denormalized {glm::round(mItemSize * entry.data.item->getOrigin())};
-    entry.data.item->setPosition(glm::vec3 {denormalized.x, denormalized.y, 0.0f});
+    setItemOrigin(entry.data.item);
 }
 
 template <typename T> void CarouselComponent<T>::onDemandTextureLoad()
@@ -538,43 +553,218 @@ template <typename T> void CarouselComponent<T>::onDemandTextureLoad()
                 cursor -= numEntries;
 
             auto& entry = mEntries.at(cursor);
+            bindItem(cursor);
 
             if (entry.data.imagePath == "") {
-                FileData* game {entry.object};
-
-                for (auto& imageType : mImageTypes) {
-                    if (imageType == "marquee")
-                        entry.data.imagePath = game->getMarqueePath();
-                    else if (imageType == "cover")
-                        entry.data.imagePath = game->getCoverPath();
-                    else if (imageType == "backcover")
-                        entry.data.imagePath = game->getBackCoverPath();
-                    else if (imageType == "3dbox")
-                        entry.data.imagePath = game->get3DBoxPath();
-                    else if (imageType == "physicalmedia")
-                        entry.data.imagePath = game->getPhysicalMediaPath();
-                    else if (imageType == "screenshot")
-                        entry.data.imagePath = game->getScreenshotPath();
-                    else if (imageType == "titlescreen")
-                        entry.data.imagePath = game->getTitleScreenPath();
-                    else if (imageType == "miximage")
-                        entry.data.imagePath = game->getMiximagePath();
-                    else if (imageType == "fanart")
-                        entry.data.imagePath = game->getFanArtPath();
-                    else if (imageType == "none") // Display the game name as text.
-                        break;
-
-                    if (entry.data.imagePath != "")
-                        break;
-                }
-
-                if (entry.data.imagePath == "")
-                    entry.data.imagePath = entry.data.defaultImagePath;
+                // The resolved path is retained as the item may be released and bound again.
+                if (entry.data.prefetchPath == "")
+                    entry.data.prefetchPath = getImagePath(entry);
+                entry.data.imagePath = entry.data.prefetchPath;
 
-                auto theme = game->getSystem()->getTheme();
+                auto theme = entry.object->getSystem()->getTheme();
                 updateEntry(entry, theme);
             }
         }
+
+        releaseItems(center - itemInclusion - itemInclusionBefore,
+                     center + itemInclusion + itemInclusionAfter);
+        prefetchTextures(center - itemInclusion - itemInclusionBefore,
+                         center + itemInclusion + itemInclusionAfter);
+    }
+}
+
+template <typename T> std::string CarouselComponent<T>::getImagePath(const Entry& entry)
+{
+    std::string imagePath;
+
+    if constexpr (std::is_same_v<T, FileData*>) {
+        FileData* game {entry.object};
+
+        for (auto& imageType : mImageTypes) {
+            if (imageType == "marquee")
+                imagePath = game->getMarqueePath();
+            else if (imageType == "cover")
+                imagePath = game->getCoverPath();
+            else if (imageType == "backcover")
+                imagePath = game->getBackCoverPath();
+            else if (imageType == "3dbox")
+                imagePath = game->get3DBoxPath();
+            else if (imageType == "physicalmedia")
+                imagePath = game->getPhysicalMediaPath();
+            else if (imageType == "screenshot")
+                imagePath = game->getScreenshotPath();
+            else if (imageType == "titlescreen")
+                imagePath = game->getTitleScreenPath();
+            else if (imageType == "miximage")
+                imagePath = game->getMiximagePath();
+            else if (imageType == "fanart")
+                imagePath = game->getFanArtPath();
+            else if (imageType == "none") // Display the game name as text.
+                break;
+
+            if (imagePath != "")
+                break;
+        }
+    }
+
+    if (imagePath == "")
+        imagePath = entry.data.defaultImagePath;
+
+    return imagePath;
+}
+
+template <typename T> void CarouselComponent<T>::prefetchTextures(int firstPos, int lastPos)
+{
+    if constexpr (std::is_same_v<T, FileData*>) {
+        const int direction {(mScrollVelocity > 0) - (mScrollVelocity < 0)};
+        if (direction == 0)
+            return;
+
+        // Anything prefetched in the other direction is stale when the scrolling reverses.
+        if (direction != mPrefetchDirection) {
+            for (auto& path : mPrefetchPaths)
+                TextureResource::cancelPrefetch(path);
+            mPrefetchPaths.clear();
+            mPrefetchDirection = direction;
+        }
+
+        const int numEntries {size()};
+        const int prefetchItems {
+            std::min(getPrefetchSteps(maxPrefetchItems), numEntries - (lastPos - firstPos))};
+        int pos {direction > 0 ? lastPos : firstPos - 1};
+
+        for (int i {0}; i < prefetchItems; ++i, pos += direction) {
+            int cursor {pos};
+
+            while (cursor < 0)
+                cursor += numEntries;
+            while (cursor >= numEntries)
+                cursor -= numEntries;
+
+            auto& entry = mEntries.at(cursor);
+            if (entry.data.imagePath != "")
+                continue;
+
+            // Resolving the media path requires file system lookups, so the result is kept
+            // for when the entry scrolls into view.
+            if (entry.data.prefetchPath == "")
+                entry.data.prefetchPath = getImagePath(entry);
+
+            const std::string& path {entry.data.prefetchPath};
+            if (path == entry.data.defaultImagePath ||
+                std::find(mPrefetchPaths.cbegin(), mPrefetchPaths.cend(), path) !=
+                    mPrefetchPaths.cend())
+                continue;
+
+            TextureResource::prefetch(path);
+            mPrefetchPaths.emplace_back(path);
+        }
+
+        if (mPrefetchPaths.size() > maxPrefetchPaths)
+            mPrefetchPaths.erase(mPrefetchPaths.begin(),
+                                 mPrefetchPaths.end() - maxPrefetchPaths);
+    }
+}
+
+template <typename T>
+std::shared_ptr<TextComponent> CarouselComponent<T>::createTextItem(const std::string& text)
+{
+    auto item = std::make_shared<TextComponent>(
+        text, mFont, 0x000000FF, mItemHorizontalAlignment, mItemVerticalAlignment,
+        glm::vec3 {0.0f, 0.0f, 0.0f},
+        glm::round(mItemSize * (mItemScale >= 1.0f ? mItemScale : 1.0f)), 0x00000000,
+        mLineSpacing, mTextRelativeScale, mTextHorizontalScrolling, mTextHorizontalScrollSpeed,
+        mTextHorizontalScrollDelay, mTextHorizontalScrollGap);
+    item->setColor(mTextColor);
+    item->setBackgroundColor(mTextBackgroundColor);
+    item->setRenderBackground(true);
+
+    return item;
+}
+
+template <typename T>
+void CarouselComponent<T>::setItemOrigin(const std::shared_ptr<GuiComponent>& item)
+{
+    // Set origin for the items based on their alignment so they line up properly.
+    if (mItemHorizontalAlignment == ALIGN_LEFT)
+        item->setOrigin(0.0f, 0.5f);
+    else if (mItemHorizontalAlignment == ALIGN_RIGHT)
+        item->setOrigin(1.0f, 0.5f);
+    else
+        item->setOrigin(0.5f, 0.5f);
+
+    if (mItemVerticalAlignment == ALIGN_TOP)
+        item->setOrigin(item->getOrigin().x, 0.0f);
+    else if (mItemVerticalAlignment == ALIGN_BOTTOM)
+        item->setOrigin(item->getOrigin().x, 1.0f);
+    else
+        item->setOrigin(item->getOrigin().x, 0.5f);
+
+    glm::vec2 denormalized {glm::round(mItemSize * item->getOrigin())};
+    item->setPosition(glm::vec3 {denormalized.x, denormalized.y, 0.0f});
+}
+
+template <typename T> void CarouselComponent<T>::bindItem(int index)
+{
+    auto& entry = mEntries.at(index);
+
+    if (entry.data.item)
+        return;
+
+    std::shared_ptr<TextComponent> text;
+    if (!mTextPool.empty()) {
+        text = mTextPool.back();
+        mTextPool.pop_back();
+        text->setText(entry.name);
+        text->resetComponent();
+    }
+    else {
+        text = createTextItem(entry.name);
+        setItemOrigin(text);
+    }
+
+    entry.data.item = text;
+    mBoundEntries.emplace_back(index);
+}
+
+template <typename T> void CarouselComponent<T>::releaseItems(int firstPos, int lastPos)
+{
+    // Items within one screen of the loaded entries are retained so that scrolling back and
+    // forth does not constantly recreate them. As the carousel wraps around, the range does
+    // as well.
+    const int numEntries {size()};
+    const int margin {lastPos - firstPos};
+    const int keepItems {(lastPos - firstPos) + margin * 2};
+
+    if (keepItems >= numEntries)
+        return;
+
+    for (auto it = mBoundEntries.begin(); it != mBoundEntries.end();) {
+        int offset {(*it - (firstPos - margin)) % numEntries};
+        if (offset < 0)
+            offset += numEntries;
+
+        if (offset < keepItems) {
+            ++it;
+            continue;
+        }
+
+        auto& entry = mEntries.at(*it);
+        if (entry.data.imagePath == "") {
+            if (mTextPool.size() < maxPooledItems)
+                mTextPool.emplace_back(std::static_pointer_cast<TextComponent>(entry.data.item));
+        }
+        else if (entry.data.imagePath.front() != ':' && mImagePool.size() < maxPooledItems) {
+            // Bundled images are always loaded statically by ImageComponent so such components
+            // can't be reused for other images.
+            auto image = std::static_pointer_cast<ImageComponent>(entry.data.item);
+            image->setImage("");
+            mImagePool.emplace_back(image);
+        }
+
+        entry.data.item.reset();
+        entry.data.imagePath = "";
+        it = mBoundEntries.erase(it);
     }
 }
 
@@ -686,11 +876,26 @@ template <typename T> bool CarouselComponent<T>::input(InputConfig* config, Inpu
 
 template <typename T> void CarouselComponent<T>::update(int deltaTime)
 {
+    if (mGamelistView)
+        bindItem(mCursor);
     mEntries.at(mCursor).data.item->update(deltaTime);
     List::listUpdate(deltaTime);
     GuiComponent::update(deltaTime);
 }
 
+template <typename T> bool CarouselComponent<T>::isAnimating()
+{
+    if (mScrollVelocity != 0)
+        return true;
+    // Only the selected entry is updated, so that's the only one that can animate. Its item
+    // may have been released, in which case it's not animating until it's bound again.
+    if (!mEntries.empty() && mEntries.at(mCursor).data.item &&
+        mEntries.at(mCursor).data.item->isAnimating())
+        return true;
+
+    return GuiComponent::isAnimating();
+}
+
 template <typename T> void CarouselComponent<T>::render(const glm::mat4& parentTrans)
 {
     const float camOffset {mInstantItemTransitions ? mEntryCamTarget : mEntryCamOffset};
@@ -1005,6 +1210,11 @@ template <typename T> void CarouselComponent<T>::render(const glm::mat4& parentT
         renderItem.dimming = dimming;
         renderItem.trans = itemTrans;
 
+        // Entries can be rendered before onDemandTextureLoad() has been called for them, for
+        // example while quick-jumping, in which case the text fallback is displayed.
+        if (mGamelistView)
+            bindItem(index);
+
         renderItems.emplace_back(renderItem);
 
         if (singleEntry)
@@ -1843,7 +2053,7 @@ void CarouselComponent<T>::applyTheme(const std::shared_ptr<ThemeData>& theme,
 
 template <typename T> void CarouselComponent<T>::onCursorChanged(const CursorState& state)
 {
-    if (mEntries.size() > static_cast<size_t>(mLastCursor))
+    if (mEntries.size() > static_cast<size_t>(mLastCursor) && mEntries.at(mLastCursor).data.item)
         mEntries.at(mLastCursor).data.item->resetComponent();
 
     float startPos {mEntryCamOffset};
@@ -16,6 +16,7 @@ struct GridEntry {
     std::shared_ptr<GuiComponent> item;
     std::string imagePath;
     std::string defaultImagePath;
+    std::string prefetchPath;
 };
 
 template <typename T>
@@ -23,6 +24,7 @@ class GridComponent : public PrimaryComponent<T>, protected IList<GridEntry, T>
 {
 protected:
     using List = IList<GridEntry, T>;
+    using List::getPrefetchSteps;
     using List::mColumns;
     using List::mCursor;
     using List::mEntries;
@@ -77,6 +79,7 @@ public:
     void setDefaultFolderImage(std::string defaultImage) { mDefaultFolderImagePath = defaultImage; }
     bool input(InputConfig* config, Input input) override;
     void update(int deltaTime) override;
+    bool isAnimating() override;
     void render(const glm::mat4& parentTrans) override;
     void applyTheme(const std::shared_ptr<ThemeData>& theme,
                     const std::string& view,
@@ -84,7 +87,11 @@ public:
                     unsigned int properties) override;
 
 private:
-    void onShowPrimary() override { mEntries.at(mCursor).data.item->resetComponent(); }
+    void onShowPrimary() override
+    {
+        if (mEntries.at(mCursor).data.item)
+            mEntries.at(mCursor).data.item->resetComponent();
+    }
     void onScroll() override
     {
         if (mGamelistView)
@@ -93,6 +100,12 @@ private:
             NavigationSounds::getInstance().playThemeNavigationSound(SYSTEMBROWSESOUND);
     }
     void onCursorChanged(const CursorState& state) override;
+    std::string getImagePath(const Entry& entry);
+    void prefetchTextures(int firstPos, int lastPos);
+    std::shared_ptr<TextComponent> createTextItem(const std::string& text);
+    glm::vec3 getItemPosition(int index) const;
+    void bindItem(int index);
+    void releaseItems(int firstPos, int lastPos);
     bool isScrolling() const override { return List::isScrolling(); }
     void stopScrolling() override
     {
@@ -102,7 +115,11 @@ private:
             GuiComponent::finishAnimation(0);
     }
     const int getScrollingVelocity() override { return List::getScrollingVelocity(); }
-    void clear() override { List::clear(); }
+    void clear() override
+    {
+        List::clear();
+        mBoundEntries.clear();
+    }
     const T& getSelected() const override { return List::getSelected(); }
     const T& getNext() const override { return List::getNext(); }
     const T& getPrevious() const override { return List::getPrevious(); }
@@ -113,7 +130,18 @@ private:
         mLastCursor = mCursor;
         return List::setCursor(obj);
     }
-    bool remove(const T& obj) override { return List::remove(obj); }
+    bool remove(const T& obj) override
+    {
+        if (!List::remove(obj))
+            return false;
+        // The entry indices have changed so the bound entries need to be looked up again.
+        mBoundEntries.clear();
+        for (int i {0}; mGamelistView && i < size(); ++i) {
+            if (mEntries.at(i).data.item)
+                mBoundEntries.emplace_back(i);
+        }
+        return true;
+    }
     int size() const override { return List::size(); }
 
     enum class ImageFit {
@@ -128,6 +156,12 @@ private:
         BOTTOM
     };
 
+    // Limits for how far ahead of the visible rows that textures are prefetched while scrolling.
+    static inline const int maxPrefetchRows {4};
+    static inline const size_t maxPrefetchPaths {64};
+    // Maximum number of unused item components to keep around for reuse.
+    static inline const size_t maxPooledItems {128};
+
     Renderer* mRenderer;
     std::function<void()> mCancelTransitionsCallback;
     std::function<void(CursorState state)> mCursorChangedCallback;
@@ -136,6 +170,14 @@ private:
     float mTransitionFactor;
     float mVisibleRows;
     int mPreviousScrollVelocity;
+    std::vector<std::string> mPrefetchPaths;
+    int mPrefetchDirection;
+
+    // In the gamelist view items are only created for the entries in and around the visible
+    // area. These are released when scrolled out of range and their components are reused.
+    std::vector<int> mBoundEntries;
+    std::vector<std::shared_ptr<ImageComponent>> mImagePool;
+    std::vector<std::shared_ptr<TextComponent>> mTextPool;
     bool mPositiveDirection;
     bool mGamelistView;
     bool mLayoutValid;
@@ -219,6 +261,7 @@ GridComponent<T>::GridComponent()
     , mTransitionFactor {1.0f}
     , mVisibleRows {1.0f}
     , mPreviousScrollVelocity {0}
+    , mPrefetchDirection {0}
     , mPositiveDirection {false}
     , mGamelistView {std::is_same_v<T, FileData*> ? true : false}
     , mLayoutValid {false}
@@ -376,21 +419,10 @@ void GridComponent<T>::addEntry(Entry& entry, const std::shared_ptr<ThemeData>&
         entry.data.imagePath = "";
     }
 
-    if (!entry.data.item) {
-        // Always add the item text as fallback in case there is no image. This is also displayed
-        // when quick-jumping as textures are not loaded in this case.
-        auto text = std::make_shared<TextComponent>(
-            entry.name, mFont, 0x000000FF, Alignment::ALIGN_CENTER, Alignment::ALIGN_CENTER,
-            glm::vec3 {0.0f, 0.0f, 0.0f}, mItemSize * mTextRelativeScale, 0x00000000, mLineSpacing,
-            1.0f, mTextHorizontalScrolling, mTextHorizontalScrollSpeed, mTextHorizontalScrollDelay,
-            mTextHorizontalScrollGap);
-        text->setOrigin(0.5f, 0.5f);
-        text->setColor(mTextColor);
-        text->setBackgroundColor(mTextBackgroundColor);
-        text->setRenderBackground(true);
-
-        entry.data.item = text;
-    }
+    // Always add the item text as fallback in case there is no image. For the gamelist view
+    // this is instead done in bindItem() when the entry is about to be displayed.
+    if (!entry.data.item && !mGamelistView)
+        entry.data.item = createTextItem(entry.name);
 
     List::add(entry);
 }
@@ -399,35 +431,47 @@ template <typename T>
 void GridComponent<T>::updateEntry(Entry& entry, const std::shared_ptr<ThemeData>& theme)
 {
     if (entry.data.imagePath != "") {
-        const glm::vec3& calculatedItemPos {entry.data.item->getPosition()};
-        auto item = std::make_shared<ImageComponent>(false, true);
-        item->setLinearInterpolation(mImageLinearInterpolation);
-        item->setMipmapping(true);
-        if (mImagefit == ImageFit::CONTAIN) {
-            item->setMaxSize(glm::round(mItemSize * mImageRelativeScale));
-        }
-        else if (mImagefit == ImageFit::FILL) {
-            item->setResize(glm::round(mItemSize * mImageRelativeScale));
-        }
-        else if (mImagefit == ImageFit::COVER) {
-            item->setCropPos(mImageCropPos);
-            item->setCroppedSize(glm::round(mItemSize * mImageRelativeScale));
+        const glm::vec3 calculatedItemPos {entry.data.item->getPosition()};
+        std::shared_ptr<ImageComponent> item;
+        if (!mImagePool.empty()) {
+            // The pooled components have already been set up using the theme configuration.
+            item = mImagePool.back();
+            mImagePool.pop_back();
+            item->setImage(entry.data.imagePath);
         }
-        item->setCornerRadius(mImageCornerRadius);
-        item->setImage(entry.data.imagePath);
-        if (mImageBrightness != 0.0)
-            item->setBrightness(mImageBrightness);
-        if (mImageSaturation != 1.0)
-            item->setSaturation(mImageSaturation);
-        if (mImageColor != 0xFFFFFFFF)
-            item->setColorShift(mImageColor);
-        if (mImageColorEnd != mImageColor) {
-            item->setColorShiftEnd(mImageColorEnd);
-            if (!mImageColorGradientHorizontal)
-                item->setColorGradientHorizontal(false);
+        else {
+            item = std::make_shared<ImageComponent>(false, true);
+            item->setLinearInterpolation(mImageLinearInterpolation);
+            item->setMipmapping(true);
+            if (mImagefit == ImageFit::CONTAIN) {
+                item->setMaxSize(glm::round(mItemSize * mImageRelativeScale));
+            }
+            else if (mImagefit == ImageFit::FILL) {
+                item->setResize(glm::round(mItemSize * mImageRelativeScale));
+            }
+            else if (mImagefit == ImageFit::COVER) {
+                item->setCropPos(mImageCropPos);
+                item->setCroppedSize(glm::round(mItemSize * mImageRelativeScale));
+            }
+            item->setCornerRadius(mImageCornerRadius);
+            item->setImage(entry.data.imagePath);
+            if (mImageBrightness != 0.0)
+                item->setBrightness(mImageBrightness);
+            if (mImageSaturation != 1.0)
+                item->setSaturation(mImageSaturation);
+            if (mImageColor != 0xFFFFFFFF)
+                item->setColorShift(mImageColor);
+            if (mImageColorEnd != mImageColor) {
+                item->setColorShiftEnd(mImageColorEnd);
+                if (!mImageColorGradientHorizontal)
+                    item->setColorGradientHorizontal(false);
+            }
+            item->setOrigin(0.5f, 0.5f);
+            item->setRotateByTargetSize(true);
         }
-        item->setOrigin(0.5f, 0.5f);
-        item->setRotateByTargetSize(true);
+        // The item being replaced is the text fallback that was added by bindItem().
+        if (mGamelistView && mTextPool.size() < maxPooledItems)
+            mTextPool.emplace_back(std::static_pointer_cast<TextComponent>(entry.data.item));
         entry.data.item = item;
         entry.data.item->setPosition(calculatedItemPos);
     }
@@ -480,43 +524,191 @@ template <typename T> void GridComponent<T>::onDemandTextureLoad()
                 cursor -= numEntries;
 
             auto& entry = mEntries.at(cursor);
+            bindItem(cursor);
 
             if (entry.data.imagePath == "") {
-                FileData* game {entry.object};
-
-                for (auto& imageType : mImageTypes) {
-                    if (imageType == "marquee")
-                        entry.data.imagePath = game->getMarqueePath();
-                    else if (imageType == "cover")
-                        entry.data.imagePath = game->getCoverPath();
-                    else if (imageType == "backcover")
-                        entry.data.imagePath = game->getBackCoverPath();
-                    else if (imageType == "3dbox")
-                        entry.data.imagePath = game->get3DBoxPath();
-                    else if (imageType == "physicalmedia")
-                        entry.data.imagePath = game->getPhysicalMediaPath();
-                    else if (imageType == "screenshot")
-                        entry.data.imagePath = game->getScreenshotPath();
-                    else if (imageType == "titlescreen")
-                        entry.data.imagePath = game->getTitleScreenPath();
-                    else if (imageType == "miximage")
-                        entry.data.imagePath = game->getMiximagePath();
-                    else if (imageType == "fanart")
-                        entry.data.imagePath = game->getFanArtPath();
-                    else if (imageType == "none") // Display the game name as text.
-                        break;
-
-                    if (entry.data.imagePath != "")
-                        break;
-                }
-
-                if (entry.data.imagePath == "")
-                    entry.data.imagePath = entry.data.defaultImagePath;
+                // The resolved path is retained as the item may be released and bound again.
+                if (entry.data.prefetchPath == "")
+                    entry.data.prefetchPath = getImagePath(entry);
+                entry.data.imagePath = entry.data.prefetchPath;
 
-                auto theme = game->getSystem()->getTheme();
+                auto theme = entry.object->getSystem()->getTheme();
                 updateEntry(entry, theme);
             }
         }
+
+        releaseItems(startPos, startPos + loadedItems);
+        prefetchTextures(startPos, startPos + loadedItems);
+    }
+}
+
+template <typename T> std::string GridComponent<T>::getImagePath(const Entry& entry)
+{
+    std::string imagePath;
+
+    if constexpr (std::is_same_v<T, FileData*>) {
+        FileData* game {entry.object};
+
+        for (auto& imageType : mImageTypes) {
+            if (imageType == "marquee")
+                imagePath = game->getMarqueePath();
+            else if (imageType == "cover")
+                imagePath = game->getCoverPath();
+            else if (imageType == "backcover")
+                imagePath = game->getBackCoverPath();
+            else if (imageType == "3dbox")
+                imagePath = game->get3DBoxPath();
+            else if (imageType == "physicalmedia")
+                imagePath = game->getPhysicalMediaPath();
+            else if (imageType == "screenshot")
+                imagePath = game->getScreenshotPath();
+            else if (imageType == "titlescreen")
+                imagePath = game->getTitleScreenPath();
+            else if (imageType == "miximage")
+                imagePath = game->getMiximagePath();
+            else if (imageType == "fanart")
+                imagePath = game->getFanArtPath();
+            else if (imageType == "none") // Display the game name as text.
+                break;
+
+            if (imagePath != "")
+                break;
+        }
+    }
+
+    if (imagePath == "")
+        imagePath = entry.data.defaultImagePath;
+
+    return imagePath;
+}
+
+template <typename T> void GridComponent<T>::prefetchTextures(int firstPos, int lastPos)
+{
+    if constexpr (std::is_same_v<T, FileData*>) {
+        const int direction {(mScrollVelocity > 0) - (mScrollVelocity < 0)};
+        if (direction == 0)
+            return;
+
+        // Anything prefetched in the other direction is stale when the scrolling reverses.
+        if (direction != mPrefetchDirection) {
+            for (auto& path : mPrefetchPaths)
+                TextureResource::cancelPrefetch(path);
+            mPrefetchPaths.clear();
+            mPrefetchDirection = direction;
+        }
+
+        const int numEntries {size()};
+        const int prefetchItems {getPrefetchSteps(maxPrefetchRows) * mColumns};
+        int cursor {direction > 0 ? lastPos : firstPos - 1};
+
+        for (int i {0}; i < prefetchItems && cursor >= 0 && cursor < numEntries;
+             ++i, cursor += direction) {
+            auto& entry = mEntries.at(cursor);
+            if (entry.data.imagePath != "")
+                continue;
+
+            // Resolving the media path requires file system lookups, so the result is kept
+            // for when the entry scrolls into view.
+            if (entry.data.prefetchPath == "")
+                entry.data.prefetchPath = getImagePath(entry);
+
+            const std::string& path {entry.data.prefetchPath};
+            if (path == entry.data.defaultImagePath ||
+                std::find(mPrefetchPaths.cbegin(), mPrefetchPaths.cend(), path) !=
+                    mPrefetchPaths.cend())
+                continue;
+
+            TextureResource::prefetch(path);
+            mPrefetchPaths.emplace_back(path);
+        }
+
+        if (mPrefetchPaths.size() > maxPrefetchPaths)
+            mPrefetchPaths.erase(mPrefetchPaths.begin(),
+                                 mPrefetchPaths.end() - maxPrefetchPaths);
+    }
+}
+
+template <typename T>
+std::shared_ptr<TextComponent> GridComponent<T>::createTextItem(const std::string& text)
+{
+    auto item = std::make_shared<TextComponent>(
+        text, mFont, 0x000000FF, Alignment::ALIGN_CENTER, Alignment::ALIGN_CENTER,
+        glm::vec3 {0.0f, 0.0f, 0.0f}, mItemSize * mTextRelativeScale, 0x00000000, mLineSpacing,
+        1.0f, mTextHorizontalScrolling, mTextHorizontalScrollSpeed, mTextHorizontalScrollDelay,
+        mTextHorizontalScrollGap);
+    item->setOrigin(0.5f, 0.5f);
+    item->setColor(mTextColor);
+    item->setBackgroundColor(mTextBackgroundColor);
+    item->setRenderBackground(true);
+
+    return item;
+}
+
+template <typename T> glm::vec3 GridComponent<T>::getItemPosition(int index) const
+{
+    const float column {static_cast<float>(index % mColumns)};
+    const float row {static_cast<float>(index / mColumns)};
+
+    return glm::vec3 {mHorizontalMargin + (mItemSize.x * column) + (mItemSize.x * 0.5f) +
+                          mItemSpacing.x * column,
+                      mVerticalMargin + (mItemSize.y * row) + (mItemSize.y * 0.5f) +
+                          mItemSpacing.y * row,
+                      0.0f};
+}
+
+template <typename T> void GridComponent<T>::bindItem(int index)
+{
+    auto& entry = mEntries.at(index);
+
+    if (entry.data.item)
+        return;
+
+    std::shared_ptr<TextComponent> text;
+    if (!mTextPool.empty()) {
+        text = mTextPool.back();
+        mTextPool.pop_back();
+        text->setText(entry.name);
+        text->resetComponent();
+    }
+    else {
+        text = createTextItem(entry.name);
+    }
+
+    if (mColumns != 0)
+        text->setPosition(getItemPosition(index));
+
+    entry.data.item = text;
+    mBoundEntries.emplace_back(index);
+}
+
+template <typename T> void GridComponent<T>::releaseItems(int firstPos, int lastPos)
+{
+    // Items within one screen of the loaded entries are retained so that scrolling back and
+    // forth does not constantly recreate them.
+    const int margin {lastPos - firstPos};
+
+    for (auto it = mBoundEntries.begin(); it != mBoundEntries.end();) {
+        if (*it >= firstPos - margin && *it < lastPos + margin) {
+            ++it;
+            continue;
+        }
+
+        auto& entry = mEntries.at(*it);
+        if (entry.data.imagePath == "") {
+            if (mTextPool.size() < maxPooledItems)
+                mTextPool.emplace_back(std::static_pointer_cast<TextComponent>(entry.data.item));
+        }
+        else if (entry.data.imagePath.front() != ':' && mImagePool.size() < maxPooledItems) {
+            // Bundled images are always loaded statically by ImageComponent so such components
+            // can't be reused for other images.
+            auto image = std::static_pointer_cast<ImageComponent>(entry.data.item);
+            image->setImage("");
+            mImagePool.emplace_back(image);
+        }
+
+        entry.data.item.reset();
+        entry.data.imagePath = "";
+        it = mBoundEntries.erase(it);
     }
 }
 
@@ -535,7 +727,6 @@ template <typename T> void GridComponent<T>::calculateLayout()
             ((mItemSize.y * (mScaleInwards ? 1.0f : mItemScale)) - mItemSize.y) / 2.0f;
     }
 
-    int columnCount {0};
     mColumns = 0;
     mRows = 0;
 
@@ -553,19 +744,12 @@ template <typename T> void GridComponent<T>::calculateLayout()
     if (mColumns == 0)
         ++mColumns;
 
-    for (auto& entry : mEntries) {
-        entry.data.item->setPosition(glm::vec3 {
-            mHorizontalMargin + (mItemSize.x * columnCount) + (mItemSize.x * 0.5f) +
-                mItemSpacing.x * columnCount,
-            mVerticalMargin + (mItemSize.y * mRows) + (mItemSize.y * 0.5f) + mItemSpacing.y * mRows,
-            0.0f});
-        if (columnCount == mColumns - 1) {
-            ++mRows;
-            columnCount = 0;
-            continue;
-        }
+    // Note that mRows does not include a partially filled last row.
+    mRows = size() / mColumns;
 
-        ++columnCount;
+    for (int i {0}; i < size(); ++i) {
+        if (mEntries.at(i).data.item)
+            mEntries.at(i).data.item->setPosition(getItemPosition(i));
     }
 
     mVisibleRows = mSize.y / (mItemSize.y + mItemSpacing.y);
@@ -647,11 +831,26 @@ template <typename T> bool GridComponent<T>::input(InputConfig* config, Input in
 
 template <typename T> void GridComponent<T>::update(int deltaTime)
 {
+    if (mGamelistView)
+        bindItem(mCursor);
     mEntries.at(mCursor).data.item->update(deltaTime);
     List::listUpdate(deltaTime);
     GuiComponent::update(deltaTime);
 }
 
+template <typename T> bool GridComponent<T>::isAnimating()
+{
+    if (mScrollVelocity != 0)
+        return true;
+    // Only the selected entry is updated, so that's the only one that can animate. Its item
+    // may have been released, in which case it's not animating until it's bound again.
+    if (!mEntries.empty() && mEntries.at(mCursor).data.item &&
+        mEntries.at(mCursor).data.item->isAnimating())
+        return true;
+
+    return GuiComponent::isAnimating();
+}
+
 template <typename T> void GridComponent<T>::render(const glm::mat4& parentTrans)
 {
     if (mEntries.empty())
@@ -727,6 +926,13 @@ template <typename T> void GridComponent<T>::render(const glm::mat4& parentTrans
     if (mLastCursor != mCursor)
         renderEntries.emplace_back(mCursor);
 
+    // Entries can be rendered before onDemandTextureLoad() has been called for them, for
+    // example while quick-jumping, in which case the text fallback is displayed.
+    if (mGamelistView) {
+        for (auto index : renderEntries)
+            bindItem(static_cast<int>(index));
+    }
+
     float scale {1.0f};
     float opacity {1.0f};
     float saturation {1.0f};
@@ -1498,7 +1704,7 @@ void GridComponent<T>::applyTheme(const std::shared_ptr<ThemeData>& theme,
 
 template <typename T> void GridComponent<T>::onCursorChanged(const CursorState& state)
 {
-    if (mEntries.size() > static_cast<size_t>(mLastCursor))
+    if (mEntries.size() > static_cast<size_t>(mLastCursor) && mEntries.at(mLastCursor).data.item)
         mEntries.at(mLastCursor).data.item->resetComponent();
 
     if (mColumns == 0)
@@ -50,6 +50,7 @@ public:
 
     bool input(InputConfig* config, Input input) override;
     void update(int deltaTime) override;
+    bool isAnimating() override;
     void render(const glm::mat4& parentTrans) override;
     void applyTheme(const std::shared_ptr<ThemeData>& theme,
                     const std::string& view,
@@ -293,6 +294,17 @@ template <typename T> void TextListComponent<T>::update(int deltaTime)
     GuiComponent::update(deltaTime);
 }
 
+template <typename T> bool TextListComponent<T>::isAnimating()
+{
+    if (mScrollVelocity != 0)
+        return true;
+    // Only the selected entry is updated, so that's the only one that can animate.
+    if (!mEntries.empty() && mEntries.at(mCursor).data.entryName->isAnimating())
+        return true;
+
+    return GuiComponent::isAnimating();
+}
+
 template <typename T> void TextListComponent<T>::render(const glm::mat4& parentTrans)
 {
     if (size() == 0)
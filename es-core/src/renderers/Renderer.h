@@ -56,7 +56,8 @@ public:
         ROTATED               = 0x00000010, // Screen rotated 90 or 270 degrees.
         ROUNDED_CORNERS       = 0x00000020,
         ROUNDED_CORNERS_NO_AA = 0x00000040,
-        CONVERT_PIXEL_FORMAT  = 0x00000080
+        CONVERT_PIXEL_FORMAT  = 0x00000080,
+        YUV_PLANES            = 0x00000100  // Y, U and V planes bound to texture units 0 to 2.
     };
     // clang-format on
 
@@ -131,6 +132,21 @@ public:
         }
     };
 
+    struct FrameStatistics {
+        unsigned int drawCalls;
+        unsigned int batchedDraws;
+        unsigned int vertexUploads;
+        unsigned int uploadedBytes;
+
+        FrameStatistics()
+            : drawCalls {0}
+            , batchedDraws {0}
+            , vertexUploads {0}
+            , uploadedBytes {0}
+        {
+        }
+    };
+
     struct Rect {
         int x;
         int y;
@@ -191,6 +207,8 @@ public:
     static const float getScreenHeightModifier() { return sScreenHeightModifier; }
     static const float getScreenAspectRatio() { return sScreenAspectRatio; }
     static const float getScreenResolutionModifier() { return sScreenResolutionModifier; }
+    // Draw call and vertex upload counts for the most recently completed frame.
+    const FrameStatistics& getFrameStatistics() { return mLastFrameStatistics; }
 
     static constexpr glm::mat4 getIdentity() { return glm::mat4 {1.0f}; }
     glm::mat4 mTrans {getIdentity()};
@@ -222,10 +240,17 @@ public:
         const unsigned int numVertices,
         const BlendFactor srcBlendFactor = BlendFactor::ONE,
         const BlendFactor dstBlendFactor = BlendFactor::ONE_MINUS_SRC_ALPHA) = 0;
+    // Submits any triangle strips that have been queued by drawTriangleStrips(). This is done
+    // automatically whenever the rendering state changes, so it only needs to be called before
+    // performing rendering operations that are not going through the renderer.
+    virtual void flushBatch() = 0;
+    // If textureRGBA is set the output is read back to this buffer, and if textureID is set it's
+    // instead copied to this texture which never leaves VRAM. Otherwise it goes to the screen.
     virtual void shaderPostprocessing(
         const unsigned int shaders,
         const Renderer::postProcessingParams& parameters = postProcessingParams(),
-        unsigned char* textureRGBA = nullptr) = 0;
+        unsigned char* textureRGBA = nullptr,
+        const unsigned int textureID = 0) = 0;
     virtual void setMatrix(const glm::mat4& matrix) = 0;
     virtual void setViewport(const Rect& viewport) = 0;
     virtual void setScissor(const Rect& scissor) = 0;
@@ -240,6 +265,8 @@ protected:
     int mPaddingHeight {0};
     int mScreenOffsetX {0};
     int mScreenOffsetY {0};
+    FrameStatistics mFrameStatistics;
+    FrameStatistics mLastFrameStatistics;
 
 private:
     std::stack<Rect> mClipStack;
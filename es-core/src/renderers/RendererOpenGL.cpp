@@ -10,15 +10,32 @@
 
 #include "Settings.h"
 
+#include <algorithm>
+
 #if defined(__APPLE__)
 #include <chrono>
 #endif
 
+namespace
+{
+    // Initial size of the vertex buffer, it's grown if a single draw call needs more space.
+    const unsigned int vertexBufferSize {16384};
+} // namespace
+
 RendererOpenGL::RendererOpenGL() noexcept
     : mShaderFBO1 {0}
     , mShaderFBO2 {0}
     , mVertexBuffer1 {0}
     , mVertexBuffer2 {0}
+    , mVertexBufferSize {0}
+    , mVertexBufferOffset {0}
+    , mBatchTrans {getIdentity()}
+    , mBatchTextureSize {0.0f, 0.0f}
+    , mBatchSrcBlendFactor {BlendFactor::ONE}
+    , mBatchDstBlendFactor {BlendFactor::ONE_MINUS_SRC_ALPHA}
+    , mLastSrcBlendFactor {BlendFactor::ONE}
+    , mLastDstBlendFactor {BlendFactor::ZERO}
+    , mBoundTexture {0}
     , mSDLContext {nullptr}
     , mWhiteTexture {0}
     , mPostProcTexture1 {0}
@@ -277,6 +294,18 @@ bool RendererOpenGL::createContext()
     GL_CHECK_ERROR(glGenVertexArrays(1, &mVertexBuffer2));
     GL_CHECK_ERROR(glBindVertexArray(mVertexBuffer2));
 
+    // The vertex buffer is allocated once and then written to sequentially, and it's only
+    // reallocated (orphaned) when the end is reached. This avoids a buffer reallocation and
+    // the associated driver synchronization for every draw call.
+    mVertexBufferSize = vertexBufferSize;
+    mVertexBufferOffset = 0;
+    GL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * mVertexBufferSize, nullptr,
+                                GL_DYNAMIC_DRAW));
+    mBatchVertices.reserve(mVertexBufferSize);
+    mLastSrcBlendFactor = BlendFactor::ONE;
+    mLastDstBlendFactor = BlendFactor::ZERO;
+    mBoundTexture = 0;
+
     uint8_t data[4] {255, 255, 255, 255};
     mWhiteTexture = createTexture(0, TextureType::BGRA, false, false, false, true, 1, 1, data);
 
@@ -313,6 +342,9 @@ bool RendererOpenGL::createContext()
 
 void RendererOpenGL::destroyContext()
 {
+    mBatchVertices.clear();
+    GL_CHECK_ERROR(glDeleteBuffers(1, &mVertexBuffer1));
+    GL_CHECK_ERROR(glDeleteVertexArrays(1, &mVertexBuffer2));
     GL_CHECK_ERROR(glDeleteFramebuffers(1, &mShaderFBO1));
     GL_CHECK_ERROR(glDeleteFramebuffers(1, &mShaderFBO2));
     destroyTexture(mPostProcTexture1);
@@ -339,6 +371,7 @@ void RendererOpenGL::setMatrix(const glm::mat4& matrix)
 
 void RendererOpenGL::setViewport(const Rect& viewport)
 {
+    flushBatch();
     // glViewport starts at the bottom left of the window.
     GL_CHECK_ERROR(
         glViewport(viewport.x, mWindowHeight - viewport.y - viewport.h, viewport.w, viewport.h));
@@ -346,6 +379,8 @@ void RendererOpenGL::setViewport(const Rect& viewport)
 
 void RendererOpenGL::setScissor(const Rect& scissor)
 {
+    flushBatch();
+
     if ((scissor.x == 0) && (scissor.y == 0) && (scissor.w == 0) && (scissor.h == 0)) {
         GL_CHECK_ERROR(glDisable(GL_SCISSOR_TEST));
     }
@@ -379,6 +414,10 @@ void RendererOpenGL::setSwapInterval()
 
 void RendererOpenGL::swapBuffers()
 {
+    flushBatch();
+    mLastFrameStatistics = mFrameStatistics;
+    mFrameStatistics = FrameStatistics();
+
 #if defined(__APPLE__)
     // On macOS when running in the background, the OpenGL driver apparently does not swap
     // the frames which leads to a very fast swap time. This makes ES-DE use a lot of CPU
@@ -410,6 +449,8 @@ unsigned int RendererOpenGL::createTexture(const unsigned int texUnit,
 {
     assert(texUnit < 32);
 
+    flushBatch();
+
     const GLenum textureType {convertTextureType(type)};
     unsigned int texture;
 
@@ -455,11 +496,17 @@ unsigned int RendererOpenGL::createTexture(const unsigned int texUnit,
     if (mipmapping)
         GL_CHECK_ERROR(glGenerateMipmap(GL_TEXTURE_2D));
 
+    if (texUnit == 0)
+        mBoundTexture = texture;
+
     return texture;
 }
 
 void RendererOpenGL::destroyTexture(const unsigned int texture)
 {
+    flushBatch();
+    if (texture == mBoundTexture)
+        mBoundTexture = 0;
     GL_CHECK_ERROR(glDeleteTextures(1, &texture));
 }
 
@@ -474,6 +521,8 @@ void RendererOpenGL::updateTexture(const unsigned int texture,
 {
     assert(texUnit < 32);
 
+    flushBatch();
+
     const GLenum textureType {convertTextureType(type)};
     GL_CHECK_ERROR(glActiveTexture(GL_TEXTURE0 + texUnit));
     GL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, texture));
@@ -481,18 +530,28 @@ void RendererOpenGL::updateTexture(const unsigned int texture,
                                    GL_UNSIGNED_BYTE, data));
 
     GL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, mWhiteTexture));
+
+    if (texUnit == 0)
+        mBoundTexture = mWhiteTexture;
 }
 
 void RendererOpenGL::bindTexture(const unsigned int texture, const unsigned int texUnit)
 {
     assert(texUnit < 32);
 
+    const GLuint bindTexture {texture == 0 ? mWhiteTexture : texture};
+
+    // Only texture unit 0 is tracked, anything else will always submit the queued batch.
+    if (texUnit == 0 && bindTexture == mBoundTexture)
+        return;
+
+    flushBatch();
+
     GL_CHECK_ERROR(glActiveTexture(GL_TEXTURE0 + texUnit));
+    GL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, bindTexture));
 
-    if (texture == 0)
-        GL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, mWhiteTexture));
-    else
-        GL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, texture));
+    if (texUnit == 0)
+        mBoundTexture = bindTexture;
 }
 
 void RendererOpenGL::drawTriangleStrips(const Vertex* vertices,
@@ -503,37 +562,40 @@ void RendererOpenGL::drawTriangleStrips(const Vertex* vertices,
     const float width {vertices[3].position[0]};
     const float height {vertices[3].position[1]};
 
-    GL_CHECK_ERROR(
-        glBlendFunc(convertBlendFactor(srcBlendFactor), convertBlendFactor(dstBlendFactor)));
+    if ((vertices->shaders == 0 || vertices->shaders & Shader::CORE) &&
+        !(vertices->shaderFlags & ShaderFlags::POST_PROCESSING)) {
+        // Core shader draws are queued and consecutive draws using identical state are joined
+        // using degenerate triangles, and then submitted as a single draw call. The texture
+        // binding is not part of the state as any change to it will submit the queued batch.
+        if (!mBatchVertices.empty() &&
+            (!isBatchCompatible(vertices, srcBlendFactor, dstBlendFactor) ||
+             mBatchVertices.size() + numVertices + 2 > mVertexBufferSize)) {
+            flushBatch();
+        }
 
-    if (vertices->shaders == 0 || vertices->shaders & Shader::CORE) {
-        if (mCoreShader == nullptr)
-            mCoreShader = getShaderProgram(Shader::CORE);
-        if (mCoreShader) {
-            if (mLastShader != mCoreShader)
-                mCoreShader->activateShaders();
-            mCoreShader->setModelViewProjectionMatrix(mTrans);
-            if (mLastShader != mCoreShader)
-                mCoreShader->setAttribPointers();
-            GL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * numVertices, vertices,
-                                        GL_DYNAMIC_DRAW));
-            mCoreShader->setTextureSamplers();
-            mCoreShader->setTextureSize({width, height});
-            mCoreShader->setClipRegion(vertices->clipRegion);
-            mCoreShader->setBrightness(vertices->brightness);
-            mCoreShader->setOpacity(vertices->opacity);
-            mCoreShader->setSaturation(vertices->saturation);
-            mCoreShader->setDimming(vertices->dimming);
-            if (vertices->shaderFlags & ShaderFlags::ROUNDED_CORNERS ||
-                vertices->shaderFlags & ShaderFlags::ROUNDED_CORNERS_NO_AA) {
-                mCoreShader->setTextureSize({width, height});
-                mCoreShader->setCornerRadius(vertices->cornerRadius);
-            }
-            mCoreShader->setReflectionsFalloff(vertices->reflectionsFalloff);
-            mCoreShader->setFlags(vertices->shaderFlags);
-            GL_CHECK_ERROR(glDrawArrays(GL_TRIANGLE_STRIP, 0, numVertices));
-            mLastShader = mCoreShader;
+        if (mBatchVertices.empty()) {
+            mBatchState = *vertices;
+            mBatchTrans = mTrans;
+            mBatchTextureSize = {width, height};
+            mBatchSrcBlendFactor = srcBlendFactor;
+            mBatchDstBlendFactor = dstBlendFactor;
+        }
+        else {
+            const Vertex lastVertex {mBatchVertices.back()};
+            mBatchVertices.emplace_back(lastVertex);
+            mBatchVertices.emplace_back(vertices[0]);
+            ++mFrameStatistics.batchedDraws;
         }
+
+        mBatchVertices.insert(mBatchVertices.end(), vertices, vertices + numVertices);
+        return;
+    }
+
+    flushBatch();
+    setBlendFunc(srcBlendFactor, dstBlendFactor);
+
+    if (vertices->shaders == 0 || vertices->shaders & Shader::CORE) {
+        drawCoreShader(vertices, numVertices, *vertices, mTrans, {width, height});
     }
     else if (vertices->shaders & Shader::BLUR_HORIZONTAL) {
         if (mBlurHorizontalShader == nullptr)
@@ -544,12 +606,12 @@ void RendererOpenGL::drawTriangleStrips(const Vertex* vertices,
             mBlurHorizontalShader->setModelViewProjectionMatrix(mTrans);
             if (mLastShader != mBlurHorizontalShader)
                 mBlurHorizontalShader->setAttribPointers();
-            GL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * numVertices, vertices,
-                                        GL_DYNAMIC_DRAW));
+            const GLint firstVertex {uploadVertices(vertices, numVertices)};
             mBlurHorizontalShader->setBlurStrength((vertices->blurStrength / getScreenWidth()) *
                                                    getScreenResolutionModifier());
             mBlurHorizontalShader->setFlags(vertices->shaderFlags);
-            GL_CHECK_ERROR(glDrawArrays(GL_TRIANGLE_STRIP, 0, numVertices));
+            GL_CHECK_ERROR(glDrawArrays(GL_TRIANGLE_STRIP, firstVertex, numVertices));
+            ++mFrameStatistics.drawCalls;
             mLastShader = mBlurHorizontalShader;
         }
         return;
@@ -563,12 +625,12 @@ void RendererOpenGL::drawTriangleStrips(const Vertex* vertices,
             mBlurVerticalShader->setModelViewProjectionMatrix(mTrans);
             if (mLastShader != mBlurVerticalShader)
                 mBlurVerticalShader->setAttribPointers();
-            GL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * numVertices, vertices,
-                                        GL_DYNAMIC_DRAW));
+            const GLint firstVertex {uploadVertices(vertices, numVertices)};
             mBlurVerticalShader->setBlurStrength((vertices->blurStrength / getScreenHeight()) *
                                                  getScreenResolutionModifier());
             mBlurVerticalShader->setFlags(vertices->shaderFlags);
-            GL_CHECK_ERROR(glDrawArrays(GL_TRIANGLE_STRIP, 0, numVertices));
+            GL_CHECK_ERROR(glDrawArrays(GL_TRIANGLE_STRIP, firstVertex, numVertices));
+            ++mFrameStatistics.drawCalls;
             mLastShader = mBlurVerticalShader;
         }
         return;
@@ -601,23 +663,132 @@ void RendererOpenGL::drawTriangleStrips(const Vertex* vertices,
             mScanlinelShader->setModelViewProjectionMatrix(mTrans);
             if (mLastShader != mScanlinelShader)
                 mScanlinelShader->setAttribPointers();
-            GL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * numVertices, vertices,
-                                        GL_DYNAMIC_DRAW));
+            const GLint firstVertex {uploadVertices(vertices, numVertices)};
+            mScanlinelShader->setTextureSamplers();
             mScanlinelShader->setOpacity(vertices->opacity);
             mScanlinelShader->setBrightness(vertices->brightness);
             mScanlinelShader->setSaturation(vertices->saturation);
             mScanlinelShader->setTextureSize({shaderWidth, shaderHeight});
             mScanlinelShader->setFlags(vertices->shaderFlags);
-            GL_CHECK_ERROR(glDrawArrays(GL_TRIANGLE_STRIP, 0, numVertices));
+            GL_CHECK_ERROR(glDrawArrays(GL_TRIANGLE_STRIP, firstVertex, numVertices));
+            ++mFrameStatistics.drawCalls;
             mLastShader = mScanlinelShader;
         }
     }
 }
 
+void RendererOpenGL::flushBatch()
+{
+    if (mBatchVertices.empty())
+        return;
+
+    setBlendFunc(mBatchSrcBlendFactor, mBatchDstBlendFactor);
+    drawCoreShader(&mBatchVertices[0], static_cast<unsigned int>(mBatchVertices.size()),
+                   mBatchState, mBatchTrans, mBatchTextureSize);
+    mBatchVertices.clear();
+}
+
+bool RendererOpenGL::isBatchCompatible(const Vertex* vertices,
+                                       const BlendFactor srcBlendFactor,
+                                       const BlendFactor dstBlendFactor)
+{
+    // Rounded corners are calculated relative to the vertex positions of each individual
+    // draw call so these can't be combined.
+    const unsigned int roundedCorners {ShaderFlags::ROUNDED_CORNERS |
+                                       ShaderFlags::ROUNDED_CORNERS_NO_AA};
+    if (vertices->shaderFlags & roundedCorners || mBatchState.shaderFlags & roundedCorners)
+        return false;
+
+    return srcBlendFactor == mBatchSrcBlendFactor && dstBlendFactor == mBatchDstBlendFactor &&
+           mTrans == mBatchTrans && vertices->shaderFlags == mBatchState.shaderFlags &&
+           vertices->clipRegion == mBatchState.clipRegion &&
+           vertices->brightness == mBatchState.brightness &&
+           vertices->opacity == mBatchState.opacity &&
+           vertices->saturation == mBatchState.saturation &&
+           vertices->dimming == mBatchState.dimming &&
+           vertices->reflectionsFalloff == mBatchState.reflectionsFalloff;
+}
+
+GLint RendererOpenGL::uploadVertices(const Vertex* vertices, const unsigned int numVertices)
+{
+    if (numVertices > mVertexBufferSize) {
+        mVertexBufferSize = std::max(numVertices, mVertexBufferSize * 2);
+        mVertexBufferOffset = mVertexBufferSize;
+    }
+
+    // When the end of the buffer has been reached it's orphaned so the driver can allocate new
+    // storage for it while any pending draw calls are still using the old storage.
+    if (mVertexBufferOffset + numVertices > mVertexBufferSize) {
+        GL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * mVertexBufferSize, nullptr,
+                                    GL_DYNAMIC_DRAW));
+        mVertexBufferOffset = 0;
+    }
+
+    GL_CHECK_ERROR(glBufferSubData(GL_ARRAY_BUFFER, sizeof(Vertex) * mVertexBufferOffset,
+                                   sizeof(Vertex) * numVertices, vertices));
+
+    const GLint firstVertex {static_cast<GLint>(mVertexBufferOffset)};
+    mVertexBufferOffset += numVertices;
+
+    ++mFrameStatistics.vertexUploads;
+    mFrameStatistics.uploadedBytes += static_cast<unsigned int>(sizeof(Vertex) * numVertices);
+
+    return firstVertex;
+}
+
+void RendererOpenGL::setBlendFunc(const BlendFactor srcBlendFactor,
+                                  const BlendFactor dstBlendFactor)
+{
+    if (srcBlendFactor == mLastSrcBlendFactor && dstBlendFactor == mLastDstBlendFactor)
+        return;
+
+    GL_CHECK_ERROR(
+        glBlendFunc(convertBlendFactor(srcBlendFactor), convertBlendFactor(dstBlendFactor)));
+    mLastSrcBlendFactor = srcBlendFactor;
+    mLastDstBlendFactor = dstBlendFactor;
+}
+
+void RendererOpenGL::drawCoreShader(const Vertex* vertices,
+                                    const unsigned int numVertices,
+                                    const Vertex& state,
+                                    const glm::mat4& trans,
+                                    const glm::vec2& textureSize)
+{
+    if (mCoreShader == nullptr)
+        mCoreShader = getShaderProgram(Shader::CORE);
+    if (mCoreShader) {
+        if (mLastShader != mCoreShader)
+            mCoreShader->activateShaders();
+        mCoreShader->setModelViewProjectionMatrix(trans);
+        if (mLastShader != mCoreShader)
+            mCoreShader->setAttribPointers();
+        const GLint firstVertex {uploadVertices(vertices, numVertices)};
+        mCoreShader->setTextureSamplers();
+        mCoreShader->setTextureSize({textureSize.x, textureSize.y});
+        mCoreShader->setClipRegion(state.clipRegion);
+        mCoreShader->setBrightness(state.brightness);
+        mCoreShader->setOpacity(state.opacity);
+        mCoreShader->setSaturation(state.saturation);
+        mCoreShader->setDimming(state.dimming);
+        if (state.shaderFlags & ShaderFlags::ROUNDED_CORNERS ||
+            state.shaderFlags & ShaderFlags::ROUNDED_CORNERS_NO_AA) {
+            mCoreShader->setCornerRadius(state.cornerRadius);
+        }
+        mCoreShader->setReflectionsFalloff(state.reflectionsFalloff);
+        mCoreShader->setFlags(state.shaderFlags);
+        GL_CHECK_ERROR(glDrawArrays(GL_TRIANGLE_STRIP, firstVertex, numVertices));
+        ++mFrameStatistics.drawCalls;
+        mLastShader = mCoreShader;
+    }
+}
+
 void RendererOpenGL::shaderPostprocessing(unsigned int shaders,
                                           const Renderer::postProcessingParams& parameters,
-                                          unsigned char* textureRGBA)
+                                          unsigned char* textureRGBA,
+                                          const unsigned int textureID)
 {
+    flushBatch();
+
     Vertex vertices[4];
     std::vector<unsigned int> shaderList;
     float widthf {getScreenWidth()};
@@ -627,6 +798,8 @@ void RendererOpenGL::shaderPostprocessing(unsigned int shaders,
     const int screenRotation {getScreenRotation()};
     const bool offsetOrPadding {mScreenOffsetX != 0 || mScreenOffsetY != 0 || mPaddingWidth != 0 ||
                                 mPaddingHeight != 0};
+    // Whether the output goes to a texture (in RAM or VRAM) rather than to the screen.
+    const bool toTexture {textureRGBA != nullptr || textureID != 0};
 
     if (offsetOrPadding) {
         Rect viewportTemp {mViewport};
@@ -696,7 +869,7 @@ void RendererOpenGL::shaderPostprocessing(unsigned int shaders,
             mScreenOffsetY, width - mScreenOffsetX, height, GL_COLOR_BUFFER_BIT, GL_NEAREST));
     }
     else if (screenRotation == 90 || screenRotation == 270) {
-        if (!evenBlurPasses || !textureRGBA)
+        if (!evenBlurPasses || !toTexture)
             GL_CHECK_ERROR(glBlitFramebuffer(0, 0, height + mPaddingWidth, width - mScreenOffsetY,
                                              -mScreenOffsetX - mPaddingWidth, mScreenOffsetY,
                                              height - mScreenOffsetX, width, GL_COLOR_BUFFER_BIT,
@@ -707,11 +880,11 @@ void RendererOpenGL::shaderPostprocessing(unsigned int shaders,
                                              width - mScreenOffsetY, mScreenOffsetX, 0,
                                              GL_COLOR_BUFFER_BIT, GL_NEAREST));
         // If not rendering to a texture, apply shaders without any rotation applied.
-        if (!textureRGBA)
+        if (!toTexture)
             mTrans = getProjectionMatrixNormal() * getIdentity();
     }
     else {
-        if ((shaderCalls + (textureRGBA ? 1 : 0)) % 2 == 0 && !(textureRGBA && shaderCalls == 1))
+        if ((shaderCalls + (toTexture ? 1 : 0)) % 2 == 0 && !(toTexture && shaderCalls == 1))
             GL_CHECK_ERROR(glBlitFramebuffer(0, 0, width + mPaddingWidth, height - mScreenOffsetY,
                                              -mScreenOffsetX - mPaddingWidth, mScreenOffsetY,
                                              width - mScreenOffsetX, height, GL_COLOR_BUFFER_BIT,
@@ -722,7 +895,7 @@ void RendererOpenGL::shaderPostprocessing(unsigned int shaders,
                                              height - mScreenOffsetY, mScreenOffsetX, 0,
                                              GL_COLOR_BUFFER_BIT, GL_NEAREST));
         // For correct rendering if the blurred background is disabled when opening menus.
-        if (textureRGBA && shaderCalls == 1)
+        if (toTexture && shaderCalls == 1)
             mTrans = getProjectionMatrixNormal() * getIdentity();
     }
 
@@ -742,7 +915,7 @@ void RendererOpenGL::shaderPostprocessing(unsigned int shaders,
         }
 
         for (int p {0}; p < shaderPasses; ++p) {
-            if (!textureRGBA && i == shaderList.size() - 1 && p == shaderPasses - 1) {
+            if (!toTexture && i == shaderList.size() - 1 && p == shaderPasses - 1) {
                 GL_CHECK_ERROR(glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0));
                 if (offsetOrPadding)
                     setViewport(mViewport);
@@ -774,16 +947,25 @@ void RendererOpenGL::shaderPostprocessing(unsigned int shaders,
         }
     }
 
-    // If textureRGBA has an address, it means that the output should go to this
-    // texture rather than to the screen. The glReadPixels() function is slow, but
-    // since this will typically only run every now and then to create a cached
-    // screen texture, it doesn't really matter.
-    if (textureRGBA) {
+    // If textureID is set, the output is copied from the framebuffer to this texture. As
+    // this is done entirely on the GPU there is no pipeline stall like for glReadPixels(),
+    // which is only used if textureRGBA has an address.
+    if (toTexture) {
         if (firstFBO)
             GL_CHECK_ERROR(glBindFramebuffer(GL_READ_FRAMEBUFFER, mShaderFBO1));
         else
             GL_CHECK_ERROR(glBindFramebuffer(GL_READ_FRAMEBUFFER, mShaderFBO2));
+    }
 
+    if (textureID != 0) {
+        bindTexture(textureID, 0);
+        if (screenRotation == 0 || screenRotation == 180)
+            GL_CHECK_ERROR(glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, width, height));
+        else
+            GL_CHECK_ERROR(glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, height, width));
+        GL_CHECK_ERROR(glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0));
+    }
+    else if (textureRGBA) {
 #if defined(USE_OPENGLES)
         if (screenRotation == 0 || screenRotation == 180)
             GL_CHECK_ERROR(
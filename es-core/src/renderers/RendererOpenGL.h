@@ -67,19 +67,47 @@ public:
         const unsigned int numVertices,
         const BlendFactor srcBlendFactor = BlendFactor::ONE,
         const BlendFactor dstBlendFactor = BlendFactor::ONE_MINUS_SRC_ALPHA) override;
+    void flushBatch() override;
     void shaderPostprocessing(
         const unsigned int shaders,
         const Renderer::postProcessingParams& parameters = postProcessingParams(),
-        unsigned char* textureRGBA = nullptr) override;
+        unsigned char* textureRGBA = nullptr,
+        const unsigned int textureID = 0) override;
 
 private:
     RendererOpenGL() noexcept;
 
+    // Returns whether the vertices can be appended to the currently queued batch.
+    bool isBatchCompatible(const Vertex* vertices,
+                           const BlendFactor srcBlendFactor,
+                           const BlendFactor dstBlendFactor);
+    // Copies the vertices into the vertex buffer and returns the index of the first vertex.
+    GLint uploadVertices(const Vertex* vertices, const unsigned int numVertices);
+    void setBlendFunc(const BlendFactor srcBlendFactor, const BlendFactor dstBlendFactor);
+    void drawCoreShader(const Vertex* vertices,
+                        const unsigned int numVertices,
+                        const Vertex& state,
+                        const glm::mat4& trans,
+                        const glm::vec2& textureSize);
+
     std::vector<std::shared_ptr<ShaderOpenGL>> mShaderProgramVector;
     GLuint mShaderFBO1;
     GLuint mShaderFBO2;
     GLuint mVertexBuffer1;
     GLuint mVertexBuffer2;
+    // Size and write position of the vertex buffer, counted in vertices.
+    unsigned int mVertexBufferSize;
+    unsigned int mVertexBufferOffset;
+
+    std::vector<Vertex> mBatchVertices;
+    Vertex mBatchState;
+    glm::mat4 mBatchTrans;
+    glm::vec2 mBatchTextureSize;
+    BlendFactor mBatchSrcBlendFactor;
+    BlendFactor mBatchDstBlendFactor;
+    BlendFactor mLastSrcBlendFactor;
+    BlendFactor mLastDstBlendFactor;
+    GLuint mBoundTexture;
 
     SDL_GLContext mSDLContext;
     GLuint mWhiteTexture;
@@ -99,6 +99,7 @@ private:
     GLint mShaderColor;
     GLint mTextureSampler0;
     GLint mTextureSampler1;
+    GLint mTextureSampler2;
     GLint mShaderTextureSize;
     GLint mShaderClipRegion;
     GLint mShaderBrightness;
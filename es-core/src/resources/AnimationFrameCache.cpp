@@ -0,0 +1,259 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  AnimationFrameCache.cpp
+//
+//  Cache of decoded frames for GIF and Lottie animations, shared between all components
+//  playing the same file at the same size. Frames are decoded ahead of the playback
+//  position by a background thread, so the same animation is only decoded once regardless
+//  of how many times it's used by the theme.
+//
+
+#include "resources/AnimationFrameCache.h"
+
+#include "Log.h"
+#include "Settings.h"
+#include "utils/MathUtil.h"
+
+#include <algorithm>
+
+namespace
+{
+    // Number of frames to decode ahead of the playback position. These frames are always
+    // kept, even if this means exceeding the cache limits.
+    constexpr int decodeAheadFrames {8};
+} // namespace
+
+AnimationFrameCache::Source::Source(const std::shared_ptr<SharedState>& state,
+                                    const std::string& key,
+                                    int totalFrames,
+                                    size_t frameSize)
+    : mState {state}
+    , mKey {key}
+    , mFrames(static_cast<size_t>(totalFrames))
+    , mTotalFrames {totalFrames}
+    , mFrameSize {frameSize}
+    , mCacheSize {0}
+    , mMaxCacheSize {0}
+    , mPlaybackPosition {0}
+    , mReverse {false}
+    , mQueued {false}
+    , mDecodeFailed {false}
+{
+}
+
+AnimationFrameCache::Source::~Source()
+{
+    std::unique_lock<std::mutex> lock {mState->mutex};
+    mState->totalCacheSize -= mCacheSize;
+}
+
+AnimationFrameCache::Frame AnimationFrameCache::Source::getFrame(int frameNum, bool reverse)
+{
+    if (frameNum < 0 || frameNum >= mTotalFrames)
+        return nullptr;
+
+    std::unique_lock<std::mutex> lock {mState->mutex};
+
+    const bool moved {frameNum != mPlaybackPosition || reverse != mReverse};
+    mPlaybackPosition = frameNum;
+    mReverse = reverse;
+
+    Frame frame {mFrames[frameNum]};
+
+    // The decode-ahead window has moved so frames behind the playback position may need to
+    // be released, and new frames need to be decoded.
+    if (moved)
+        evictFrames();
+
+    if (!mQueued && !mDecodeFailed && getNextFrameToDecode() != -1) {
+        mQueued = true;
+        lock.unlock();
+        AnimationFrameCache::getInstance().queueSource(shared_from_this());
+    }
+
+    return frame;
+}
+
+int AnimationFrameCache::Source::getNextFrameToDecode() const
+{
+    for (int i {0}; i < std::min(decodeAheadFrames, mTotalFrames); ++i) {
+        int frameNum {mReverse ? mPlaybackPosition - i : mPlaybackPosition + i};
+        if (frameNum < 0)
+            frameNum += mTotalFrames;
+        else if (frameNum >= mTotalFrames)
+            frameNum -= mTotalFrames;
+        if (mFrames[frameNum] == nullptr)
+            return frameNum;
+    }
+
+    return -1;
+}
+
+void AnimationFrameCache::Source::evictFrames()
+{
+    if (mCacheSize <= mMaxCacheSize && mState->totalCacheSize <= mState->maxTotalCacheSize)
+        return;
+
+    // Start with the frame right behind the playback position as that is the frame that will
+    // be needed the furthest into the future.
+    for (int i {mTotalFrames - 1}; i >= decodeAheadFrames; --i) {
+        if (mCacheSize <= mMaxCacheSize && mState->totalCacheSize <= mState->maxTotalCacheSize)
+            break;
+        int frameNum {mReverse ? mPlaybackPosition - i : mPlaybackPosition + i};
+        frameNum = ((frameNum % mTotalFrames) + mTotalFrames) % mTotalFrames;
+        if (mFrames[frameNum] != nullptr) {
+            mFrames[frameNum].reset();
+            mCacheSize -= mFrameSize;
+            mState->totalCacheSize -= mFrameSize;
+        }
+    }
+}
+
+AnimationFrameCache::AnimationFrameCache()
+    : mState {std::make_shared<SharedState>()}
+    , mExit {false}
+{
+}
+
+AnimationFrameCache::~AnimationFrameCache()
+{
+    if (mDecodingThread) {
+        {
+            std::unique_lock<std::mutex> lock {mState->mutex};
+            mExit = true;
+        }
+        mQueueCondition.notify_one();
+        mDecodingThread->join();
+        mDecodingThread.reset();
+    }
+}
+
+AnimationFrameCache& AnimationFrameCache::getInstance()
+{
+    static AnimationFrameCache instance;
+    return instance;
+}
+
+std::shared_ptr<AnimationFrameCache::Source> AnimationFrameCache::getSource(
+    const std::string& key,
+    int totalFrames,
+    size_t frameSize,
+    const std::function<FrameDecoder()>& createDecoder)
+{
+    if (totalFrames <= 0 || frameSize == 0)
+        return nullptr;
+
+    // This is declared outside the locked scope as the source destructor needs the lock.
+    std::shared_ptr<Source> source;
+
+    {
+        std::unique_lock<std::mutex> lock {mState->mutex};
+
+        // Keep the cache sizes within 0 to 1024 MiB per file and 0 to 4096 MiB in total.
+        mState->maxTotalCacheSize =
+            static_cast<size_t>(
+                glm::clamp(Settings::getInstance()->getInt("LottieMaxTotalCache"), 0, 4096)) *
+            1024 * 1024;
+
+        auto it = mSources.find(key);
+        if (it != mSources.end()) {
+            source = it->second.lock();
+            if (source != nullptr && source->mTotalFrames == totalFrames &&
+                source->mFrameSize == frameSize)
+                return source;
+        }
+
+        // Remove the entries for any sources that are no longer in use.
+        for (auto sourceIt = mSources.begin(); sourceIt != mSources.end();) {
+            if (sourceIt->second.expired())
+                sourceIt = mSources.erase(sourceIt);
+            else
+                ++sourceIt;
+        }
+    }
+
+    // Creating the decoder may be slow so it's done without holding the lock.
+    FrameDecoder decoder {createDecoder()};
+    if (!decoder)
+        return nullptr;
+
+    source.reset(new Source {mState, key, totalFrames, frameSize});
+    source->mDecoder = std::move(decoder);
+    source->mMaxCacheSize =
+        static_cast<size_t>(
+            glm::clamp(Settings::getInstance()->getInt("LottieMaxFileCache"), 0, 1024)) *
+        1024 * 1024;
+
+    std::unique_lock<std::mutex> lock {mState->mutex};
+    mSources[key] = source;
+    return source;
+}
+
+void AnimationFrameCache::queueSource(const std::shared_ptr<Source>& source)
+{
+    if (source == nullptr)
+        return;
+
+    {
+        std::unique_lock<std::mutex> lock {mState->mutex};
+        if (!mDecodingThread)
+            mDecodingThread =
+                std::make_unique<std::thread>(&AnimationFrameCache::decodingThread, this);
+        mQueue.emplace_back(source);
+    }
+    mQueueCondition.notify_one();
+}
+
+void AnimationFrameCache::decodingThread()
+{
+    while (true) {
+        std::shared_ptr<Source> source;
+        int frameNum {-1};
+        {
+            std::unique_lock<std::mutex> lock {mState->mutex};
+            mQueueCondition.wait(lock, [this] { return mExit || !mQueue.empty(); });
+            if (mExit)
+                return;
+
+            source = mQueue.front().lock();
+            mQueue.pop_front();
+            if (source == nullptr)
+                continue;
+
+            frameNum = source->getNextFrameToDecode();
+            if (frameNum == -1) {
+                source->mQueued = false;
+                lock.unlock();
+                source.reset();
+                continue;
+            }
+        }
+
+        std::shared_ptr<std::vector<uint8_t>> pixels {
+            std::make_shared<std::vector<uint8_t>>(source->mFrameSize)};
+        const bool decoded {source->mDecoder(frameNum, *pixels)};
+
+        {
+            std::unique_lock<std::mutex> lock {mState->mutex};
+            if (!decoded) {
+                LOG(LogError) << "AnimationFrameCache: Couldn't decode frame " << frameNum
+                              << " of \"" << source->mKey << "\"";
+                source->mDecodeFailed = true;
+                source->mQueued = false;
+            }
+            else {
+                if (source->mFrames[frameNum] == nullptr) {
+                    source->mFrames[frameNum] = pixels;
+                    source->mCacheSize += source->mFrameSize;
+                    mState->totalCacheSize += source->mFrameSize;
+                    source->evictFrames();
+                }
+                // Sources take turns decoding one frame at a time.
+                mQueue.emplace_back(source);
+            }
+        }
+        // Release the source without holding the lock as its destructor needs it.
+        source.reset();
+    }
+}
@@ -0,0 +1,108 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  AnimationFrameCache.h
+//
+//  Cache of decoded frames for GIF and Lottie animations, shared between all components
+//  playing the same file at the same size. Frames are decoded ahead of the playback
+//  position by a background thread, so the same animation is only decoded once regardless
+//  of how many times it's used by the theme.
+//
+
+#ifndef ES_CORE_RESOURCES_ANIMATION_FRAME_CACHE_H
+#define ES_CORE_RESOURCES_ANIMATION_FRAME_CACHE_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class AnimationFrameCache
+{
+public:
+    using Frame = std::shared_ptr<const std::vector<uint8_t>>;
+    // Decodes the frame to premultiplied BGRA pixels, the buffer has been sized to the frame
+    // size beforehand. This is always called from the decoding thread.
+    using FrameDecoder = std::function<bool(int frameNum, std::vector<uint8_t>& pixels)>;
+
+private:
+    // The mutex and the total cache size are shared with the sources, as components holding
+    // a source may be destroyed after the cache singleton during application shutdown.
+    struct SharedState {
+        std::mutex mutex;
+        size_t totalCacheSize {0};
+        size_t maxTotalCacheSize {0};
+    };
+
+public:
+    class Source : public std::enable_shared_from_this<Source>
+    {
+    public:
+        ~Source();
+
+        // Returns nullptr if the frame has not been decoded yet, in which case decoding of
+        // this frame and the ones following it in the playback direction is scheduled.
+        Frame getFrame(int frameNum, bool reverse);
+
+        int getTotalFrames() const { return mTotalFrames; }
+        size_t getFrameSize() const { return mFrameSize; }
+
+    private:
+        friend class AnimationFrameCache;
+
+        Source(const std::shared_ptr<SharedState>& state,
+               const std::string& key,
+               int totalFrames,
+               size_t frameSize);
+
+        // Returns the next frame within the decode-ahead window that has not been decoded,
+        // or -1 if there is none.
+        int getNextFrameToDecode() const;
+        // Releases frames outside the decode-ahead window until within the cache limits.
+        void evictFrames();
+
+        std::shared_ptr<SharedState> mState;
+        std::string mKey;
+        FrameDecoder mDecoder;
+        std::vector<Frame> mFrames;
+        int mTotalFrames;
+        size_t mFrameSize;
+        size_t mCacheSize;
+        size_t mMaxCacheSize;
+        int mPlaybackPosition;
+        bool mReverse;
+        bool mQueued;
+        bool mDecodeFailed;
+    };
+
+    static AnimationFrameCache& getInstance();
+
+    // Returns the source for the key if there is one, otherwise a new source is created which
+    // will decode its frames using the decoder returned by createDecoder.
+    std::shared_ptr<Source> getSource(const std::string& key,
+                                      int totalFrames,
+                                      size_t frameSize,
+                                      const std::function<FrameDecoder()>& createDecoder);
+
+private:
+    AnimationFrameCache();
+    ~AnimationFrameCache();
+
+    void queueSource(const std::shared_ptr<Source>& source);
+    void decodingThread();
+
+    std::shared_ptr<SharedState> mState;
+    std::unordered_map<std::string, std::weak_ptr<Source>> mSources;
+    std::deque<std::weak_ptr<Source>> mQueue;
+    std::condition_variable mQueueCondition;
+    std::unique_ptr<std::thread> mDecodingThread;
+    bool mExit;
+};
+
+#endif // ES_CORE_RESOURCES_ANIMATION_FRAME_CACHE_H
@@ -0,0 +1,88 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  FrameBufferPool.cpp
+//
+//  Pool of recycled pixel buffers, used by the video player to avoid allocating new
+//  memory for every decoded frame. Buffers are grouped by size class and are shared
+//  between the frame processing threads and the main thread.
+//
+
+#include "resources/FrameBufferPool.h"
+
+namespace
+{
+    // Buffer sizes are rounded up to a multiple of this value so that frames with slightly
+    // different sizes can share buffers.
+    const size_t sizeClassGranularity {64 * 1024};
+    // Buffers beyond this total size are freed instead of being kept in the pool.
+    const size_t maxPooledBytes {128 * 1024 * 1024};
+} // namespace
+
+FrameBufferPool::FrameBufferPool()
+    : mPooledBytes {0}
+    , mHits {0}
+    , mMisses {0}
+{
+}
+
+FrameBufferPool& FrameBufferPool::getInstance()
+{
+    static FrameBufferPool instance;
+    return instance;
+}
+
+std::vector<uint8_t> FrameBufferPool::acquire(const size_t size)
+{
+    const size_t sizeClass {(size + sizeClassGranularity - 1) / sizeClassGranularity *
+                            sizeClassGranularity};
+    std::vector<uint8_t> buffer;
+
+    std::unique_lock<std::mutex> lock {mMutex};
+    auto buffersIt = mBuffers.find(sizeClass);
+
+    if (buffersIt != mBuffers.end() && !buffersIt->second.empty()) {
+        buffer.swap(buffersIt->second.back());
+        buffersIt->second.pop_back();
+        mPooledBytes -= buffer.capacity();
+        ++mHits;
+        return buffer;
+    }
+
+    ++mMisses;
+    lock.unlock();
+
+    buffer.reserve(sizeClass);
+    return buffer;
+}
+
+void FrameBufferPool::release(std::vector<uint8_t>& buffer)
+{
+    // Round down so that every buffer in a size class has at least that capacity.
+    const size_t sizeClass {buffer.capacity() / sizeClassGranularity * sizeClassGranularity};
+
+    if (sizeClass == 0) {
+        std::vector<uint8_t>().swap(buffer);
+        return;
+    }
+
+    buffer.clear();
+
+    std::unique_lock<std::mutex> lock {mMutex};
+
+    if (mPooledBytes + buffer.capacity() > maxPooledBytes) {
+        lock.unlock();
+        std::vector<uint8_t>().swap(buffer);
+        return;
+    }
+
+    mPooledBytes += buffer.capacity();
+    mBuffers[sizeClass].emplace_back(std::move(buffer));
+    buffer = std::vector<uint8_t>();
+}
+
+FrameBufferPool::Statistics FrameBufferPool::getStatistics()
+{
+    std::unique_lock<std::mutex> lock {mMutex};
+    return Statistics {mHits, mMisses, mPooledBytes};
+}
@@ -0,0 +1,47 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  FrameBufferPool.h
+//
+//  Pool of recycled pixel buffers, used by the video player to avoid allocating new
+//  memory for every decoded frame. Buffers are grouped by size class and are shared
+//  between the frame processing threads and the main thread.
+//
+
+#ifndef ES_CORE_RESOURCES_FRAME_BUFFER_POOL_H
+#define ES_CORE_RESOURCES_FRAME_BUFFER_POOL_H
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class FrameBufferPool
+{
+public:
+    struct Statistics {
+        unsigned int hits;
+        unsigned int misses;
+        size_t pooledBytes;
+    };
+
+    static FrameBufferPool& getInstance();
+
+    // Returns an empty buffer with a capacity of at least size bytes.
+    std::vector<uint8_t> acquire(const size_t size);
+    // Returns the buffer to the pool, after which it will be empty.
+    void release(std::vector<uint8_t>& buffer);
+
+    Statistics getStatistics();
+
+private:
+    FrameBufferPool();
+
+    std::unordered_map<size_t, std::vector<std::vector<uint8_t>>> mBuffers;
+    std::mutex mMutex;
+    size_t mPooledBytes;
+    unsigned int mHits;
+    unsigned int mMisses;
+};
+
+#endif // ES_CORE_RESOURCES_FRAME_BUFFER_POOL_H
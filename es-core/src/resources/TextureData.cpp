@@ -11,6 +11,7 @@
 #include "ImageIO.h"
 #include "Log.h"
 #include "resources/ResourceManager.h"
+#include "resources/TextureDiskCache.h"
 #include "utils/StringUtil.h"
 
 #include "lunasvg.h"
@@ -150,7 +151,13 @@ bool TextureData::initImageFromMemory(const unsigned char* fileData, size_t leng
     mSourceHeight = static_cast<float>(height);
     mScalable = false;
 
-    return initFromRGBA(imageRGBA.data(), width, height);
+    const bool result {initFromRGBA(imageRGBA.data(), width, height)};
+
+    // The image is written to the disk cache in the background.
+    if (!mPath.empty())
+        TextureDiskCache::getInstance().write(mPath, std::move(imageRGBA), width, height);
+
+    return result;
 }
 
 bool TextureData::initFromRGBA(const unsigned char* dataRGBA, size_t width, size_t height)
@@ -171,6 +178,40 @@ bool TextureData::initFromRGBA(const unsigned char* dataRGBA, size_t width, size
     return true;
 }
 
+void TextureData::initFromTexture(const unsigned int textureID, size_t width, size_t height)
+{
+    std::unique_lock<std::mutex> lock {mMutex};
+    mTextureID = textureID;
+    mWidth = static_cast<int>(width);
+    mHeight = static_cast<int>(height);
+}
+
+bool TextureData::initFromTextureData(TextureData& source)
+{
+    std::vector<unsigned char> dataRGBA;
+    {
+        std::unique_lock<std::mutex> lock {source.mMutex};
+        if (source.mScalable || !source.mHasRGBAData || source.mDataRGBA.empty())
+            return false;
+        dataRGBA.swap(source.mDataRGBA);
+        source.mHasRGBAData = false;
+    }
+
+    std::unique_lock<std::mutex> lock {mMutex};
+    if (!mDataRGBA.empty())
+        return true;
+
+    mDataRGBA.swap(dataRGBA);
+    mWidth = static_cast<int>(source.mWidth);
+    mHeight = static_cast<int>(source.mHeight);
+    mSourceWidth = static_cast<float>(source.mSourceWidth);
+    mSourceHeight = static_cast<float>(source.mSourceHeight);
+    mScalable = false;
+    mHasRGBAData = true;
+
+    return true;
+}
+
 bool TextureData::load()
 {
     if (mInvalidSVGFile)
@@ -180,15 +221,31 @@ bool TextureData::load()
 
     // Need to load. See if there is a file.
     if (!mPath.empty()) {
-        const ResourceData& data = ResourceManager::getInstance().getFileData(mPath);
         // Is it an SVG?
         if (Utils::String::toLower(mPath.substr(mPath.size() - 4, std::string::npos)) == ".svg") {
+            const ResourceData& data = ResourceManager::getInstance().getFileData(mPath);
             mScalable = true;
             std::string dataString;
             dataString.assign(std::string(reinterpret_cast<char*>(data.ptr.get()), data.length));
             retval = initSVGFromMemory(dataString);
         }
         else {
+            {
+                std::unique_lock<std::mutex> lock {mMutex};
+                if (!mDataRGBA.empty())
+                    return true;
+            }
+            // Use the previously decoded image if it's available in the disk cache.
+            std::vector<unsigned char> imageRGBA;
+            size_t width {0};
+            size_t height {0};
+            if (TextureDiskCache::getInstance().read(mPath, imageRGBA, width, height)) {
+                mSourceWidth = static_cast<float>(width);
+                mSourceHeight = static_cast<float>(height);
+                mScalable = false;
+                return initFromRGBA(imageRGBA.data(), width, height);
+            }
+            const ResourceData& data = ResourceManager::getInstance().getFileData(mPath);
             retval =
                 initImageFromMemory(static_cast<const unsigned char*>(data.ptr.get()), data.length);
         }
@@ -33,6 +33,10 @@ public:
     bool initSVGFromMemory(const std::string& fileData);
     bool initImageFromMemory(const unsigned char* fileData, size_t length);
     bool initFromRGBA(const unsigned char* dataRGBA, size_t width, size_t height);
+    // Takes over the decoded data from a raster texture that was loaded from the same path.
+    bool initFromTextureData(TextureData& source);
+    // Takes ownership of a texture that already exists in VRAM, no RAM copy is kept.
+    void initFromTexture(const unsigned int textureID, size_t width, size_t height);
 
     // Read the data into memory if necessary.
     bool load();
@@ -12,6 +12,22 @@
 #include "Settings.h"
 #include "resources/TextureData.h"
 #include "resources/TextureResource.h"
+#include "utils/FileSystemUtil.h"
+#include "utils/StringUtil.h"
+
+#include <algorithm>
+
+namespace
+{
+    // Visible textures which have not been requested for this long are not loaded.
+    constexpr std::chrono::milliseconds visibleTextureTimeout {250};
+
+    // The oldest prefetched images are dropped if they have not been used by the time this
+    // many newer images have been prefetched, or if the decoded images use more than this
+    // share of the MaxVRAM setting. They are also counted against MaxVRAM in full.
+    constexpr size_t maxPrefetchedTextures {64};
+    constexpr size_t maxPrefetchedVRAMDivisor {4};
+} // namespace
 
 TextureDataManager::TextureDataManager()
 {
@@ -45,7 +61,7 @@ void TextureDataManager::remove(const TextureResource* key)
     }
 }
 
-std::shared_ptr<TextureData> TextureDataManager::get(const TextureResource* key)
+std::shared_ptr<TextureData> TextureDataManager::get(const TextureResource* key, bool visible)
 {
     // If it's in the cache then we want to remove it from it's current location and
     // move it to the top.
@@ -61,14 +77,14 @@ std::shared_ptr<TextureData> TextureDataManager::get(const TextureResource* key)
         mTextureLookup[key] = mTextures.cbegin();
 
         // Make sure it's loaded or queued for loading.
-        load(tex);
+        load(tex, false, visible);
     }
     return tex;
 }
 
 bool TextureDataManager::bind(const TextureResource* key, const unsigned int texUnit)
 {
-    std::shared_ptr<TextureData> tex {get(key)};
+    std::shared_ptr<TextureData> tex {get(key, true)};
     bool bound {false};
     if (tex != nullptr)
         bound = tex->uploadAndBind(texUnit);
@@ -99,7 +115,21 @@ size_t TextureDataManager::getQueueSize()
     return mLoader->getQueueSize();
 }
 
-void TextureDataManager::load(std::shared_ptr<TextureData> tex, bool block)
+size_t TextureDataManager::getPrefetchedSize()
+{
+    std::unique_lock<std::mutex> lock {mPrefetchMutex};
+    return getPrefetchedSizeLocked();
+}
+
+size_t TextureDataManager::getPrefetchedSizeLocked()
+{
+    size_t total {0};
+    for (auto& prefetched : mPrefetched)
+        total += prefetched.second->getVRAMUsage();
+    return total;
+}
+
+void TextureDataManager::load(std::shared_ptr<TextureData> tex, bool block, bool visible)
 {
     // See if it's already loaded.
     if (tex->isLoaded())
@@ -135,31 +165,161 @@ void TextureDataManager::load(std::shared_ptr<TextureData> tex, bool block)
     }
 
     if (!block)
-        mLoader->load(tex);
+        mLoader->load(tex, visible);
     else
         tex->load();
 }
 
+void TextureDataManager::prefetch(const std::string& path)
+{
+    if (path.empty() || path.front() == ':' ||
+        Utils::String::toLower(Utils::FileSystem::getExtension(path)) == ".svg")
+        return;
+
+    const size_t maxPrefetchedSize {
+        static_cast<size_t>(std::max(Settings::getInstance()->getInt("MaxVRAM"), 0)) * 1024 *
+        1024 / maxPrefetchedVRAMDivisor};
+
+    std::vector<std::shared_ptr<TextureData>> dropped;
+    std::shared_ptr<TextureData> tex;
+    {
+        std::unique_lock<std::mutex> lock {mPrefetchMutex};
+        if (mPrefetched.find(path) != mPrefetched.cend())
+            return;
+
+        size_t prefetchedSize {getPrefetchedSizeLocked()};
+        while (!mPrefetchOrder.empty() && (mPrefetchOrder.size() >= maxPrefetchedTextures ||
+                                           prefetchedSize > maxPrefetchedSize)) {
+            auto it = mPrefetched.find(mPrefetchOrder.front());
+            if (it != mPrefetched.end()) {
+                prefetchedSize -= std::min(prefetchedSize, it->second->getVRAMUsage());
+                dropped.emplace_back(it->second);
+                mPrefetched.erase(it);
+            }
+            mPrefetchOrder.pop_front();
+        }
+
+        tex = std::make_shared<TextureData>(false);
+        tex->initFromPath(path);
+        mPrefetched[path] = tex;
+        mPrefetchOrder.emplace_back(path);
+    }
+
+    for (auto& droppedTex : dropped)
+        mLoader->remove(droppedTex);
+
+    mLoader->load(tex, false);
+}
+
+void TextureDataManager::cancelPrefetch(const std::string& path)
+{
+    std::shared_ptr<TextureData> tex;
+    {
+        std::unique_lock<std::mutex> lock {mPrefetchMutex};
+        auto it = mPrefetched.find(path);
+        if (it == mPrefetched.end())
+            return;
+        tex = it->second;
+        mPrefetched.erase(it);
+        mPrefetchOrder.remove(path);
+    }
+
+    mLoader->remove(tex);
+}
+
+bool TextureDataManager::usePrefetched(std::shared_ptr<TextureData> tex)
+{
+    std::shared_ptr<TextureData> prefetched;
+    {
+        std::unique_lock<std::mutex> lock {mPrefetchMutex};
+        if (mPrefetched.empty())
+            return false;
+        auto it = mPrefetched.find(tex->getTextureFilePath());
+        if (it == mPrefetched.end())
+            return false;
+        prefetched = it->second;
+        mPrefetched.erase(it);
+        mPrefetchOrder.remove(tex->getTextureFilePath());
+    }
+
+    // If the image has not been decoded yet then it's loaded as a regular texture instead.
+    if (!prefetched->isLoaded()) {
+        mLoader->remove(prefetched);
+        return false;
+    }
+
+    return tex->initFromTextureData(*prefetched);
+}
+
 TextureLoader::TextureLoader()
-    : mExit(false)
+    : mExit {false}
+    , mDecodedCount {0}
+    , mCancelledCount {0}
+    , mDecodeTime {0}
 {
-    mThread = std::make_unique<std::thread>(&TextureLoader::threadProc, this);
+    // The worker threads are started on the first load request as the settings have not
+    // been read yet when this object is created.
 }
 
 TextureLoader::~TextureLoader()
 {
     // Just abort any waiting texture.
-    std::unique_lock<std::mutex> lock(mMutex);
+    std::unique_lock<std::mutex> lock {mMutex};
+    mVisibleQ.clear();
     mTextureDataQ.clear();
     mTextureDataLookup.clear();
+    // Exit the threads.
+    mExit = true;
     lock.unlock();
 
-    // Exit the thread.
-    mExit = true;
+    mEvent.notify_all();
+    for (auto& thread : mThreads)
+        thread.join();
+}
 
-    mEvent.notify_one();
-    mThread->join();
-    mThread.reset();
+void TextureLoader::startThreads()
+{
+    const int threadSetting {glm::clamp(Settings::getInstance()->getInt("TextureLoaderThreads"),
+                                        0, 16)};
+    unsigned int threadCount {static_cast<unsigned int>(threadSetting)};
+
+    // Use half the CPU cores by default as the main thread and the video player threads
+    // also need to run.
+    if (threadCount == 0)
+        threadCount = glm::clamp(std::thread::hardware_concurrency() / 2, 1u, 8u);
+
+    LOG(LogDebug) << "TextureLoader::startThreads(): Starting " << threadCount
+                  << " texture loader thread" << (threadCount == 1 ? "" : "s");
+
+    for (unsigned int i {0}; i < threadCount; ++i)
+        mThreads.emplace_back(&TextureLoader::threadProc, this);
+}
+
+std::shared_ptr<TextureData> TextureLoader::getNextTexture()
+{
+    // This function must be called with the mutex locked.
+    const auto currentTime = std::chrono::steady_clock::now();
+
+    while (!mVisibleQ.empty()) {
+        QueueEntry entry {mVisibleQ.front()};
+        mVisibleQ.pop_front();
+        mTextureDataLookup.erase(entry.textureData.get());
+        // If the texture has not been requested recently then it's no longer visible.
+        if (currentTime - entry.requestTime > visibleTextureTimeout) {
+            ++mCancelledCount;
+            continue;
+        }
+        return entry.textureData;
+    }
+
+    if (!mTextureDataQ.empty()) {
+        std::shared_ptr<TextureData> textureData {mTextureDataQ.front().textureData};
+        mTextureDataQ.pop_front();
+        mTextureDataLookup.erase(textureData.get());
+        return textureData;
+    }
+
+    return nullptr;
 }
 
 void TextureLoader::threadProc()
@@ -169,46 +329,67 @@ void TextureLoader::threadProc()
         {
             // Wait for an event to say there is something in the queue.
             std::unique_lock<std::mutex> lock {mMutex};
-            mEvent.wait(lock);
-            if (!mTextureDataQ.empty()) {
-                textureData = mTextureDataQ.front();
-                mTextureDataQ.pop_front();
-                mTextureDataLookup.erase(mTextureDataLookup.find(textureData.get()));
-            }
+            mEvent.wait(lock, [this] {
+                return mExit || !mVisibleQ.empty() || !mTextureDataQ.empty();
+            });
+            if (mExit)
+                break;
+            textureData = getNextTexture();
+            if (!textureData)
+                continue;
+            mLoadingTextures.insert(textureData.get());
         }
-        // Queue has been released here but we might have a texture to process.
-        while (!mExit && textureData) {
-            textureData->load();
 
-            // See if there is another item in the queue.
-            textureData = nullptr;
-            std::unique_lock<std::mutex> lock {mMutex};
-            if (!mTextureDataQ.empty()) {
-                textureData = mTextureDataQ.front();
-                mTextureDataQ.pop_front();
-                mTextureDataLookup.erase(mTextureDataLookup.find(textureData.get()));
-            }
-        }
+        const auto startTime = std::chrono::steady_clock::now();
+        textureData->load();
+        const long long decodeTime {std::chrono::duration_cast<std::chrono::microseconds>(
+                                        std::chrono::steady_clock::now() - startTime)
+                                        .count()};
+
+        std::unique_lock<std::mutex> lock {mMutex};
+        mLoadingTextures.erase(textureData.get());
+        ++mDecodedCount;
+        mDecodeTime += decodeTime;
     }
 }
 
-void TextureLoader::load(std::shared_ptr<TextureData> textureData)
+void TextureLoader::load(std::shared_ptr<TextureData> textureData, bool visible)
 {
     // Make sure it's not already loaded.
-    if (!textureData->isLoaded()) {
-        std::unique_lock<std::mutex> lock {mMutex};
-        // Remove it from the queue if it is already there.
-        auto td = mTextureDataLookup.find(textureData.get());
-        if (td != mTextureDataLookup.cend()) {
-            mTextureDataQ.erase((*td).second);
-            mTextureDataLookup.erase(td);
-        }
+    if (textureData->isLoaded())
+        return;
+
+    std::unique_lock<std::mutex> lock {mMutex};
 
-        // Put it on the start of the queue as we want the newly requested textures to load first.
-        mTextureDataQ.push_front(textureData);
-        mTextureDataLookup[textureData.get()] = mTextureDataQ.cbegin();
-        mEvent.notify_one();
+    if (mThreads.empty())
+        startThreads();
+
+    // Don't queue it if it's currently being loaded by one of the worker threads.
+    if (mLoadingTextures.find(textureData.get()) != mLoadingTextures.cend())
+        return;
+
+    QueueEntry entry {textureData, std::chrono::steady_clock::now(), visible};
+
+    // Remove it from the queue if it is already there. Textures that have been requested
+    // for rendering keep their priority even if subsequently requested from elsewhere.
+    auto td = mTextureDataLookup.find(textureData.get());
+    if (td != mTextureDataLookup.cend()) {
+        if ((*td).second->visible && !visible) {
+            entry.requestTime = (*td).second->requestTime;
+            entry.visible = true;
+        }
+        if ((*td).second->visible)
+            mVisibleQ.erase((*td).second);
+        else
+            mTextureDataQ.erase((*td).second);
+        mTextureDataLookup.erase(td);
     }
+
+    // Put it on the start of the queue as we want the newly requested textures to load first.
+    std::list<QueueEntry>& queue {entry.visible ? mVisibleQ : mTextureDataQ};
+    queue.push_front(entry);
+    mTextureDataLookup[textureData.get()] = queue.begin();
+    mEvent.notify_one();
 }
 
 void TextureLoader::remove(std::shared_ptr<TextureData> textureData)
@@ -217,7 +398,10 @@ void TextureLoader::remove(std::shared_ptr<TextureData> textureData)
     std::unique_lock<std::mutex> lock {mMutex};
     auto td = mTextureDataLookup.find(textureData.get());
     if (td != mTextureDataLookup.cend()) {
-        mTextureDataQ.erase((*td).second);
+        if ((*td).second->visible)
+            mVisibleQ.erase((*td).second);
+        else
+            mTextureDataQ.erase((*td).second);
         mTextureDataLookup.erase(td);
     }
 }
@@ -228,8 +412,34 @@ size_t TextureLoader::getQueueSize()
     // the queue are loaded.
     size_t mem {0};
     std::unique_lock<std::mutex> lock {mMutex};
-    for (auto tex : mTextureDataQ)
-        mem += tex->width() * tex->height() * 4;
+    for (auto& entry : mVisibleQ)
+        mem += entry.textureData->width() * entry.textureData->height() * 4;
+    for (auto& entry : mTextureDataQ)
+        mem += entry.textureData->width() * entry.textureData->height() * 4;
 
     return mem;
 }
+
+bool TextureLoader::isLoading()
+{
+    std::unique_lock<std::mutex> lock {mMutex};
+    return !mVisibleQ.empty() || !mLoadingTextures.empty();
+}
+
+TextureLoader::Statistics TextureLoader::getStatistics()
+{
+    std::unique_lock<std::mutex> lock {mMutex};
+    Statistics statistics {};
+    statistics.queueDepth = mVisibleQ.size() + mTextureDataQ.size();
+    statistics.decodedCount = mDecodedCount;
+    statistics.cancelledCount = mCancelledCount;
+    if (mDecodedCount > 0)
+        statistics.averageDecodeTime =
+            static_cast<float>(mDecodeTime) / static_cast<float>(mDecodedCount) / 1000.0f;
+
+    mDecodedCount = 0;
+    mCancelledCount = 0;
+    mDecodeTime = 0;
+
+    return statistics;
+}
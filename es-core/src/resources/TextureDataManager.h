@@ -10,40 +10,69 @@
 #define ES_CORE_RESOURCES_TEXTURE_DATA_MANAGER_H
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <list>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <thread>
+#include <vector>
 
 class TextureData;
 class TextureResource;
 
+// Decodes textures using a pool of worker threads. Textures that are requested for rendering
+// are loaded before any other textures, and if they are not requested again within a short
+// time (i.e. they are no longer visible) they are dropped from the queue.
 class TextureLoader
 {
 public:
+    struct Statistics {
+        size_t queueDepth;
+        unsigned int decodedCount;
+        unsigned int cancelledCount;
+        float averageDecodeTime; // In milliseconds.
+    };
+
     TextureLoader();
     ~TextureLoader();
 
-    void load(std::shared_ptr<TextureData> textureData);
+    void load(std::shared_ptr<TextureData> textureData, bool visible);
     void remove(std::shared_ptr<TextureData> textureData);
 
     void setExit() { mExit = true; }
     size_t getQueueSize();
+    // Returns true if any textures that are about to be rendered are queued or being loaded.
+    bool isLoading();
+    // Returns the statistics since the previous call to this function.
+    Statistics getStatistics();
 
 private:
-    void processQueue();
+    struct QueueEntry {
+        std::shared_ptr<TextureData> textureData;
+        std::chrono::steady_clock::time_point requestTime;
+        bool visible;
+    };
+
+    void startThreads();
+    std::shared_ptr<TextureData> getNextTexture();
     void threadProc();
 
-    std::list<std::shared_ptr<TextureData>> mTextureDataQ;
-    std::map<TextureData*, std::list<std::shared_ptr<TextureData>>::const_iterator>
-        mTextureDataLookup;
+    std::list<QueueEntry> mVisibleQ;
+    std::list<QueueEntry> mTextureDataQ;
+    std::map<TextureData*, std::list<QueueEntry>::iterator> mTextureDataLookup;
+    std::set<TextureData*> mLoadingTextures;
 
-    std::unique_ptr<std::thread> mThread;
+    std::vector<std::thread> mThreads;
     std::mutex mMutex;
     std::condition_variable mEvent;
     std::atomic<bool> mExit;
+
+    unsigned int mDecodedCount;
+    unsigned int mCancelledCount;
+    long long mDecodeTime;
 };
 
 //
@@ -72,7 +101,9 @@ public:
     // will be deleted when the other thread has finished with it.
     void remove(const TextureResource* key);
 
-    std::shared_ptr<TextureData> get(const TextureResource* key);
+    // If visible is set then the texture is about to be rendered, which gives it priority
+    // in the loader queue if it's not already loaded.
+    std::shared_ptr<TextureData> get(const TextureResource* key, bool visible = false);
     bool bind(const TextureResource* key, const unsigned int texUnit);
 
     // Get the total size of all textures managed by this object, loaded and unloaded in bytes.
@@ -82,8 +113,21 @@ public:
     // Get the total size of all load-pending textures in the queue - these will
     // be committed to VRAM as the queue is processed.
     size_t getQueueSize();
+    // Get the total size of all decoded prefetched images that have not been used yet.
+    size_t getPrefetchedSize();
     // Load a texture, freeing resources as necessary to make space.
-    void load(std::shared_ptr<TextureData> tex, bool block = false);
+    void load(std::shared_ptr<TextureData> tex, bool block = false, bool visible = false);
+    TextureLoader::Statistics getLoaderStatistics() { return mLoader->getStatistics(); }
+    bool isLoading() { return mLoader->isLoading(); }
+
+    // Decodes a raster image in the background ahead of time, so that a texture which is
+    // created for the same path shortly afterwards does not need to be decoded when created.
+    void prefetch(const std::string& path);
+    // Drops a prefetched image, and removes it from the loader queue if not yet decoded.
+    void cancelPrefetch(const std::string& path);
+    // Moves the data of a finished prefetch into the texture. Returns false if there was no
+    // prefetch for the path or if it has not finished decoding yet.
+    bool usePrefetched(std::shared_ptr<TextureData> tex);
     // Make sure that threadProc() does not continue to run during application shutdown.
     void setExit()
     {
@@ -97,6 +141,13 @@ private:
         mTextureLookup;
     std::shared_ptr<TextureData> mBlank;
     std::unique_ptr<TextureLoader> mLoader;
+
+    // Returns the size of the decoded prefetched images, mPrefetchMutex must be held.
+    size_t getPrefetchedSizeLocked();
+
+    std::map<std::string, std::shared_ptr<TextureData>> mPrefetched;
+    std::list<std::string> mPrefetchOrder;
+    std::mutex mPrefetchMutex;
 };
 
 #endif // ES_CORE_RESOURCES_TEXTURE_DATA_MANAGER_H
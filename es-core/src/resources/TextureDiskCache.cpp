@@ -0,0 +1,192 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  TextureDiskCache.cpp
+//
+//  On-disk cache of images, used by TextureData to avoid having to read and decode the
+//  original PNG and JPG files every time they are loaded. The images are stored as PNG
+//  files using fast compression, as uncompressed RGBA data would fill the cache after only
+//  a small number of entries. Entries are invalidated when the source file is modified and
+//  the least recently used entries are removed when the cache grows beyond its maximum size.
+//  Entries are written by a background thread so that the texture loader threads are not
+//  delayed by the disk writes.
+//
+
+#include "resources/TextureDiskCache.h"
+
+#include "ImageIO.h"
+#include "Log.h"
+#include "Settings.h"
+#include "utils/FileSystemUtil.h"
+#include "utils/MathUtil.h"
+
+namespace
+{
+    const std::string cacheFileMagic {"ESDETEXC"};
+    const unsigned int cacheFileVersion {3};
+
+    // Very large images are not cached as reading them is not faster than decoding them.
+    const size_t maxEntrySize {32 * 1024 * 1024};
+
+    // Images are not cached if the writer thread can't keep up and this much data is queued.
+    const size_t maxQueuedBytes {128 * 1024 * 1024};
+} // namespace
+
+TextureDiskCache::TextureDiskCache()
+    : mCacheDirectory {Utils::FileSystem::getAppDataDirectory() + "/cache/textures"}
+    , mDirectoryLimiter {mCacheDirectory}
+    , mQueuedBytes {0}
+    , mExit {false}
+{
+}
+
+TextureDiskCache::~TextureDiskCache()
+{
+    if (mWriterThread) {
+        {
+            std::unique_lock<std::mutex> lock {mMutex};
+            mExit = true;
+            mQueue.clear();
+        }
+        mQueueCondition.notify_one();
+        mWriterThread->join();
+        mWriterThread.reset();
+    }
+}
+
+TextureDiskCache& TextureDiskCache::getInstance()
+{
+    static TextureDiskCache instance;
+    return instance;
+}
+
+bool TextureDiskCache::read(const std::string& path,
+                            std::vector<unsigned char>& dataRGBA,
+                            size_t& width,
+                            size_t& height)
+{
+    // Resources bundled with the application are not worth caching.
+    if (getMaxCacheSize() == 0 || path.substr(0, 2) == ":/")
+        return false;
+
+    const std::string cachePath {Utils::CacheFile::getHashedPath(mCacheDirectory, path)};
+    Utils::CacheFile::Reader reader {cachePath, cacheFileMagic, cacheFileVersion};
+
+    const unsigned int imageWidth {reader.read<unsigned int>()};
+    const unsigned int imageHeight {reader.read<unsigned int>()};
+    const long long modTime {reader.read<long long>()};
+    const long long fileSize {reader.read<long long>()};
+
+    // Different paths could end up with the same file name if there is a hash collision.
+    if (!reader.isValid() || reader.readString() != path)
+        return false;
+
+    const size_t dataSize {static_cast<size_t>(imageWidth) * imageHeight * 4};
+    if (dataSize == 0 || dataSize > maxEntrySize)
+        return false;
+
+    if (modTime != Utils::FileSystem::getModificationTime(path) ||
+        fileSize != Utils::FileSystem::getFileSize(path))
+        return false;
+
+    const std::string pngData {reader.readString()};
+    if (!reader.isValid() || pngData.empty())
+        return false;
+
+    size_t pngWidth {0};
+    size_t pngHeight {0};
+    std::vector<unsigned char> pixels {
+        ImageIO::loadFromMemoryRGBA32(reinterpret_cast<const unsigned char*>(pngData.data()),
+                                      pngData.size(), pngWidth, pngHeight)};
+
+    if (pngWidth != imageWidth || pngHeight != imageHeight || pixels.size() != dataSize)
+        return false;
+
+    dataRGBA.swap(pixels);
+
+    width = imageWidth;
+    height = imageHeight;
+
+    // Mark the entry as recently used so it's not pruned before entries that are not used.
+    Utils::CacheFile::touchFile(cachePath);
+
+    return true;
+}
+
+void TextureDiskCache::write(const std::string& path,
+                             std::vector<unsigned char>&& dataRGBA,
+                             size_t width,
+                             size_t height)
+{
+    const long long maxCacheSize {getMaxCacheSize()};
+    if (maxCacheSize == 0 || path.substr(0, 2) == ":/" || dataRGBA.size() > maxEntrySize ||
+        dataRGBA.size() != width * height * 4)
+        return;
+
+    {
+        std::unique_lock<std::mutex> lock {mMutex};
+        if (mExit || mQueuedBytes + dataRGBA.size() > maxQueuedBytes)
+            return;
+
+        if (!mWriterThread)
+            mWriterThread =
+                std::make_unique<std::thread>(&TextureDiskCache::writerThread, this);
+
+        mQueuedBytes += dataRGBA.size();
+        mQueue.emplace_back(WriteJob {path, std::move(dataRGBA), width, height, maxCacheSize});
+    }
+    mQueueCondition.notify_one();
+}
+
+long long TextureDiskCache::getMaxCacheSize()
+{
+    const int cacheSize {
+        glm::clamp(Settings::getInstance()->getInt("TextureCacheSize"), 0, 16384)};
+    return static_cast<long long>(cacheSize) * 1024 * 1024;
+}
+
+void TextureDiskCache::writeFile(const WriteJob& job)
+{
+    const long long modTime {Utils::FileSystem::getModificationTime(job.path)};
+    if (modTime == -1)
+        return;
+
+    const std::vector<unsigned char> pngData {
+        ImageIO::saveToMemoryPNG(job.dataRGBA.data(), job.width, job.height)};
+    if (pngData.empty())
+        return;
+
+    const std::string cachePath {Utils::CacheFile::getHashedPath(mCacheDirectory, job.path)};
+    Utils::CacheFile::Writer writer {cachePath, cacheFileMagic, cacheFileVersion};
+
+    writer.write<unsigned int>(static_cast<unsigned int>(job.width));
+    writer.write<unsigned int>(static_cast<unsigned int>(job.height));
+    writer.write<long long>(modTime);
+    writer.write<long long>(Utils::FileSystem::getFileSize(job.path));
+    writer.writeString(job.path);
+    writer.writeString(std::string {pngData.cbegin(), pngData.cend()});
+
+    const long long fileSize {writer.commit()};
+    if (fileSize != -1)
+        mDirectoryLimiter.addFile(fileSize, job.maxCacheSize);
+}
+
+void TextureDiskCache::writerThread()
+{
+    while (true) {
+        WriteJob job;
+        {
+            std::unique_lock<std::mutex> lock {mMutex};
+            mQueueCondition.wait(lock, [this] { return mExit || !mQueue.empty(); });
+            if (mExit)
+                return;
+            job = std::move(mQueue.front());
+            mQueue.pop_front();
+        }
+
+        writeFile(job);
+
+        std::unique_lock<std::mutex> lock {mMutex};
+        mQueuedBytes -= job.dataRGBA.size();
+    }
+}
@@ -0,0 +1,72 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  TextureDiskCache.h
+//
+//  On-disk cache of images, used by TextureData to avoid having to read and decode the
+//  original PNG and JPG files every time they are loaded. The images are stored as PNG
+//  files using fast compression, as uncompressed RGBA data would fill the cache after only
+//  a small number of entries. Entries are invalidated when the source file is modified and
+//  the least recently used entries are removed when the cache grows beyond its maximum size.
+//  Entries are written by a background thread so that the texture loader threads are not
+//  delayed by the disk writes.
+//
+
+#ifndef ES_CORE_RESOURCES_TEXTURE_DISK_CACHE_H
+#define ES_CORE_RESOURCES_TEXTURE_DISK_CACHE_H
+
+#include "utils/CacheFileUtil.h"
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class TextureDiskCache
+{
+public:
+    static TextureDiskCache& getInstance();
+
+    // Returns false if the image is not cached or if the source file has been modified.
+    bool read(const std::string& path,
+              std::vector<unsigned char>& dataRGBA,
+              size_t& width,
+              size_t& height);
+
+    // Queues the image for writing, it's skipped if too much data is already queued.
+    void write(const std::string& path,
+               std::vector<unsigned char>&& dataRGBA,
+               size_t width,
+               size_t height);
+
+private:
+    struct WriteJob {
+        std::string path;
+        std::vector<unsigned char> dataRGBA;
+        size_t width;
+        size_t height;
+        long long maxCacheSize;
+    };
+
+    TextureDiskCache();
+    ~TextureDiskCache();
+
+    long long getMaxCacheSize();
+    void writeFile(const WriteJob& job);
+    void writerThread();
+
+    std::string mCacheDirectory;
+    Utils::CacheFile::DirectoryLimiter mDirectoryLimiter;
+
+    std::unique_ptr<std::thread> mWriterThread;
+    std::mutex mMutex;
+    std::condition_variable mQueueCondition;
+    std::deque<WriteJob> mQueue;
+    size_t mQueuedBytes;
+    bool mExit;
+};
+
+#endif // ES_CORE_RESOURCES_TEXTURE_DISK_CACHE_H
@@ -37,8 +37,10 @@ TextureResource::TextureResource(const std::string& path,
             data->setTileSize(tileWidth, tileHeight);
             data->setLinearMagnify(linearMagnify);
             data->setMipmapping(mipmapping);
-            // Force the texture manager to load it using a blocking load.
-            sTextureDataManager.load(data, true);
+            // Use the image data if it has already been decoded by a prefetch, otherwise force
+            // the texture manager to load it using a blocking load.
+            if (tile || scalable || !sTextureDataManager.usePrefetched(data))
+                sTextureDataManager.load(data, true);
             if (scalable)
                 mInvalidSVGFile = data->getIsInvalidSVGFile();
         }
@@ -89,6 +91,18 @@ void TextureResource::initFromPixels(const unsigned char* dataRGBA, size_t width
     mSourceSize = glm::vec2 {static_cast<float>(width), static_cast<float>(height)};
 }
 
+void TextureResource::initFromTexture(const unsigned int textureID, size_t width, size_t height)
+{
+    // This is only valid if we have a local texture data object.
+    assert(mTextureData != nullptr);
+    mTextureData->releaseVRAM();
+    mTextureData->releaseRAM();
+    mTextureData->initFromTexture(textureID, width, height);
+    // Cache the image dimensions.
+    mSize = glm::ivec2 {static_cast<int>(width), static_cast<int>(height)};
+    mSourceSize = glm::vec2 {static_cast<float>(width), static_cast<float>(height)};
+}
+
 void TextureResource::initFromMemory(const char* data, size_t length)
 {
     // This is only valid if we have a local texture data object.
@@ -275,6 +289,8 @@ size_t TextureResource::getTotalMemUsage()
     total += sTextureDataManager.getCommittedSize();
     // And the size of the loading queue.
     total += sTextureDataManager.getQueueSize();
+    // And the prefetched images that are waiting to be used.
+    total += sTextureDataManager.getPrefetchedSize();
     return total;
 }
 
@@ -37,6 +37,7 @@ public:
                                                 float tileWidth = 0.0f,
                                                 float tileHeight = 0.0f);
     void initFromPixels(const unsigned char* dataRGBA, size_t width, size_t height);
+    void initFromTexture(const unsigned int textureID, size_t width, size_t height);
     virtual void initFromMemory(const char* data, size_t length);
     static void manualUnload(const std::string& path, bool tile);
     static void manualUnloadAll() { sTextureMap.clear(); }
@@ -79,9 +80,24 @@ public:
     static size_t getTotalMemUsage();
     // Returns the number of bytes that would be used if all textures were in memory.
     static size_t getTotalTextureSize();
+    // Returns the texture loader statistics since the previous call to this function.
+    static TextureLoader::Statistics getLoaderStatistics()
+    {
+        return sTextureDataManager.getLoaderStatistics();
+    }
+
+    // Returns true if any textures that are about to be rendered are still being loaded.
+    static bool isLoading() { return sTextureDataManager.isLoading(); }
 
     static void setExit() { sTextureDataManager.setExit(); }
 
+    // Decodes an image in the background so it's ready when a texture is created for it.
+    static void prefetch(const std::string& path) { sTextureDataManager.prefetch(path); }
+    static void cancelPrefetch(const std::string& path)
+    {
+        sTextureDataManager.cancelPrefetch(path);
+    }
+
 protected:
     TextureResource(const std::string& path,
                     float tileWidth,
@@ -0,0 +1,203 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  CacheFileUtil.cpp
+//
+//  Reading and writing of the binary cache and index files in the application data
+//  directory, and size limiting of cache directories.
+//  Each file starts with a magic string and a format version, and the version should be
+//  increased whenever the file format changes, which will discard old files.
+//
+
+#include "utils/CacheFileUtil.h"
+
+#include "Log.h"
+#include "utils/FileSystemUtil.h"
+#include "utils/StringUtil.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace Utils
+{
+    namespace CacheFile
+    {
+        Reader::Reader(const std::string& path, const std::string& magic, unsigned int version)
+            : mValid {false}
+        {
+#if defined(_WIN64)
+            mStream.open(Utils::String::stringToWideString(path).c_str(), std::ios::binary);
+#else
+            mStream.open(path, std::ios::binary);
+#endif
+            if (!mStream.good())
+                return;
+
+            std::string fileMagic(magic.size(), '\0');
+            mStream.read(&fileMagic[0], magic.size());
+            if (!mStream.good() || fileMagic != magic)
+                return;
+
+            mValid = true;
+            if (read<unsigned int>() != version)
+                mValid = false;
+        }
+
+        std::string Reader::readString()
+        {
+            const unsigned int length {read<unsigned int>()};
+            if (!mValid)
+                return "";
+
+            std::string value(length, '\0');
+            if (length > 0 && !readData(&value[0], length))
+                return "";
+
+            return value;
+        }
+
+        bool Reader::readData(char* data, size_t size)
+        {
+            if (!mValid)
+                return false;
+
+            mStream.read(data, size);
+            if (static_cast<size_t>(mStream.gcount()) != size) {
+                mValid = false;
+                return false;
+            }
+
+            return true;
+        }
+
+        Writer::Writer(const std::string& path, const std::string& magic, unsigned int version)
+            : mPath {path}
+            , mCommitted {false}
+        {
+            const std::string directory {Utils::FileSystem::getParent(mPath)};
+            if (!Utils::FileSystem::exists(directory) &&
+                !Utils::FileSystem::createDirectory(directory)) {
+                LOG(LogWarning) << "Couldn't create directory \"" << directory << "\"";
+                mStream.setstate(std::ios::failbit);
+                return;
+            }
+
+            // Several threads could write the same file simultaneously, so the temporary
+            // file name is unique per thread.
+            std::stringstream tempPath;
+            tempPath << mPath << ".tmp" << std::this_thread::get_id();
+            mTempPath = tempPath.str();
+
+#if defined(_WIN64)
+            mStream.open(Utils::String::stringToWideString(mTempPath).c_str(),
+                         std::ios::binary | std::ios::trunc);
+#else
+            mStream.open(mTempPath, std::ios::binary | std::ios::trunc);
+#endif
+            mStream.write(magic.data(), magic.size());
+            write<unsigned int>(version);
+        }
+
+        Writer::~Writer()
+        {
+            if (!mCommitted && !mTempPath.empty()) {
+                mStream.close();
+                Utils::FileSystem::removeFile(mTempPath);
+            }
+        }
+
+        void Writer::writeString(const std::string& value)
+        {
+            write<unsigned int>(static_cast<unsigned int>(value.size()));
+            mStream.write(value.data(), value.size());
+        }
+
+        void Writer::writeData(const char* data, size_t size) { mStream.write(data, size); }
+
+        long long Writer::commit()
+        {
+            if (mTempPath.empty() || !mStream.good())
+                return -1;
+
+            const long long size {static_cast<long long>(mStream.tellp())};
+            mStream.close();
+
+            if (mStream.fail() || Utils::FileSystem::renameFile(mTempPath, mPath, true))
+                return -1;
+
+            mCommitted = true;
+            return size;
+        }
+
+        DirectoryLimiter::DirectoryLimiter(const std::string& directory)
+            : mDirectory {directory}
+            , mSize {-1}
+        {
+        }
+
+        void DirectoryLimiter::addFile(long long fileSize, long long maxSize)
+        {
+            std::unique_lock<std::mutex> lock {mMutex};
+
+            if (mSize == -1) {
+                mSize = 0;
+                for (auto& file : Utils::FileSystem::getDirContent(mDirectory))
+                    mSize += Utils::FileSystem::getFileSize(file);
+            }
+            else {
+                mSize += fileSize;
+            }
+
+            if (mSize <= maxSize)
+                return;
+
+            // The least recently used files are removed until the directory is at three
+            // quarters of its maximum size.
+            std::vector<std::pair<long long, std::string>> files;
+            for (auto& file : Utils::FileSystem::getDirContent(mDirectory))
+                files.emplace_back(Utils::FileSystem::getModificationTime(file), file);
+
+            std::sort(files.begin(), files.end());
+
+            for (auto& file : files) {
+                if (mSize <= maxSize / 4 * 3)
+                    break;
+                const long size {Utils::FileSystem::getFileSize(file.second)};
+                if (!Utils::FileSystem::removeFile(file.second))
+                    continue;
+                mSize -= size;
+            }
+
+            LOG(LogDebug) << "CacheFile::DirectoryLimiter::addFile(): Size of \"" << mDirectory
+                          << "\" is now " << mSize / 1024 / 1024 << " MiB";
+        }
+
+        std::string getHashedPath(const std::string& directory,
+                                  const std::string& key,
+                                  const std::string& extension)
+        {
+            std::stringstream path;
+            path << directory << "/" << std::hex << std::hash<std::string> {}(key) << extension;
+            return path.str();
+        }
+
+        void touchFile(const std::string& path)
+        {
+            std::error_code errorCode;
+#if defined(_WIN64)
+            std::filesystem::last_write_time(Utils::String::stringToWideString(path),
+                                             std::filesystem::file_time_type::clock::now(),
+                                             errorCode);
+#else
+            std::filesystem::last_write_time(
+                path, std::filesystem::file_time_type::clock::now(), errorCode);
+#endif
+        }
+
+    } // namespace CacheFile
+
+} // namespace Utils
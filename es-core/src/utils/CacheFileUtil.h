@@ -0,0 +1,112 @@
+//  SPDX-License-Identifier: MIT
+//
+//  ES-DE
+//  CacheFileUtil.h
+//
+//  Reading and writing of the binary cache and index files in the application data
+//  directory, and size limiting of cache directories.
+//  Each file starts with a magic string and a format version, and the version should be
+//  increased whenever the file format changes, which will discard old files.
+//
+
+#ifndef ES_CORE_UTILS_CACHE_FILE_UTIL_H
+#define ES_CORE_UTILS_CACHE_FILE_UTIL_H
+
+#include <fstream>
+#include <mutex>
+#include <string>
+
+namespace Utils
+{
+    namespace CacheFile
+    {
+        class Reader
+        {
+        public:
+            // The reader is invalid if the file can't be opened or if the magic string or
+            // version doesn't match.
+            Reader(const std::string& path, const std::string& magic, unsigned int version);
+
+            // Reading past the end of the file makes the reader invalid, after which only
+            // default values are returned.
+            template <typename T> T read()
+            {
+                T value {};
+                if (!mValid)
+                    return value;
+                mStream.read(reinterpret_cast<char*>(&value), sizeof(T));
+                if (!mStream.good()) {
+                    mValid = false;
+                    return T {};
+                }
+                return value;
+            }
+
+            std::string readString();
+            bool readData(char* data, size_t size);
+
+            bool isValid() const { return mValid; }
+
+        private:
+            std::ifstream mStream;
+            bool mValid;
+        };
+
+        class Writer
+        {
+        public:
+            // The file is written to a temporary file which replaces the actual file when
+            // calling commit(), so a partially written file is never left behind. The parent
+            // directory is created if it doesn't exist.
+            Writer(const std::string& path, const std::string& magic, unsigned int version);
+            ~Writer();
+
+            template <typename T> void write(const T value)
+            {
+                mStream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+            }
+
+            void writeString(const std::string& value);
+            void writeData(const char* data, size_t size);
+
+            bool isValid() const { return mStream.good(); }
+            // Returns the number of bytes written, or -1 if the file couldn't be written.
+            long long commit();
+
+        private:
+            std::string mPath;
+            std::string mTempPath;
+            std::ofstream mStream;
+            bool mCommitted;
+        };
+
+        // Keeps track of the total size of a cache directory and removes the least recently
+        // used files when it grows beyond its maximum size. Readers should call touchFile()
+        // for any file they use so that it's not considered old.
+        class DirectoryLimiter
+        {
+        public:
+            DirectoryLimiter(const std::string& directory);
+
+            // The directory size is calculated the first time a file is added.
+            void addFile(long long fileSize, long long maxSize);
+
+        private:
+            std::string mDirectory;
+            std::mutex mMutex;
+            long long mSize;
+        };
+
+        // Returns a file name in the directory which is derived from the hash of the key.
+        // Different keys can end up with the same file name, so the key should be stored in
+        // the file and compared when reading it.
+        std::string getHashedPath(const std::string& directory,
+                                  const std::string& key,
+                                  const std::string& extension = ".bin");
+        void touchFile(const std::string& path);
+
+    } // namespace CacheFile
+
+} // namespace Utils
+
+#endif // ES_CORE_UTILS_CACHE_FILE_UTIL_H
@@ -640,6 +640,22 @@ namespace Utils
             }
         }
 
+        long long getModificationTime(const std::filesystem::path& path)
+        {
+            std::error_code errorCode;
+#if defined(_WIN64)
+            const std::filesystem::file_time_type modTime {std::filesystem::last_write_time(
+                Utils::String::stringToWideString(path.generic_string()), errorCode)};
+#else
+            const std::filesystem::file_time_type modTime {
+                std::filesystem::last_write_time(path, errorCode)};
+#endif
+            if (errorCode)
+                return -1;
+
+            return static_cast<long long>(modTime.time_since_epoch().count());
+        }
+
         std::string expandHomePath(const std::string& path)
         {
             // Expand home path if ~ is used.
@@ -52,6 +52,9 @@ namespace Utils
         std::string getStem(const std::string& path);
         std::string getExtension(const std::string& path);
         long getFileSize(const std::filesystem::path& path);
+        // The returned value is only meant for comparisons, i.e. to check whether a file or
+        // directory has been modified. Returns -1 if the modification time could not be read.
+        long long getModificationTime(const std::filesystem::path& path);
         std::string expandHomePath(const std::string& path);
         std::string resolveRelativePath(const std::string& path,
                                         const std::string& relativeTo,
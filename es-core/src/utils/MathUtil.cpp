@@ -150,6 +150,51 @@ namespace Utils
                           static_cast<unsigned int>(hashArg.length()), state, count, buffer);
             }
 
+            return md5Final(state, count, buffer);
+        }
+
+        void md5Update(const unsigned char input[],
+                       unsigned int length,
+                       unsigned int (&state)[4],
+                       unsigned int (&count)[2],
+                       unsigned char (&buffer)[64])
+        {
+            // Compute number of bytes (mod 64).
+            unsigned int index {count[0] / 8 % 64};
+
+            // Update number of bits.
+            if ((count[0] += (length << 3)) < (length << 3))
+                ++count[1];
+            count[1] += (length >> 29);
+
+            // Number of bytes we need to fill in buffer.
+            unsigned int firstpart {64 - index};
+
+            unsigned int i {0};
+            // Encodes unsigned int input into unsigned char output. Assumes len is a multiple of 4.
+            // Transform as many times as possible.
+            if (length >= firstpart) {
+                // Fill buffer first, then transform.
+                memcpy(&buffer[index], input, firstpart);
+                md5Transform(buffer, state);
+
+                // Transform chunks of 64 (64 bytes).
+                for (i = firstpart; i + 64 <= length; i += 64)
+                    md5Transform(&input[i], state);
+
+                index = 0;
+            }
+            else
+                i = 0;
+
+            // Buffer remaining input.
+            memcpy(&buffer[index], &input[i], length - i);
+        }
+
+        std::string md5Final(unsigned int (&state)[4],
+                             unsigned int (&count)[2],
+                             unsigned char (&buffer)[64])
+        {
             static unsigned char padding[64] {0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
                                               0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
                                               0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
@@ -193,44 +238,6 @@ namespace Utils
             return std::string(buf);
         }
 
-        void md5Update(const unsigned char input[],
-                       unsigned int length,
-                       unsigned int (&state)[4],
-                       unsigned int (&count)[2],
-                       unsigned char (&buffer)[64])
-        {
-            // Compute number of bytes (mod 64).
-            unsigned int index {count[0] / 8 % 64};
-
-            // Update number of bits.
-            if ((count[0] += (length << 3)) < (length << 3))
-                ++count[1];
-            count[1] += (length >> 29);
-
-            // Number of bytes we need to fill in buffer.
-            unsigned int firstpart {64 - index};
-
-            unsigned int i {0};
-            // Encodes unsigned int input into unsigned char output. Assumes len is a multiple of 4.
-            // Transform as many times as possible.
-            if (length >= firstpart) {
-                // Fill buffer first, then transform.
-                memcpy(&buffer[index], input, firstpart);
-                md5Transform(buffer, state);
-
-                // Transform chunks of 64 (64 bytes).
-                for (i = firstpart; i + 64 <= length; i += 64)
-                    md5Transform(&input[i], state);
-
-                index = 0;
-            }
-            else
-                i = 0;
-
-            // Buffer remaining input.
-            memcpy(&buffer[index], &input[i], length - i);
-        }
-
         void md5Transform(const unsigned char block[64], unsigned int (&state)[4])
         {
             unsigned int a {state[0]};
@@ -381,6 +388,140 @@ namespace Utils
             state[3] += d;
         }
 
+
+        unsigned int crc32Update(unsigned int crc, const unsigned char* buf, size_t length)
+        {
+            // Standard CRC-32 (ISO-HDLC) as used by ZIP files and the ROM databases. The table
+            // is generated on first use.
+            static const std::vector<unsigned int> table {[] {
+                std::vector<unsigned int> values(256);
+                for (unsigned int i {0}; i < 256; ++i) {
+                    unsigned int value {i};
+                    for (int j {0}; j < 8; ++j)
+                        value = (value & 1) ? (0xedb88320 ^ (value >> 1)) : (value >> 1);
+                    values[i] = value;
+                }
+                return values;
+            }()};
+
+            crc = ~crc;
+            for (size_t i {0}; i < length; ++i)
+                crc = table[(crc ^ buf[i]) & 0xff] ^ (crc >> 8);
+
+            return ~crc;
+        }
+
+        void sha1Init(unsigned int (&state)[5], unsigned long long& count)
+        {
+            state[0] = 0x67452301;
+            state[1] = 0xefcdab89;
+            state[2] = 0x98badcfe;
+            state[3] = 0x10325476;
+            state[4] = 0xc3d2e1f0;
+            count = 0;
+        }
+
+        void sha1Update(const unsigned char* buf,
+                        size_t length,
+                        unsigned int (&state)[5],
+                        unsigned long long& count,
+                        unsigned char (&buffer)[64])
+        {
+            size_t index {static_cast<size_t>(count % 64)};
+            count += length;
+
+            size_t i {0};
+            if (index + length >= 64) {
+                // Fill the buffer first, then transform the remaining complete blocks directly.
+                memcpy(&buffer[index], buf, 64 - index);
+                sha1Transform(buffer, state);
+                for (i = 64 - index; i + 64 <= length; i += 64)
+                    sha1Transform(&buf[i], state);
+                index = 0;
+            }
+
+            memcpy(&buffer[index], &buf[i], length - i);
+        }
+
+        std::string sha1Final(unsigned int (&state)[5],
+                              unsigned long long& count,
+                              unsigned char (&buffer)[64])
+        {
+            const unsigned long long bitCount {count * 8};
+
+            // Pad out to 56 mod 64 and append the big-endian message length in bits.
+            unsigned char padding[64] {0x80};
+            const size_t index {static_cast<size_t>(count % 64)};
+            sha1Update(padding, index < 56 ? 56 - index : 120 - index, state, count, buffer);
+
+            unsigned char bits[8];
+            for (int i {0}; i < 8; ++i)
+                bits[i] = static_cast<unsigned char>(bitCount >> (56 - i * 8));
+            sha1Update(bits, 8, state, count, buffer);
+
+            char buf[41];
+            for (int i {0}; i < 5; ++i)
+                snprintf(buf + i * 8, 9, "%08x", state[i]);
+            buf[40] = 0;
+
+            return std::string(buf);
+        }
+
+        void sha1Transform(const unsigned char block[64], unsigned int (&state)[5])
+        {
+            unsigned int w[80];
+
+            for (int i {0}; i < 16; ++i)
+                w[i] = (static_cast<unsigned int>(block[i * 4]) << 24) |
+                       (static_cast<unsigned int>(block[i * 4 + 1]) << 16) |
+                       (static_cast<unsigned int>(block[i * 4 + 2]) << 8) |
+                       (static_cast<unsigned int>(block[i * 4 + 3]));
+
+            auto rotateLeftFunc = [](unsigned int x, int n) { return (x << n) | (x >> (32 - n)); };
+
+            for (int i {16}; i < 80; ++i)
+                w[i] = rotateLeftFunc(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+            unsigned int a {state[0]};
+            unsigned int b {state[1]};
+            unsigned int c {state[2]};
+            unsigned int d {state[3]};
+            unsigned int e {state[4]};
+
+            for (int i {0}; i < 80; ++i) {
+                unsigned int f;
+                unsigned int k;
+                if (i < 20) {
+                    f = (b & c) | (~b & d);
+                    k = 0x5a827999;
+                }
+                else if (i < 40) {
+                    f = b ^ c ^ d;
+                    k = 0x6ed9eba1;
+                }
+                else if (i < 60) {
+                    f = (b & c) | (b & d) | (c & d);
+                    k = 0x8f1bbcdc;
+                }
+                else {
+                    f = b ^ c ^ d;
+                    k = 0xca62c1d6;
+                }
+                const unsigned int temp {rotateLeftFunc(a, 5) + f + e + k + w[i]};
+                e = d;
+                d = c;
+                c = rotateLeftFunc(b, 30);
+                b = a;
+                a = temp;
+            }
+
+            state[0] += a;
+            state[1] += b;
+            state[2] += c;
+            state[3] += d;
+            state[4] += e;
+        }
+
     } // namespace Math
 
 } // namespace Utils
@@ -42,8 +42,25 @@ namespace Utils
                        unsigned int (&state)[4],
                        unsigned int (&count)[2],
                        unsigned char (&buffer)[64]);
+        std::string md5Final(unsigned int (&state)[4],
+                             unsigned int (&count)[2],
+                             unsigned char (&buffer)[64]);
         void md5Transform(const unsigned char block[64], unsigned int (&state)[4]);
 
+        // CRC32 and SHA1 are used together with MD5 when hashing game files, so that all
+        // three digests can be calculated from a single pass over the file.
+        unsigned int crc32Update(unsigned int crc, const unsigned char* buf, size_t length);
+        void sha1Init(unsigned int (&state)[5], unsigned long long& count);
+        void sha1Update(const unsigned char* buf,
+                        size_t length,
+                        unsigned int (&state)[5],
+                        unsigned long long& count,
+                        unsigned char (&buffer)[64]);
+        std::string sha1Final(unsigned int (&state)[5],
+                              unsigned long long& count,
+                              unsigned char (&buffer)[64]);
+        void sha1Transform(const unsigned char block[64], unsigned int (&state)[5]);
+
     } // namespace Math
 
 } // namespace Utils
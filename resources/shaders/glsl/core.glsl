@@ -49,6 +49,7 @@ uniform uint shaderFlags;
 
 uniform sampler2D textureSampler0;
 uniform sampler2D textureSampler1;
+uniform sampler2D textureSampler2;
 out vec4 FragColor;
 
 // shaderFlags:
@@ -60,6 +61,7 @@ out vec4 FragColor;
 // 0x00000020 - Rounded corners
 // 0x00000040 - Rounded corners with no anti-aliasing
 // 0x00000080 - Convert pixel format
+// 0x00000100 - YUV planes
 
 void main()
 {
@@ -84,6 +86,16 @@ void main()
     else
         sampledColor = texture(textureSampler0, texCoord);
 
+    // Video frames with separate Y, U and V planes, converted using the BT.601 coefficients.
+    if (0x0u != (shaderFlags & 0x100u)) {
+        float y = 1.164 * (sampledColor.r - 0.0625);
+        float u = texture(textureSampler1, texCoord).r - 0.5;
+        float v = texture(textureSampler2, texCoord).r - 0.5;
+        sampledColor = vec4(clamp(vec3(y + 1.596 * v, y - 0.391 * u - 0.813 * v, y + 2.018 * u),
+                                  0.0, 1.0),
+                            1.0);
+    }
+
     // Rounded corners.
     if (0x0u != (shaderFlags & 0x20u) || 0x0u != (shaderFlags & 0x40u)) {
         float cornerRadiusClamped = cornerRadius;
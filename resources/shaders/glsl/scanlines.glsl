@@ -62,6 +62,8 @@ uniform float brightness;
 uniform float saturation;
 uniform uint shaderFlags;
 uniform sampler2D textureSampler0;
+uniform sampler2D textureSampler1;
+uniform sampler2D textureSampler2;
 in vec2 texCoord;
 in vec2 onex;
 in vec2 oney;
@@ -85,7 +87,7 @@ uniform float OutputGamma;
 #define GAMMA_IN(color) pow(color, vec4(InputGamma))
 #define GAMMA_OUT(color) pow(color, vec4(1.0 / OutputGamma))
 
-#define TEX2D(coords) GAMMA_IN(texture(textureSampler0, coords))
+#define TEX2D(coords) GAMMA_IN(sampleTexture(coords))
 
 // Macro for weights computing.
 #define WEIGHT(w)                                                                                  \
@@ -103,6 +105,20 @@ uniform float OutputGamma;
 // 0x00000020 - Rounded corners
 // 0x00000040 - Rounded corners with no anti-aliasing
 // 0x00000080 - Convert pixel format
+// 0x00000100 - YUV planes
+
+vec4 sampleTexture(vec2 coords)
+{
+    if (0x0u == (shaderFlags & 0x100u))
+        return texture(textureSampler0, coords);
+
+    // Video frames with separate Y, U and V planes, converted using the BT.601 coefficients.
+    float y = 1.164 * (texture(textureSampler0, coords).r - 0.0625);
+    float u = texture(textureSampler1, coords).r - 0.5;
+    float v = texture(textureSampler2, coords).r - 0.5;
+    return vec4(clamp(vec3(y + 1.596 * v, y - 0.391 * u - 0.813 * v, y + 2.018 * u), 0.0, 1.0),
+                1.0);
+}
 
 void main()
 {